@@ -0,0 +1,71 @@
+// Copyright 2025
+// Micro-benchmarks for the biquad cascade at double and float precision
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+#include "bench_common.h"
+#include "biquad_cascade.h"
+
+namespace stinky_dsp {
+namespace {
+
+// RBJ peaking filter at 48 kHz
+BiquadCoefficients Bell(double frequency, double gain_db, double q) {
+  const double a = std::pow(10.0, gain_db / 40.0);
+  const double omega = 2.0 * std::numbers::pi * frequency / 48000.0;
+  const double alpha = std::sin(omega) / (2.0 * q);
+  const double a0 = 1.0 + alpha / a;
+
+  BiquadCoefficients c;
+  c.b0 = (1.0 + alpha * a) / a0;
+  c.b1 = -2.0 * std::cos(omega) / a0;
+  c.b2 = (1.0 - alpha * a) / a0;
+  c.a1 = c.b1;
+  c.a2 = (1.0 - alpha / a) / a0;
+  return c;
+}
+
+// Args: frames, number of enabled stages
+void CascadeSizes(benchmark::internal::Benchmark* bench) {
+  for (int frames : {64, 256}) {
+    for (int stages : {1, 2, 4}) {
+      bench->Args({frames, stages});
+    }
+  }
+}
+
+template <BiquadPrecision kPrecision>
+void BM_BiquadCascade(benchmark::State& state) {
+  const size_t frames = static_cast<size_t>(state.range(0));
+  const size_t stages = static_cast<size_t>(state.range(1));
+
+  BiquadCascade cascade;
+  for (size_t stage = 0; stage < stages; ++stage) {
+    cascade.SetStage(stage, Bell(500.0 * (stage + 1), 3.0, 1.0), kPrecision);
+    cascade.SetStageEnabled(stage, true);
+  }
+
+  std::vector<float> left(frames);
+  std::vector<float> right(frames);
+  for (size_t i = 0; i < frames; ++i) {
+    left[i] = 0.5f * std::sin(0.01f * static_cast<float>(i));
+    right[i] = 0.5f * std::sin(0.02f * static_cast<float>(i));
+  }
+
+  for (auto _ : state) {
+    cascade.Process(left.data(), right.data(), frames, 1.0f);
+    benchmark::ClobberMemory();
+  }
+  stinky_bench::SetSamplesProcessed(state, frames);
+}
+BENCHMARK_TEMPLATE(BM_BiquadCascade, BiquadPrecision::kDouble)
+    ->Apply(CascadeSizes);
+BENCHMARK_TEMPLATE(BM_BiquadCascade, BiquadPrecision::kFloat)
+    ->Apply(CascadeSizes);
+
+}  // namespace
+}  // namespace stinky_dsp
@@ -0,0 +1,50 @@
+// Copyright 2025
+// Shared helpers for the Stinky benchmarks
+
+#ifndef BENCH_COMMON_H_
+#define BENCH_COMMON_H_
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace stinky_bench {
+
+// Block sizes swept by the processor and kernel benchmarks
+inline constexpr int64_t kBlockSizes[] = {16, 64, 256, 1024, 4096};
+
+// Sample rates swept by the processor benchmarks
+inline constexpr int64_t kSampleRates[] = {44100, 48000, 96000, 192000};
+
+// Reports throughput as items_per_second and as an `ns_per_sample` counter,
+// the figure regression checks compare. Call after the timing loop.
+inline void SetSamplesProcessed(benchmark::State& state,
+                                size_t samples_per_iteration) {
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<int64_t>(samples_per_iteration));
+  // Inverted rate of samples * 1e-9 per iteration: seconds * 1e9 / samples
+  state.counters["ns_per_sample"] = benchmark::Counter(
+      static_cast<double>(samples_per_iteration) * 1e-9,
+      benchmark::Counter::kIsIterationInvariantRate |
+          benchmark::Counter::kInvert);
+}
+
+// Two-tone test signal at `amplitude`; the tones are chosen so a channel is
+// not periodic within a block
+inline std::vector<float> Signal(size_t count, float amplitude,
+                                 float phase_step = 0.01f) {
+  std::vector<float> signal(count);
+  for (size_t i = 0; i < count; ++i) {
+    const float t = static_cast<float>(i);
+    signal[i] = amplitude * (0.7f * std::sin(phase_step * t) +
+                             0.3f * std::sin(0.173f * phase_step * t * t));
+  }
+  return signal;
+}
+
+}  // namespace stinky_bench
+
+#endif  // BENCH_COMMON_H_
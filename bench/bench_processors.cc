@@ -0,0 +1,171 @@
+// Copyright 2025
+// Benchmarks for the plugin processors across block sizes, sample rates and
+// parameter states
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "bench_common.h"
+#include "compressor_processor.h"
+#include "delay_processor.h"
+#include "eq_processor.h"
+#include "limiter_processor.h"
+#include "simd_utils.h"
+
+namespace stinky_bench {
+namespace {
+
+// Stereo block processed out of place from a fixed input, as the plugins'
+// process() does, so every iteration sees the same signal and no copy is
+// timed
+class StereoBlock {
+ public:
+  StereoBlock(size_t frames, float amplitude)
+      : input_left_(Signal(frames, amplitude, 0.01f)),
+        input_right_(Signal(frames, amplitude, 0.013f)),
+        left_(frames),
+        right_(frames),
+        inputs_{input_left_.data(), input_right_.data()},
+        outputs_{left_.data(), right_.data()} {}
+
+  const float* const* Inputs() const { return inputs_; }
+  float* const* Outputs() const { return outputs_; }
+
+ private:
+  std::vector<float> input_left_;
+  std::vector<float> input_right_;
+  std::vector<float> left_;
+  std::vector<float> right_;
+  const float* inputs_[2];
+  float* outputs_[2];
+};
+
+// Selects the kernel set as clap_entry.init does in the plugins
+void InitializeKernels() { stinky_dsp::simd::Initialize(); }
+
+// Args: frames, sample rate, then one 0/1 column per parameter state
+void ProcessorSweep(benchmark::internal::Benchmark* bench,
+                    std::vector<const char*> state_names) {
+  const std::vector<int64_t> blocks(std::begin(kBlockSizes),
+                                    std::end(kBlockSizes));
+  const std::vector<int64_t> rates(std::begin(kSampleRates),
+                                   std::end(kSampleRates));
+  std::vector<std::vector<int64_t>> args = {blocks, rates};
+  std::vector<std::string> names = {"frames", "rate"};
+  for (const char* name : state_names) {
+    args.push_back({0, 1});
+    names.push_back(name);
+  }
+  bench->ArgsProduct(args)->ArgNames(names);
+}
+
+// Args: frames, sample rate, knee, auto_makeup
+void BM_Compressor(benchmark::State& state) {
+  InitializeKernels();
+  const size_t frames = static_cast<size_t>(state.range(0));
+
+  fast_compressor::CompressorParams params;
+  params.threshold_db = -18.0f;
+  params.ratio = 4.0f;
+  params.knee_db = state.range(2) != 0 ? 6.0f : 0.0f;
+  params.auto_makeup = state.range(3) != 0;
+
+  fast_compressor::CompressorProcessor compressor;
+  compressor.SetParams(params);
+  compressor.Initialize(static_cast<double>(state.range(1)));
+
+  StereoBlock block(frames, 0.5f);
+  for (auto _ : state) {
+    compressor.ProcessChannels(block.Inputs(), block.Outputs(), 2, frames);
+    benchmark::ClobberMemory();
+  }
+  SetSamplesProcessed(state, frames);
+}
+BENCHMARK(BM_Compressor)->Apply([](benchmark::internal::Benchmark* bench) {
+  ProcessorSweep(bench, {"knee", "auto_makeup"});
+});
+
+// Args: frames, sample rate, limiting (threshold below the signal peak),
+// true peak (4x oversampled detector)
+void BM_Limiter(benchmark::State& state) {
+  InitializeKernels();
+  const size_t frames = static_cast<size_t>(state.range(0));
+
+  // The signal peaks near -6 dBFS
+  fast_limiter::LimiterParams params;
+  params.threshold_db = state.range(2) != 0 ? -12.0f : -0.1f;
+  params.true_peak = state.range(3) != 0;
+
+  fast_limiter::LimiterProcessor limiter;
+  limiter.SetParams(params);
+  limiter.Initialize(static_cast<double>(state.range(1)));
+
+  StereoBlock block(frames, 0.5f);
+  for (auto _ : state) {
+    limiter.ProcessChannels(block.Inputs(), block.Outputs(), 2, frames);
+    benchmark::ClobberMemory();
+  }
+  SetSamplesProcessed(state, frames);
+}
+BENCHMARK(BM_Limiter)->Apply([](benchmark::internal::Benchmark* bench) {
+  ProcessorSweep(bench, {"limiting", "true_peak"});
+});
+
+// Args: frames, sample rate, bands (all four enabled, or none)
+void BM_Eq(benchmark::State& state) {
+  InitializeKernels();
+  const size_t frames = static_cast<size_t>(state.range(0));
+
+  // Default band layout with alternating boosts and cuts; band 1 (100 Hz)
+  // runs in double precision, the others in float
+  fast_eq::EqProcessor eq;
+  fast_eq::EqParams params = eq.GetParams();
+  for (size_t i = 0; i < params.bands.size(); ++i) {
+    params.bands[i].gain_db = i % 2 == 0 ? 4.0f : -4.0f;
+    params.bands[i].enabled = state.range(2) != 0;
+  }
+  eq.SetParams(params);
+  eq.Initialize(static_cast<double>(state.range(1)));
+
+  StereoBlock block(frames, 0.5f);
+  for (auto _ : state) {
+    eq.ProcessChannels(block.Inputs(), block.Outputs(), 2, frames);
+    benchmark::ClobberMemory();
+  }
+  SetSamplesProcessed(state, frames);
+}
+BENCHMARK(BM_Eq)->Apply([](benchmark::internal::Benchmark* bench) {
+  ProcessorSweep(bench, {"bands"});
+});
+
+// Args: frames, sample rate, dry (50% mix instead of wet only)
+void BM_Delay(benchmark::State& state) {
+  InitializeKernels();
+  const size_t frames = static_cast<size_t>(state.range(0));
+
+  stinky_delay::DelayParams params;
+  params.delay_time_ms = 250.0f;
+  params.mix = state.range(2) != 0 ? 0.5f : 1.0f;
+
+  stinky_delay::DelayProcessor delay;
+  delay.SetParams(params);
+  delay.Initialize(static_cast<double>(state.range(1)));
+
+  StereoBlock block(frames, 0.5f);
+  for (auto _ : state) {
+    delay.ProcessChannels(block.Inputs(), block.Outputs(), 2,
+                          static_cast<uint32_t>(frames));
+    benchmark::ClobberMemory();
+  }
+  SetSamplesProcessed(state, frames);
+}
+BENCHMARK(BM_Delay)->Apply([](benchmark::internal::Benchmark* bench) {
+  ProcessorSweep(bench, {"dry"});
+});
+
+}  // namespace
+}  // namespace stinky_bench
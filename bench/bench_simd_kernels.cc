@@ -0,0 +1,132 @@
+// Copyright 2025
+// Throughput of every simd:: kernel, per kernel set, across block sizes
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <vector>
+
+#include "bench_common.h"
+#include "simd_utils.h"
+
+namespace stinky_dsp {
+namespace simd {
+namespace {
+
+using stinky_bench::kBlockSizes;
+using stinky_bench::SetSamplesProcessed;
+using stinky_bench::Signal;
+
+void BlockSizes(benchmark::internal::Benchmark* bench) {
+  for (int64_t frames : kBlockSizes) {
+    bench->Arg(frames);
+  }
+  bench->ArgName("frames");
+}
+
+// Selects the kernel set for the benchmark, or skips it if unsupported
+bool UseIsa(benchmark::State& state, Isa isa) {
+  if (!SetIsa(isa)) {
+    state.SkipWithError("kernel set not supported on this CPU");
+    return false;
+  }
+  state.SetLabel(IsaName(isa));
+  return true;
+}
+
+// Operands shared by the kernels. Outputs go to `dest`, so the inputs keep
+// their values across iterations.
+struct KernelBuffers {
+  explicit KernelBuffers(size_t frames)
+      : a(Signal(frames, 0.5f, 0.01f)),
+        b(Signal(frames, 0.5f, 0.013f)),
+        db(Signal(frames, 30.0f, 0.01f)),
+        dest(frames) {
+    for (float& level : db) level -= 30.0f;  // -60..0 dB
+  }
+
+  std::vector<float> a;
+  std::vector<float> b;
+  std::vector<float> db;
+  std::vector<float> dest;
+};
+
+// The small multiplier keeps the accumulated dest bounded across iterations
+void RunMultiplyAdd(KernelBuffers& buffers, size_t frames) {
+  MultiplyAdd(buffers.dest.data(), buffers.b.data(), 1e-3f, frames);
+}
+void RunMultiply(KernelBuffers& buffers, size_t frames) {
+  Multiply(buffers.dest.data(), buffers.a.data(), 0.5f, frames);
+}
+void RunApplyGain(KernelBuffers& buffers, size_t frames) {
+  ApplyGain(buffers.dest.data(), 1.0f, frames);
+}
+void RunConvertToDb(KernelBuffers& buffers, size_t frames) {
+  ConvertToDb(buffers.dest.data(), buffers.a.data(), frames);
+}
+void RunLinearToDb(KernelBuffers& buffers, size_t frames) {
+  LinearToDb(buffers.dest.data(), buffers.a.data(), frames);
+}
+void RunDbToLinear(KernelBuffers& buffers, size_t frames) {
+  DbToLinear(buffers.dest.data(), buffers.db.data(), frames);
+}
+void RunMax(KernelBuffers& buffers, size_t frames) {
+  Max(buffers.dest.data(), buffers.a.data(), buffers.b.data(), frames);
+}
+void RunMin(KernelBuffers& buffers, size_t frames) {
+  Min(buffers.dest.data(), buffers.a.data(), buffers.b.data(), frames);
+}
+void RunMaxAbs(KernelBuffers& buffers, size_t frames) {
+  MaxAbs(buffers.dest.data(), buffers.a.data(), buffers.b.data(), frames);
+}
+void RunPeakAbs(KernelBuffers& buffers, size_t frames) {
+  benchmark::DoNotOptimize(PeakAbs(buffers.a.data(), frames));
+}
+void RunHardKneeGainCurve(KernelBuffers& buffers, size_t frames) {
+  ComputeGainReductionDb(buffers.dest.data(), buffers.db.data(), -20.0f,
+                         -0.75f, 0.0f, frames);
+}
+void RunSoftKneeGainCurve(KernelBuffers& buffers, size_t frames) {
+  ComputeGainReductionDb(buffers.dest.data(), buffers.db.data(), -20.0f,
+                         -0.75f, 6.0f, frames);
+}
+
+template <Isa kIsa, void (*kKernel)(KernelBuffers&, size_t)>
+void BM_Kernel(benchmark::State& state) {
+  if (!UseIsa(state, kIsa)) return;
+  const size_t frames = static_cast<size_t>(state.range(0));
+  KernelBuffers buffers(frames);
+  buffers.dest = buffers.a;
+
+  for (auto _ : state) {
+    kKernel(buffers, frames);
+    benchmark::ClobberMemory();
+  }
+  SetSamplesProcessed(state, frames);
+}
+
+// Registers `kernel` once per kernel set
+#define KERNEL_BENCHMARK(kernel)                                          \
+  BENCHMARK_TEMPLATE(BM_Kernel, Isa::kScalar, kernel)->Apply(BlockSizes); \
+  BENCHMARK_TEMPLATE(BM_Kernel, Isa::kSse2, kernel)->Apply(BlockSizes);   \
+  BENCHMARK_TEMPLATE(BM_Kernel, Isa::kAvx2, kernel)->Apply(BlockSizes);   \
+  BENCHMARK_TEMPLATE(BM_Kernel, Isa::kAvx512, kernel)->Apply(BlockSizes)
+
+KERNEL_BENCHMARK(RunMultiplyAdd);
+KERNEL_BENCHMARK(RunMultiply);
+KERNEL_BENCHMARK(RunApplyGain);
+KERNEL_BENCHMARK(RunConvertToDb);
+KERNEL_BENCHMARK(RunLinearToDb);
+KERNEL_BENCHMARK(RunDbToLinear);
+KERNEL_BENCHMARK(RunMax);
+KERNEL_BENCHMARK(RunMin);
+KERNEL_BENCHMARK(RunMaxAbs);
+KERNEL_BENCHMARK(RunPeakAbs);
+KERNEL_BENCHMARK(RunHardKneeGainCurve);
+KERNEL_BENCHMARK(RunSoftKneeGainCurve);
+
+#undef KERNEL_BENCHMARK
+
+}  // namespace
+}  // namespace simd
+}  // namespace stinky_dsp
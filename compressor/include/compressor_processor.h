@@ -7,6 +7,9 @@
 #include <cstddef>
 #include <cstdint>
 
+#include "channels.h"
+#include "smoother.h"
+
 namespace fast_compressor {
 
 // Compressor parameters
@@ -26,10 +29,10 @@ class CompressorProcessor {
   CompressorProcessor();
   ~CompressorProcessor() = default;
 
-  // Initialize with sample rate
+  // [main thread] Initialize with sample rate
   void Initialize(double sample_rate);
 
-  // Set compressor parameters
+  // [audio thread] Set compressor parameters
   void SetParams(const CompressorParams& params);
   
   // Get current parameters
@@ -38,21 +41,67 @@ class CompressorProcessor {
   // Process audio buffer (stereo separate channels)
   void ProcessStereo(float* left, float* right, size_t num_frames);
 
+  // Process from input to output buffers of float or double samples. The
+  // output may be the input buffer itself. The detector runs in float; the
+  // gain is applied at the samples' own precision.
+  template <typename T>
+  void ProcessStereo(const T* in_left, const T* in_right, T* out_left,
+                     T* out_right, size_t num_frames);
+
   // Process audio buffer (stereo separate channels) with sidechain input
   // If sidechain pointers are null, uses main input for detection
   void ProcessStereoWithSidechain(float* left, float* right, 
                                   const float* sc_left, const float* sc_right,
                                   size_t num_frames);
 
+  // Sidechain variant of the input-to-output ProcessStereo
+  template <typename T>
+  void ProcessStereoWithSidechain(const T* in_left, const T* in_right,
+                                  T* out_left, T* out_right,
+                                  const T* sc_left, const T* sc_right,
+                                  size_t num_frames);
+
+  // Process `num_channels` (1 to stinky_dsp::kMaxChannels) channels from
+  // input to output buffers. One detector, linked across the sidechain
+  // channels (or the inputs if `sidechain` is null), sets the gain of every
+  // channel. ProcessStereo with the same buffer on both sides is mono.
+  template <typename T>
+  void ProcessChannels(const T* const* inputs, T* const* outputs,
+                       uint32_t num_channels, size_t num_frames,
+                       const T* const* sidechain = nullptr,
+                       uint32_t sidechain_channels = 0);
+
   // Get current gain reduction in dB
   float GetGainReduction() const { return gain_reduction_db_; }
 
-  // Reset internal state
+  // Frames after the input goes silent until the gain has recovered (one
+  // release time)
+  uint32_t GetTailFrames() const;
+
+  // True while a parameter change is still ramping in
+  bool IsRamping() const {
+    return threshold_db_.IsSmoothing() || slope_.IsSmoothing() ||
+           knee_db_.IsSmoothing() || makeup_gain_.IsSmoothing();
+  }
+
+  // [audio thread] Reset internal state
   void Reset();
 
+  // Detector stages run over chunks of at most this many frames
+  static constexpr size_t kMaxBlockSize = 256;
+
+  // While threshold, ratio or knee ramp, chunks shrink to this size
+  static constexpr size_t kRampBlockSize = 32;
+
  private:
-  // Calculate gain reduction for a given input level
-  float CalculateGainReduction(float input_level_db) const;
+  // Process one chunk of at most kMaxBlockSize frames. Peak detection, dB
+  // conversion, the gain curve and makeup run as whole-chunk SIMD passes;
+  // only the envelope and auto makeup recursions are evaluated per sample.
+  template <typename T, bool kAutoMakeup>
+  void ProcessBlock(const T* const* inputs, T* const* outputs,
+                    uint32_t num_channels, const T* const* sidechain,
+                    uint32_t sidechain_channels, size_t num_frames,
+                    float threshold_db, float slope, float knee_db);
 
   // Apply envelope follower
   float ApplyEnvelope(float target_gain, float current_gain);
@@ -63,10 +112,23 @@ class CompressorProcessor {
   float gain_reduction_db_;
   float attack_coeff_;
   float release_coeff_;
+
+  // Gain curve parameters ramp at block rate, makeup gain per sample
+  stinky_dsp::Smoother threshold_db_;
+  stinky_dsp::Smoother slope_;  // 1/ratio - 1
+  stinky_dsp::Smoother knee_db_;
+  stinky_dsp::Smoother makeup_gain_;  // Linear
   
   // Auto makeup gain state
   float c_dev_;  // Average deviation of gain reduction
   float alpha_avg_;  // Averaging filter coefficient (2 second time constant)
+
+  // Per-chunk detector scratch (level in dB, target gain, then the gain
+  // applied to every channel)
+  alignas(32) float detector_[kMaxBlockSize];
+
+  // Per-chunk makeup gain scratch (auto makeup in dB, then linear)
+  alignas(32) float makeup_[kMaxBlockSize];
 };
 
 }  // namespace fast_compressor
@@ -7,6 +7,11 @@
 #include <cmath>
 #include <cstdio>
 #include <cstring>
+#include <type_traits>
+
+#include "process_block.h"
+#include "process_stats_extension.h"
+#include "simd_utils.h"
 
 namespace fast_compressor {
 
@@ -27,6 +32,19 @@ constexpr const char* kFeatures[] = {
     nullptr
 };
 
+// Every port takes 64-bit buffers; PREFER_64BIT_AUDIO builds also ask for them
+constexpr uint32_t kSampleSizeFlags =
+#ifdef STINKY_PREFER_64BIT_AUDIO
+    CLAP_AUDIO_PORT_SUPPORTS_64BITS | CLAP_AUDIO_PORT_PREFERS_64BITS;
+#else
+    CLAP_AUDIO_PORT_SUPPORTS_64BITS;
+#endif
+
+// Main input and output are processed at one sample size
+constexpr uint32_t kMainPortFlags = CLAP_AUDIO_PORT_IS_MAIN |
+                                    CLAP_AUDIO_PORT_REQUIRES_COMMON_SAMPLE_SIZE |
+                                    kSampleSizeFlags;
+
 // Convert normalized [0,1] to actual values
 inline double NormalizedToThreshold(double norm) {
   return kThresholdMin + norm * (kThresholdMax - kThresholdMin);
@@ -208,12 +226,57 @@ static const clap_plugin_audio_ports_t kAudioPortsExtension = {
     ClapAudioPortsGet,
 };
 
+// Audio ports config extension callbacks
+uint32_t ClapAudioPortsConfigCount(const clap_plugin_t* plugin) {
+  auto* comp = static_cast<CompressorClap*>(plugin->plugin_data);
+  return comp->AudioPortsConfigCount();
+}
+
+bool ClapAudioPortsConfigGet(const clap_plugin_t* plugin, uint32_t index,
+                             clap_audio_ports_config_t* config) {
+  auto* comp = static_cast<CompressorClap*>(plugin->plugin_data);
+  return comp->AudioPortsConfigGet(index, config);
+}
+
+bool ClapAudioPortsConfigSelect(const clap_plugin_t* plugin,
+                                clap_id config_id) {
+  auto* comp = static_cast<CompressorClap*>(plugin->plugin_data);
+  return comp->AudioPortsConfigSelect(config_id);
+}
+
+static const clap_plugin_audio_ports_config_t kAudioPortsConfigExtension = {
+    ClapAudioPortsConfigCount,
+    ClapAudioPortsConfigGet,
+    ClapAudioPortsConfigSelect,
+};
+
+// Tail extension callbacks
+uint32_t ClapTailGet(const clap_plugin_t* plugin) {
+  auto* comp = static_cast<CompressorClap*>(plugin->plugin_data);
+  return comp->TailGet();
+}
+
+static const clap_plugin_tail_t kTailExtension = {
+    ClapTailGet,
+};
+
+// The buffer's channels at sample size T, null if it carries the other one
+template <typename T>
+T* const* SampleData(const clap_audio_buffer_t& buffer) {
+  if constexpr (std::is_same_v<T, double>) {
+    return buffer.data64;
+  } else {
+    return buffer.data32;
+  }
+}
+
 }  // namespace
 
 CompressorClap::CompressorClap(const clap_host_t* host)
     : host_(host),
       sample_rate_(44100.0),
-      is_processing_(false) {
+      is_processing_(false),
+      channel_layout_(stinky_dsp::kStereoLayout) {
   plugin_.desc = nullptr;  // Set by factory
   plugin_.plugin_data = this;
   plugin_.init = ClapInit;
@@ -245,8 +308,15 @@ bool CompressorClap::Init() noexcept {
 bool CompressorClap::Activate(double sample_rate, uint32_t /*min_frames*/,
                                uint32_t /*max_frames*/) noexcept {
   sample_rate_ = sample_rate;
+  // Sync stored parameter values first, so Initialize starts from them
+  // without a smoothing ramp
+  UpdateProcessorParams();
   processor_.Initialize(sample_rate);
-  UpdateProcessorParams();  // Sync stored parameter values with processor
+  silence_.SetTail(processor_.GetTailFrames());
+  silence_.Reset();
+  constant_.Reset();
+  process_stats_.SetSampleRate(sample_rate);
+  process_stats_.Reset();
   return true;
 }
 
@@ -265,77 +335,104 @@ void CompressorClap::StopProcessing() noexcept {
 
 void CompressorClap::Reset() noexcept {
   processor_.Reset();
+  silence_.Reset();
+  constant_.Reset();
+}
+
+template <typename T>
+clap_process_status CompressorClap::ProcessAudio(const clap_process_t* process,
+                                                 const T* const* inputs,
+                                                 T* const* outputs) noexcept {
+  // Check for sidechain input (second input port). One at the other sample
+  // size is ignored, and the main input drives the detector.
+  T* const* sidechain = nullptr;
+  uint32_t sc_channels = 0;
+  if (process->audio_inputs_count >= 2) {
+    sidechain = SampleData<T>(process->audio_inputs[1]);
+    sc_channels = std::min(process->audio_inputs[1].channel_count,
+                           stinky_dsp::kMaxChannels);
+  }
+  if (sc_channels == 0) {
+    sidechain = nullptr;
+  }
+
+  // The sidechain drives the detector, so a sounding one keeps the plugin
+  // awake, and a moving one rules out a steady state
+  stinky_dsp::BlockOptions options;
+  options.layout_channels =
+      stinky_dsp::kChannelLayouts[channel_layout_].channel_count;
+  options.other_inputs_silent =
+      !sidechain || stinky_dsp::SilenceDetector::IsSilent(
+                        sidechain, sc_channels, process->frames_count);
+  options.may_settle = !processor_.IsRamping() && !sidechain;
+  return stinky_dsp::ProcessBlock(
+      process, inputs, outputs, options, silence_, constant_,
+      [this](const clap_event_header_t* header) {
+        return ApplyEvent(header);
+      },
+      [this] { UpdateProcessorParams(); },
+      [&](const T* const* in, T* const* out, uint32_t num_channels,
+          uint32_t frame, uint32_t frames) {
+        if (sidechain) {
+          // Use sidechain for detection
+          processor_.ProcessChannels<T>(
+              in, out, num_channels, frames,
+              stinky_dsp::ChannelOffsets<const T>(sidechain, sc_channels,
+                                                  frame),
+              sc_channels);
+        } else {
+          // Use main input for detection
+          processor_.ProcessChannels<T>(in, out, num_channels, frames);
+        }
+      });
 }
 
 clap_process_status CompressorClap::Process(
     const clap_process_t* process) noexcept {
-  // Process parameter changes
-  if (process->in_events) {
-    ProcessParameterChanges(process->in_events);
-  }
-
+  stinky_dsp::ProcessStats::Scope stats_scope(process_stats_,
+                                              process->frames_count);
   const uint32_t frame_count = process->frames_count;
   const uint32_t input_count = process->audio_inputs_count;
   const uint32_t output_count = process->audio_outputs_count;
 
   if (input_count == 0 || output_count == 0 || frame_count == 0) {
+    if (process->in_events) {
+      ProcessParameterChanges(process->in_events);
+    }
     return CLAP_PROCESS_SLEEP;
   }
 
-  // Get input/output channels (handle both mono and stereo)
-  const uint32_t in_channels = process->audio_inputs[0].channel_count;
-  const uint32_t out_channels = process->audio_outputs[0].channel_count;
-  
-  float* in_left = process->audio_inputs[0].data32[0];
-  float* in_right = (in_channels > 1) ? process->audio_inputs[0].data32[1] : nullptr;
-  float* out_left = process->audio_outputs[0].data32[0];
-  float* out_right = (out_channels > 1) ? process->audio_outputs[0].data32[1] : nullptr;
-
-  // Check for sidechain input (second input port)
-  const float* sc_left = nullptr;
-  const float* sc_right = nullptr;
-  if (input_count >= 2) {
-    const uint32_t sc_channels = process->audio_inputs[1].channel_count;
-    sc_left = process->audio_inputs[1].data32[0];
-    sc_right = (sc_channels > 1) ? process->audio_inputs[1].data32[1] : sc_left;
+  // The ports take either sample size; the host picks one per block
+  const clap_audio_buffer_t& input = process->audio_inputs[0];
+  const clap_audio_buffer_t& output = process->audio_outputs[0];
+  if (input.data32 && output.data32) {
+    return ProcessAudio(process, input.data32, output.data32);
   }
-
-  // Copy input to output
-  std::memcpy(out_left, in_left, frame_count * sizeof(float));
-  if (in_right && out_right) {
-    std::memcpy(out_right, in_right, frame_count * sizeof(float));
+  if (input.data64 && output.data64) {
+    return ProcessAudio(process, input.data64, output.data64);
   }
-
-  // Process compression
-  if (out_right) {
-    if (sc_left) {
-      // Use sidechain for detection
-      processor_.ProcessStereoWithSidechain(out_left, out_right, sc_left, sc_right, frame_count);
-    } else {
-      // Use main input for detection
-      processor_.ProcessStereo(out_left, out_right, frame_count);
-    }
-  } else {
-    if (sc_left) {
-      processor_.ProcessStereoWithSidechain(out_left, out_left, sc_left, sc_right, frame_count);
-    } else {
-      processor_.ProcessStereo(out_left, out_left, frame_count);
-    }
-  }
-
-  return CLAP_PROCESS_CONTINUE;
+  return CLAP_PROCESS_ERROR;
 }
 
 const void* CompressorClap::GetExtension(const char* id) noexcept {
   if (std::strcmp(id, CLAP_EXT_AUDIO_PORTS) == 0) {
     return &kAudioPortsExtension;
   }
+  if (std::strcmp(id, CLAP_EXT_AUDIO_PORTS_CONFIG) == 0) {
+    return &kAudioPortsConfigExtension;
+  }
   if (std::strcmp(id, CLAP_EXT_PARAMS) == 0) {
     return &kParamsExtension;
   }
   if (std::strcmp(id, CLAP_EXT_STATE) == 0) {
     return &kStateExtension;
   }
+  if (std::strcmp(id, CLAP_EXT_TAIL) == 0) {
+    return &kTailExtension;
+  }
+  if (std::strcmp(id, STINKY_EXT_PROCESS_STATS) == 0) {
+    return stinky_dsp::ProcessStatsExtension<CompressorClap>();
+  }
   return nullptr;
 }
 
@@ -532,19 +629,21 @@ void CompressorClap::ProcessParameterChanges(
   const uint32_t event_count = events->size(events);
 
   for (uint32_t i = 0; i < event_count; ++i) {
-    const clap_event_header_t* header = events->get(events, i);
-
-    if (header->space_id != CLAP_CORE_EVENT_SPACE_ID) continue;
-
-    if (header->type == CLAP_EVENT_PARAM_VALUE) {
-      auto* param_event = reinterpret_cast<const clap_event_param_value_t*>(header);
-      SetParamValue(param_event->param_id, param_event->value);
-    }
+    ApplyEvent(events->get(events, i));
   }
 
   UpdateProcessorParams();
 }
 
+bool CompressorClap::ApplyEvent(const clap_event_header_t* header) noexcept {
+  if (header->space_id != CLAP_CORE_EVENT_SPACE_ID) return false;
+  if (header->type != CLAP_EVENT_PARAM_VALUE) return false;
+
+  auto* param_event = reinterpret_cast<const clap_event_param_value_t*>(header);
+  SetParamValue(param_event->param_id, param_event->value);
+  return true;
+}
+
 void CompressorClap::UpdateProcessorParams() noexcept {
   CompressorParams params;
   params.threshold_db = static_cast<float>(NormalizedToThreshold(param_values_[kParamIdThreshold].load()));
@@ -556,6 +655,7 @@ void CompressorClap::UpdateProcessorParams() noexcept {
   params.auto_makeup = param_values_[kParamIdAutoMakeup].load() > 0.5;
   
   processor_.SetParams(params);
+  silence_.SetTail(processor_.GetTailFrames());
 }
 
 void CompressorClap::SetParamValue(clap_id param_id, double value) noexcept {
@@ -576,29 +676,49 @@ bool CompressorClap::AudioPortsGet(uint32_t index, bool is_input,
     info->id = index;
     if (index == 0) {
       std::snprintf(info->name, sizeof(info->name), "Audio Input");
-      info->flags = CLAP_AUDIO_PORT_IS_MAIN;
+      info->flags = kMainPortFlags;
       info->in_place_pair = 0;
+      info->channel_count =
+          stinky_dsp::kChannelLayouts[channel_layout_].channel_count;
+      info->port_type = stinky_dsp::kChannelLayouts[channel_layout_].port_type;
     } else {
       std::snprintf(info->name, sizeof(info->name), "Sidechain Input");
-      info->flags = 0;  // Not main, not required
+      info->flags = kSampleSizeFlags;  // Not main, not required
       info->in_place_pair = CLAP_INVALID_ID;
+      info->channel_count = 2;
+      info->port_type = CLAP_PORT_STEREO;
     }
-    info->channel_count = 2;
-    info->port_type = CLAP_PORT_STEREO;
   } else {
     if (index > 0) return false;
     
     info->id = 0;
     std::snprintf(info->name, sizeof(info->name), "Audio Output");
-    info->channel_count = 2;
-    info->flags = CLAP_AUDIO_PORT_IS_MAIN;
-    info->port_type = CLAP_PORT_STEREO;
+    info->channel_count =
+        stinky_dsp::kChannelLayouts[channel_layout_].channel_count;
+    info->flags = kMainPortFlags;
+    info->port_type = stinky_dsp::kChannelLayouts[channel_layout_].port_type;
     info->in_place_pair = 0;
   }
 
   return true;
 }
 
+uint32_t CompressorClap::AudioPortsConfigCount() const noexcept {
+  return stinky_dsp::kChannelLayoutCount;
+}
+
+bool CompressorClap::AudioPortsConfigGet(
+    uint32_t index, clap_audio_ports_config_t* config) const noexcept {
+  return stinky_dsp::GetChannelLayoutConfig(index, AudioPortsCount(true),
+                                            config);
+}
+
+bool CompressorClap::AudioPortsConfigSelect(clap_id config_id) noexcept {
+  if (config_id >= stinky_dsp::kChannelLayoutCount) return false;
+  channel_layout_ = config_id;
+  return true;
+}
+
 }  // namespace fast_compressor
 
 // CLAP plugin factory
@@ -657,7 +777,10 @@ static const void* ClapGetFactory(const char* factory_id) {
 
 CLAP_EXPORT const clap_plugin_entry_t clap_entry = {
     CLAP_VERSION,
-    [](const char* /*plugin_path*/) { return true; },
+    [](const char* /*plugin_path*/) {
+      stinky_dsp::simd::Initialize();
+      return true;
+    },
     []() {},
     ClapGetFactory,
 };
@@ -6,19 +6,16 @@
 #include <algorithm>
 #include <cmath>
 
+#include "simd_utils.h"
+
 namespace fast_compressor {
 
+namespace simd = stinky_dsp::simd;
+
 namespace {
 
-constexpr float kEpsilon = 1e-8f;
-
-inline float DbToLinear(float db) {
-  return std::pow(10.0f, db / 20.0f);
-}
-
-inline float LinearToDb(float linear) {
-  return 20.0f * ::log10f(std::max(linear, kEpsilon));
-}
+// Parameter ramp length; long enough to remove zipper noise on sweeps
+constexpr double kSmoothingMs = 20.0;
 
 }  // namespace
 
@@ -38,8 +35,20 @@ void CompressorProcessor::Initialize(double sample_rate) {
   // Calculate averaging filter coefficient for 2 second time constant
   alpha_avg_ = std::exp(-1.0f / (static_cast<float>(sample_rate) * 2.0f));
   
-  // Recalculate coefficients
+  // Recalculate coefficients, then start from the targets without a ramp
+  threshold_db_.Configure(stinky_dsp::SmoothingType::kOnePole, sample_rate,
+                          kSmoothingMs);
+  slope_.Configure(stinky_dsp::SmoothingType::kOnePole, sample_rate,
+                   kSmoothingMs);
+  knee_db_.Configure(stinky_dsp::SmoothingType::kOnePole, sample_rate,
+                     kSmoothingMs);
+  makeup_gain_.Configure(stinky_dsp::SmoothingType::kLinear, sample_rate,
+                         kSmoothingMs);
   SetParams(params_);
+  threshold_db_.Reset(threshold_db_.Target());
+  slope_.Reset(slope_.Target());
+  knee_db_.Reset(knee_db_.Target());
+  makeup_gain_.Reset(makeup_gain_.Target());
 }
 
 void CompressorProcessor::SetParams(const CompressorParams& params) {
@@ -50,6 +59,11 @@ void CompressorProcessor::SetParams(const CompressorParams& params) {
                                      static_cast<float>(sample_rate_)));
   release_coeff_ = std::exp(-1.0f / (params_.release_ms * 0.001f * 
                                       static_cast<float>(sample_rate_)));
+
+  threshold_db_.SetTarget(params_.threshold_db);
+  slope_.SetTarget(1.0f / params_.ratio - 1.0f);
+  knee_db_.SetTarget(params_.knee_db);
+  makeup_gain_.SetTarget(simd::DbToLinear(params_.makeup_gain_db));
 }
 
 void CompressorProcessor::Reset() {
@@ -58,24 +72,9 @@ void CompressorProcessor::Reset() {
   c_dev_ = 0.0f;
 }
 
-float CompressorProcessor::CalculateGainReduction(float input_level_db) const {
-  const float threshold = params_.threshold_db;
-  const float ratio = params_.ratio;
-  const float knee = params_.knee_db;
-  
-  if (knee > 0.0f && input_level_db > (threshold - knee / 2.0f) &&
-      input_level_db < (threshold + knee / 2.0f)) {
-    // Soft knee
-    const float knee_factor = (input_level_db - threshold + knee / 2.0f) / knee;
-    const float overshoot = input_level_db - threshold;
-    return overshoot * (1.0f / ratio - 1.0f) * knee_factor;
-  } else if (input_level_db > threshold) {
-    // Above threshold
-    const float overshoot = input_level_db - threshold;
-    return overshoot * (1.0f / ratio - 1.0f);
-  }
-  
-  return 0.0f;  // Below threshold
+uint32_t CompressorProcessor::GetTailFrames() const {
+  return static_cast<uint32_t>(
+      std::ceil(params_.release_ms * 0.001 * sample_rate_));
 }
 
 float CompressorProcessor::ApplyEnvelope(float target_gain, 
@@ -88,57 +87,165 @@ float CompressorProcessor::ApplyEnvelope(float target_gain,
 void CompressorProcessor::ProcessStereo(float* left, float* right, 
                                         size_t num_frames) {
   // Use main input for sidechain detection
-  ProcessStereoWithSidechain(left, right, left, right, num_frames);
+  ProcessStereoWithSidechain(left, right, left, right, left, right,
+                             num_frames);
+}
+
+template <typename T>
+void CompressorProcessor::ProcessStereo(const T* in_left, const T* in_right,
+                                        T* out_left, T* out_right,
+                                        size_t num_frames) {
+  const T* inputs[] = {in_left, in_right};
+  T* outputs[] = {out_left, out_right};
+  ProcessChannels(inputs, outputs, out_left == out_right ? 1 : 2,
+                  num_frames);
 }
 
 void CompressorProcessor::ProcessStereoWithSidechain(float* left, float* right,
                                                      const float* sc_left, 
                                                      const float* sc_right,
                                                      size_t num_frames) {
-  // Calculate c_est (estimated average gain reduction in dB)
-  // This is half the maximum gain reduction at threshold
-  const float c_est = params_.threshold_db * (1.0f - 1.0f / params_.ratio) / 2.0f;
+  ProcessStereoWithSidechain(left, right, left, right, sc_left, sc_right,
+                             num_frames);
+}
+
+template <typename T>
+void CompressorProcessor::ProcessStereoWithSidechain(
+    const T* in_left, const T* in_right, T* out_left, T* out_right,
+    const T* sc_left, const T* sc_right, size_t num_frames) {
+  const T* inputs[] = {in_left, in_right};
+  T* outputs[] = {out_left, out_right};
+  const T* sidechain[] = {sc_left, sc_right};
+  ProcessChannels(inputs, outputs, out_left == out_right ? 1 : 2, num_frames,
+                  sidechain, sc_left == sc_right ? 1 : 2);
+}
+
+template <typename T>
+void CompressorProcessor::ProcessChannels(const T* const* inputs,
+                                          T* const* outputs,
+                                          uint32_t num_channels,
+                                          size_t num_frames,
+                                          const T* const* sidechain,
+                                          uint32_t sidechain_channels) {
+  if (!sidechain) {
+    sidechain = inputs;
+    sidechain_channels = num_channels;
+  }
+
+  // The makeup mode is fixed for the call, so each mode gets its own loops
+  const auto process_block = params_.auto_makeup
+                                 ? &CompressorProcessor::ProcessBlock<T, true>
+                                 : &CompressorProcessor::ProcessBlock<T, false>;
+
+  size_t offset = 0;
+  while (offset < num_frames) {
+    // Re-evaluate the gain curve every kRampBlockSize frames while it ramps
+    const bool ramping = threshold_db_.IsSmoothing() ||
+                         slope_.IsSmoothing() || knee_db_.IsSmoothing();
+    const size_t block_frames = std::min(
+        ramping ? kRampBlockSize : kMaxBlockSize, num_frames - offset);
+
+    (this->*process_block)(
+        stinky_dsp::ChannelOffsets(inputs, num_channels, offset),
+        stinky_dsp::ChannelOffsets(outputs, num_channels, offset),
+        num_channels,
+        stinky_dsp::ChannelOffsets(sidechain, sidechain_channels, offset),
+        sidechain_channels, block_frames, threshold_db_.Current(),
+        slope_.Current(), knee_db_.Current());
+
+    if (ramping) {
+      threshold_db_.Advance(block_frames);
+      slope_.Advance(block_frames);
+      knee_db_.Advance(block_frames);
+    }
+    offset += block_frames;
+  }
+}
+
+template <typename T, bool kAutoMakeup>
+void CompressorProcessor::ProcessBlock(const T* const* inputs,
+                                       T* const* outputs,
+                                       uint32_t num_channels,
+                                       const T* const* sidechain,
+                                       uint32_t sidechain_channels,
+                                       size_t num_frames, float threshold_db,
+                                       float slope, float knee_db) {
+  // Stage 1: peak linked across the sidechain (or main input) channels
+  simd::MaxAbs(detector_, sidechain, sidechain_channels, num_frames);
+  
+  // Stage 2: peak level in dB
+  simd::ConvertToDb(detector_, detector_, num_frames);
+  
+  // Stage 3: target gain reduction in dB (this is negative or zero)
+  simd::ComputeGainReductionDb(detector_, detector_, threshold_db, slope,
+                               knee_db, num_frames);
+  simd::DbToLinear(detector_, detector_, num_frames);
   
+  // Stage 4: envelope recursion, the only per-sample dependency
   for (size_t i = 0; i < num_frames; ++i) {
-    // Get peak level from sidechain (or main input if no sidechain)
-    const float sc_left_abs = std::abs(sc_left[i]);
-    const float sc_right_abs = std::abs(sc_right[i]);
-    const float peak = std::max(sc_left_abs, sc_right_abs);
-    
-    // Convert to dB
-    const float peak_db = LinearToDb(peak);
-    
-    // Calculate target gain reduction in dB (this is negative or zero)
-    const float gain_reduction_db = CalculateGainReduction(peak_db);
-    const float target_gain = DbToLinear(gain_reduction_db);
-    
-    // Apply envelope
-    envelope_gain_ = ApplyEnvelope(target_gain, envelope_gain_);
-    
-    // Store gain reduction for metering (convert back to dB, will be negative)
-    gain_reduction_db_ = LinearToDb(envelope_gain_);
-    
-    // Calculate makeup gain
-    float makeup_gain_db;
-    if (params_.auto_makeup) {
-      // Update averaging filter for auto makeup
-      // Note: gain_reduction_db_ is negative, so we use it directly
-      c_dev_ = alpha_avg_ * c_dev_ + (1.0f - alpha_avg_) * (gain_reduction_db_ - c_est);
-      
-      // Auto makeup gain compensates for both the estimate and actual deviation
-      // Since c_est and c_dev are negative, negating them gives positive makeup gain
-      makeup_gain_db = -(c_dev_ + c_est);
+    envelope_gain_ = ApplyEnvelope(detector_[i], envelope_gain_);
+    detector_[i] = envelope_gain_;
+  }
+
+  // Stage 5: makeup gain, leaving the final gain per frame
+  if constexpr (kAutoMakeup) {
+    // c_est: estimated average gain reduction in dB, half the maximum gain
+    // reduction at threshold
+    const float c_est = -threshold_db * slope / 2.0f;
+
+    // The deviation average follows the gain reduction in dB. Since c_est
+    // and c_dev are negative, negating them gives positive makeup gain.
+    simd::LinearToDb(makeup_, detector_, num_frames);
+    gain_reduction_db_ = makeup_[num_frames - 1];
+    for (size_t i = 0; i < num_frames; ++i) {
+      c_dev_ = alpha_avg_ * c_dev_ +
+               (1.0f - alpha_avg_) * (makeup_[i] - c_est);
+      makeup_[i] = -(c_dev_ + c_est);
+    }
+    simd::DbToLinear(makeup_, makeup_, num_frames);
+    for (size_t i = 0; i < num_frames; ++i) {
+      detector_[i] *= makeup_[i];
+    }
+  } else {
+    gain_reduction_db_ = simd::LinearToDb(envelope_gain_);
+    if (makeup_gain_.IsSmoothing()) {
+      makeup_gain_.Process(makeup_, num_frames);
+      for (size_t i = 0; i < num_frames; ++i) {
+        detector_[i] *= makeup_[i];
+      }
     } else {
-      makeup_gain_db = params_.makeup_gain_db;
+      simd::ApplyGain(detector_, makeup_gain_.Current(), num_frames);
+    }
+  }
+
+  // Stage 6: compression gain and makeup on every channel
+  for (uint32_t channel = 0; channel < num_channels; ++channel) {
+    const T* in = inputs[channel];
+    T* out = outputs[channel];
+    for (size_t i = 0; i < num_frames; ++i) {
+      out[i] = in[i] * detector_[i];
     }
-    
-    const float makeup_gain = DbToLinear(makeup_gain_db);
-    
-    // Apply compression gain and makeup to main signal
-    const float final_gain = envelope_gain_ * makeup_gain;
-    left[i] *= final_gain;
-    right[i] *= final_gain;
   }
 }
 
+template void CompressorProcessor::ProcessStereo(const float*, const float*,
+                                                 float*, float*, size_t);
+template void CompressorProcessor::ProcessStereo(const double*, const double*,
+                                                 double*, double*, size_t);
+template void CompressorProcessor::ProcessStereoWithSidechain(
+    const float*, const float*, float*, float*, const float*, const float*,
+    size_t);
+template void CompressorProcessor::ProcessStereoWithSidechain(
+    const double*, const double*, double*, double*, const double*,
+    const double*, size_t);
+template void CompressorProcessor::ProcessChannels(const float* const*,
+                                                   float* const*, uint32_t,
+                                                   size_t, const float* const*,
+                                                   uint32_t);
+template void CompressorProcessor::ProcessChannels(const double* const*,
+                                                   double* const*, uint32_t,
+                                                   size_t,
+                                                   const double* const*,
+                                                   uint32_t);
+
 }  // namespace fast_compressor
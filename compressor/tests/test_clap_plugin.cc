@@ -2,10 +2,15 @@
 // End-to-end tests for CLAP plugin
 
 #include "compressor_clap.h"
+#include "allocation_guard.h"
+#include "param_event_list.h"
+#include "process_stats_extension.h"
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <memory>
 #include <vector>
@@ -14,6 +19,7 @@ namespace fast_compressor {
 namespace {
 
 using ::testing::NotNull;
+using stinky_dsp::ParamEventList;
 
 // Mock CLAP host
 class MockClapHost {
@@ -182,6 +188,14 @@ TEST_F(ClapPluginTest, GetExtensionReturnsState) {
   EXPECT_THAT(ext, NotNull());
 }
 
+TEST_F(ClapPluginTest, GetExtensionReturnsProcessStats) {
+  const void* ext = plugin_->GetExtension(STINKY_EXT_PROCESS_STATS);
+  EXPECT_THAT(ext, NotNull());
+
+  ext = plugin_->GetExtension(CLAP_EXT_TAIL);
+  EXPECT_THAT(ext, NotNull());
+}
+
 TEST_F(ClapPluginTest, GetExtensionReturnsNullForUnknown) {
   const void* ext = plugin_->GetExtension("unknown.extension");
   EXPECT_EQ(ext, nullptr);
@@ -236,6 +250,344 @@ TEST_F(ClapPluginTest, ProcessSilenceWithNoInput) {
   }
 }
 
+TEST_F(ClapPluginTest, SilentInputSleepsOnceTailHasPassed) {
+  ASSERT_TRUE(plugin_->Activate(44100.0, 64, 512));
+  ASSERT_TRUE(plugin_->StartProcessing());
+
+  auto* tail = static_cast<const clap_plugin_tail_t*>(
+      plugin_->GetExtension(CLAP_EXT_TAIL));
+  ASSERT_NE(tail, nullptr);
+  const uint32_t tail_frames = tail->get(plugin_->ClapPlugin());
+  EXPECT_EQ(tail_frames, 2205u);  // Default 50 ms release
+
+  constexpr uint32_t frame_count = 512;
+  std::vector<float> in_left(frame_count, 0.0f);
+  std::vector<float> in_right(frame_count, 0.0f);
+  std::vector<float> out_left(frame_count, 1.0f);
+  std::vector<float> out_right(frame_count, 1.0f);
+  float* in_ptrs[] = {in_left.data(), in_right.data()};
+  float* out_ptrs[] = {out_left.data(), out_right.data()};
+  clap_audio_buffer_t input = {in_ptrs, nullptr, 2, 0, 0};
+  clap_audio_buffer_t output = {out_ptrs, nullptr, 2, 0, 0};
+
+  clap_process_t process = {};
+  process.frames_count = frame_count;
+  process.audio_inputs = &input;
+  process.audio_inputs_count = 1;
+  process.audio_outputs = &output;
+  process.audio_outputs_count = 1;
+
+  // Silence keeps processing until the release has run out
+  uint64_t processed = 0;
+  while (plugin_->Process(&process) == CLAP_PROCESS_CONTINUE) {
+    processed += frame_count;
+    ASSERT_LT(processed, tail_frames) << "never went to sleep";
+  }
+  EXPECT_GE(processed + frame_count, tail_frames);
+
+  // Past the tail the block is skipped and cleared
+  std::fill(out_left.begin(), out_left.end(), 1.0f);
+  std::fill(out_right.begin(), out_right.end(), 1.0f);
+  EXPECT_EQ(plugin_->Process(&process), CLAP_PROCESS_SLEEP);
+  for (uint32_t i = 0; i < frame_count; ++i) {
+    ASSERT_EQ(out_left[i], 0.0f);
+    ASSERT_EQ(out_right[i], 0.0f);
+  }
+  EXPECT_EQ(output.constant_mask, 0b11u);
+
+  // Input wakes it up
+  in_left[0] = 0.5f;
+  EXPECT_EQ(plugin_->Process(&process), CLAP_PROCESS_CONTINUE);
+  EXPECT_EQ(output.constant_mask, 0u);
+}
+
+TEST_F(ClapPluginTest, InPlaceMatchesSeparateBuffers) {
+  auto in_place = std::make_unique<CompressorClap>(host_->Host());
+  ASSERT_TRUE(in_place->Init());
+  for (auto* plugin : {plugin_.get(), in_place.get()}) {
+    ASSERT_TRUE(plugin->Activate(48000.0, 64, 512));
+    ASSERT_TRUE(plugin->StartProcessing());
+  }
+
+  constexpr uint32_t frame_count = 512;
+  std::vector<float> in_left(frame_count);
+  std::vector<float> in_right(frame_count);
+  std::vector<float> out_left(frame_count);
+  std::vector<float> out_right(frame_count);
+  std::vector<float> io_left(frame_count);
+  std::vector<float> io_right(frame_count);
+  float* in_ptrs[] = {in_left.data(), in_right.data()};
+  float* out_ptrs[] = {out_left.data(), out_right.data()};
+  float* io_ptrs[] = {io_left.data(), io_right.data()};
+  clap_audio_buffer_t input = {in_ptrs, nullptr, 2, 0, 0};
+  clap_audio_buffer_t output = {out_ptrs, nullptr, 2, 0, 0};
+  clap_audio_buffer_t io = {io_ptrs, nullptr, 2, 0, 0};
+
+  clap_process_t separate = {};
+  separate.frames_count = frame_count;
+  separate.audio_inputs = &input;
+  separate.audio_inputs_count = 1;
+  separate.audio_outputs = &output;
+  separate.audio_outputs_count = 1;
+
+  // The host hands the same buffer in and out
+  clap_process_t shared = separate;
+  shared.audio_inputs = &io;
+  shared.audio_outputs = &io;
+
+  for (uint32_t block = 0; block < 8; ++block) {
+    for (uint32_t i = 0; i < frame_count; ++i) {
+      const float t = static_cast<float>(block * frame_count + i);
+      in_left[i] = io_left[i] = 0.9f * std::sin(0.01f * t);
+      in_right[i] = io_right[i] = 0.6f * std::sin(0.023f * t);
+    }
+
+    ASSERT_EQ(plugin_->Process(&separate), CLAP_PROCESS_CONTINUE);
+    ASSERT_EQ(in_place->Process(&shared), CLAP_PROCESS_CONTINUE);
+    ASSERT_EQ(io_left, out_left) << "block " << block;
+    ASSERT_EQ(io_right, out_right) << "block " << block;
+  }
+}
+
+TEST_F(ClapPluginTest, DoubleBuffersMatchFloat) {
+  auto wide = std::make_unique<CompressorClap>(host_->Host());
+  ASSERT_TRUE(wide->Init());
+  for (auto* plugin : {plugin_.get(), wide.get()}) {
+    ASSERT_TRUE(plugin->Activate(48000.0, 64, 512));
+    ASSERT_TRUE(plugin->StartProcessing());
+  }
+
+  clap_audio_port_info_t info;
+  ASSERT_TRUE(wide->AudioPortsGet(0, true, &info));
+  EXPECT_TRUE(info.flags & CLAP_AUDIO_PORT_SUPPORTS_64BITS);
+  ASSERT_TRUE(wide->AudioPortsGet(0, false, &info));
+  EXPECT_TRUE(info.flags & CLAP_AUDIO_PORT_SUPPORTS_64BITS);
+
+  constexpr uint32_t frame_count = 512;
+  std::vector<float> left(frame_count);
+  std::vector<float> right(frame_count);
+  std::vector<double> wide_left(frame_count);
+  std::vector<double> wide_right(frame_count);
+  float* ptrs[] = {left.data(), right.data()};
+  double* wide_ptrs[] = {wide_left.data(), wide_right.data()};
+  clap_audio_buffer_t io = {ptrs, nullptr, 2, 0, 0};
+  clap_audio_buffer_t wide_io = {nullptr, wide_ptrs, 2, 0, 0};
+
+  clap_process_t process = {};
+  process.frames_count = frame_count;
+  process.audio_inputs = &io;
+  process.audio_inputs_count = 1;
+  process.audio_outputs = &io;
+  process.audio_outputs_count = 1;
+
+  clap_process_t wide_process = process;
+  wide_process.audio_inputs = &wide_io;
+  wide_process.audio_outputs = &wide_io;
+
+  for (uint32_t block = 0; block < 8; ++block) {
+    for (uint32_t i = 0; i < frame_count; ++i) {
+      const float t = static_cast<float>(block * frame_count + i);
+      left[i] = 0.9f * std::sin(0.01f * t);
+      right[i] = 0.6f * std::sin(0.023f * t);
+      wide_left[i] = left[i];
+      wide_right[i] = right[i];
+    }
+
+    ASSERT_EQ(plugin_->Process(&process), CLAP_PROCESS_CONTINUE);
+    ASSERT_EQ(wide->Process(&wide_process), CLAP_PROCESS_CONTINUE);
+    for (uint32_t i = 0; i < frame_count; ++i) {
+      ASSERT_NEAR(wide_left[i], left[i], 1e-4) << "block " << block;
+      ASSERT_NEAR(wide_right[i], right[i], 1e-4) << "block " << block;
+    }
+  }
+
+  // Input and output must share a sample size
+  process.audio_outputs = &wide_io;
+  EXPECT_EQ(plugin_->Process(&process), CLAP_PROCESS_ERROR);
+}
+
+TEST_F(ClapPluginTest, SurroundLayoutMatchesStereoPerChannel) {
+  auto* config = static_cast<const clap_plugin_audio_ports_config_t*>(
+      plugin_->GetExtension(CLAP_EXT_AUDIO_PORTS_CONFIG));
+  ASSERT_NE(config, nullptr);
+  const clap_plugin_t* clap_plugin = plugin_->ClapPlugin();
+  EXPECT_EQ(config->count(clap_plugin), stinky_dsp::kChannelLayoutCount);
+
+  clap_audio_ports_config_t layout;
+  EXPECT_FALSE(config->get(clap_plugin, stinky_dsp::kChannelLayoutCount,
+                           &layout));
+  ASSERT_TRUE(config->get(clap_plugin, 2, &layout));
+  EXPECT_EQ(layout.input_port_count, plugin_->AudioPortsCount(true));
+  EXPECT_EQ(layout.main_input_channel_count, 6u);
+  EXPECT_STREQ(layout.main_output_port_type, CLAP_PORT_SURROUND);
+  EXPECT_FALSE(config->select(clap_plugin, stinky_dsp::kChannelLayoutCount));
+  ASSERT_TRUE(config->select(clap_plugin, layout.id));
+
+  clap_audio_port_info_t port;
+  ASSERT_TRUE(plugin_->AudioPortsGet(0, false, &port));
+  EXPECT_EQ(port.channel_count, 6u);
+  EXPECT_STREQ(port.port_type, CLAP_PORT_SURROUND);
+
+  auto stereo = std::make_unique<CompressorClap>(host_->Host());
+  ASSERT_TRUE(stereo->Init());
+  for (auto* plugin : {plugin_.get(), stereo.get()}) {
+    ASSERT_TRUE(plugin->Activate(48000.0, 64, 512));
+    ASSERT_TRUE(plugin->StartProcessing());
+  }
+
+  constexpr uint32_t kChannels = 6;
+  constexpr uint32_t frame_count = 512;
+  std::vector<std::vector<float>> surround(kChannels,
+                                           std::vector<float>(frame_count));
+  std::vector<float> left(frame_count);
+  std::vector<float> right(frame_count);
+  float* surround_ptrs[kChannels];
+  for (uint32_t c = 0; c < kChannels; ++c) {
+    surround_ptrs[c] = surround[c].data();
+  }
+  float* stereo_ptrs[] = {left.data(), right.data()};
+  clap_audio_buffer_t surround_io = {surround_ptrs, nullptr, kChannels, 0, 0};
+  clap_audio_buffer_t stereo_io = {stereo_ptrs, nullptr, 2, 0, 0};
+
+  clap_process_t process = {};
+  process.frames_count = frame_count;
+  process.audio_inputs = &surround_io;
+  process.audio_inputs_count = 1;
+  process.audio_outputs = &surround_io;
+  process.audio_outputs_count = 1;
+
+  clap_process_t stereo_process = process;
+  stereo_process.audio_inputs = &stereo_io;
+  stereo_process.audio_outputs = &stereo_io;
+
+  // Channels 0 and 5 through a stereo instance give the same output.
+  // Channel 0 is the loudest, so linked detectors see the same peak.
+  for (uint32_t block = 0; block < 8; ++block) {
+    for (uint32_t i = 0; i < frame_count; ++i) {
+      const float t = static_cast<float>(block * frame_count + i);
+      const float signal = 0.9f * std::sin(0.01f * t);
+      for (uint32_t c = 0; c < kChannels; ++c) {
+        surround[c][i] = signal * (1.0f - 0.15f * static_cast<float>(c));
+      }
+      left[i] = surround[0][i];
+      right[i] = surround[5][i];
+    }
+
+    ASSERT_EQ(plugin_->Process(&process), CLAP_PROCESS_CONTINUE);
+    ASSERT_EQ(stereo->Process(&stereo_process), CLAP_PROCESS_CONTINUE);
+    ASSERT_EQ(surround[0], left) << "block " << block;
+    ASSERT_EQ(surround[5], right) << "block " << block;
+  }
+}
+
+TEST_F(ClapPluginTest, MonoLayoutMatchesStereoWithBothSidesEqual) {
+  auto* config = static_cast<const clap_plugin_audio_ports_config_t*>(
+      plugin_->GetExtension(CLAP_EXT_AUDIO_PORTS_CONFIG));
+  ASSERT_NE(config, nullptr);
+  ASSERT_TRUE(config->select(plugin_->ClapPlugin(), 0));
+
+  clap_audio_port_info_t port;
+  ASSERT_TRUE(plugin_->AudioPortsGet(0, true, &port));
+  EXPECT_EQ(port.channel_count, 1u);
+  EXPECT_STREQ(port.port_type, CLAP_PORT_MONO);
+
+  auto stereo = std::make_unique<CompressorClap>(host_->Host());
+  ASSERT_TRUE(stereo->Init());
+  for (auto* plugin : {plugin_.get(), stereo.get()}) {
+    ASSERT_TRUE(plugin->Activate(48000.0, 64, 512));
+    ASSERT_TRUE(plugin->StartProcessing());
+  }
+
+  constexpr uint32_t frame_count = 512;
+  std::vector<float> mono(frame_count);
+  std::vector<float> left(frame_count);
+  std::vector<float> right(frame_count);
+  float* mono_ptrs[] = {mono.data()};
+  float* stereo_ptrs[] = {left.data(), right.data()};
+  clap_audio_buffer_t mono_io = {mono_ptrs, nullptr, 1, 0, 0};
+  clap_audio_buffer_t stereo_io = {stereo_ptrs, nullptr, 2, 0, 0};
+
+  clap_process_t process = {};
+  process.frames_count = frame_count;
+  process.audio_inputs = &mono_io;
+  process.audio_inputs_count = 1;
+  process.audio_outputs = &mono_io;
+  process.audio_outputs_count = 1;
+
+  clap_process_t stereo_process = process;
+  stereo_process.audio_inputs = &stereo_io;
+  stereo_process.audio_outputs = &stereo_io;
+
+  // The one channel is processed once, like either side of a stereo pair
+  for (uint32_t block = 0; block < 8; ++block) {
+    for (uint32_t i = 0; i < frame_count; ++i) {
+      const float t = static_cast<float>(block * frame_count + i);
+      mono[i] = left[i] = right[i] = 0.9f * std::sin(0.01f * t);
+    }
+
+    ASSERT_EQ(plugin_->Process(&process), CLAP_PROCESS_CONTINUE);
+    ASSERT_EQ(stereo->Process(&stereo_process), CLAP_PROCESS_CONTINUE);
+    ASSERT_EQ(mono, left) << "block " << block;
+  }
+}
+
+TEST_F(ClapPluginTest, SettledConstantInputGivesConstantOutput) {
+  ASSERT_TRUE(plugin_->Activate(44100.0, 64, 512));
+  ASSERT_TRUE(plugin_->StartProcessing());
+
+  auto* tail = static_cast<const clap_plugin_tail_t*>(
+      plugin_->GetExtension(CLAP_EXT_TAIL));
+  ASSERT_NE(tail, nullptr);
+  const uint32_t tail_frames = tail->get(plugin_->ClapPlugin());
+
+  constexpr uint32_t frame_count = 512;
+  std::vector<float> in_left(frame_count, 0.5f);
+  std::vector<float> in_right(frame_count, 0.5f);
+  std::vector<float> out_left(frame_count, 0.0f);
+  std::vector<float> out_right(frame_count, 0.0f);
+  float* in_ptrs[] = {in_left.data(), in_right.data()};
+  float* out_ptrs[] = {out_left.data(), out_right.data()};
+  clap_audio_buffer_t input = {in_ptrs, nullptr, 2, 0, 0b11};
+  clap_audio_buffer_t output = {out_ptrs, nullptr, 2, 0, 0};
+
+  clap_process_t process = {};
+  process.frames_count = frame_count;
+  process.audio_inputs = &input;
+  process.audio_inputs_count = 1;
+  process.audio_outputs = &output;
+  process.audio_outputs_count = 1;
+
+  // Runs the DSP until the constant has outlasted the tail and the output
+  // stopped changing
+  uint64_t processed = 0;
+  while (true) {
+    EXPECT_EQ(plugin_->Process(&process), CLAP_PROCESS_CONTINUE);
+    if (output.constant_mask == 0b11u) break;
+    processed += frame_count;
+    ASSERT_LT(processed, tail_frames + 96000u) << "never settled";
+  }
+  EXPECT_GE(processed, tail_frames);
+
+  const float steady_value = out_left[0];
+  for (uint32_t i = 0; i < frame_count; ++i) {
+    ASSERT_EQ(out_left[i], steady_value);
+    ASSERT_EQ(out_right[i], steady_value);
+  }
+
+  // 0.5 (-6 dBFS) is 14 dB over the default -20 dB threshold: 4:1 leaves
+  // 3.5 dB of it
+  EXPECT_NEAR(steady_value, std::pow(10.0f, -16.5f / 20.0f), 1e-3f);
+
+  // The full DSP agrees with the shortcut
+  input.constant_mask = 0;
+  EXPECT_EQ(plugin_->Process(&process), CLAP_PROCESS_CONTINUE);
+  EXPECT_EQ(output.constant_mask, 0u);
+  for (uint32_t i = 0; i < frame_count; ++i) {
+    ASSERT_NEAR(out_left[i], steady_value, 1e-6f);
+    ASSERT_NEAR(out_right[i], steady_value, 1e-6f);
+  }
+}
+
 TEST_F(ClapPluginTest, ProcessModifiesSignal) {
   plugin_->Activate(44100.0, 64, 512);
   plugin_->StartProcessing();
@@ -398,5 +750,187 @@ TEST_F(ClapPluginTest, MultipleProcessCallsWork) {
   SUCCEED();
 }
 
+TEST_F(ClapPluginTest, ProcessStatsRecordEachBlockWhenEnabled) {
+  plugin_->Activate(48000.0, 64, 512);
+  plugin_->StartProcessing();
+
+  const clap_plugin_t* clap_plugin = plugin_->ClapPlugin();
+  const auto* stats = static_cast<const stinky_plugin_process_stats_t*>(
+      plugin_->GetExtension(STINKY_EXT_PROCESS_STATS));
+  ASSERT_THAT(stats, NotNull());
+
+  constexpr uint32_t frame_count = 64;
+  std::vector<float> in_left(frame_count, 0.3f);
+  std::vector<float> in_right(frame_count, 0.3f);
+  std::vector<float> out_left(frame_count, 0.0f);
+  std::vector<float> out_right(frame_count, 0.0f);
+
+  float* in_ptrs[] = {in_left.data(), in_right.data()};
+  float* out_ptrs[] = {out_left.data(), out_right.data()};
+  clap_audio_buffer_t input = {in_ptrs, nullptr, 2, frame_count, 0};
+  clap_audio_buffer_t output = {out_ptrs, nullptr, 2, frame_count, 0};
+
+  clap_process_t process = {};
+  process.frames_count = frame_count;
+  process.audio_inputs = &input;
+  process.audio_inputs_count = 1;
+  process.audio_outputs = &output;
+  process.audio_outputs_count = 1;
+
+  // Disabled by default: nothing recorded
+  EXPECT_FALSE(stats->is_enabled(clap_plugin));
+  plugin_->Process(&process);
+  stinky_process_stats_summary_t summary;
+  ASSERT_TRUE(stats->get_summary(clap_plugin, &summary));
+  EXPECT_EQ(summary.blocks, 0u);
+
+  stats->set_enabled(clap_plugin, true);
+  for (int i = 0; i < 3; ++i) {
+    plugin_->Process(&process);
+  }
+
+  ASSERT_TRUE(stats->get_summary(clap_plugin, &summary));
+  EXPECT_EQ(summary.blocks, 3u);
+  EXPECT_EQ(summary.frames, 3u * frame_count);
+  EXPECT_GT(summary.max_block_nanoseconds, 0u);
+  EXPECT_LE(summary.max_block_nanoseconds, summary.total_nanoseconds);
+  uint64_t histogram_blocks = 0;
+  for (uint64_t count : summary.load_histogram) histogram_blocks += count;
+  EXPECT_EQ(histogram_blocks, 3u);
+
+  stinky_process_stats_block_t blocks[8];
+  ASSERT_EQ(stats->read_blocks(clap_plugin, blocks, 8), 3u);
+  EXPECT_EQ(blocks[0].frames, frame_count);
+  EXPECT_EQ(stats->read_blocks(clap_plugin, blocks, 8), 0u);
+
+  stats->reset(clap_plugin);
+  ASSERT_TRUE(stats->get_summary(clap_plugin, &summary));
+  EXPECT_EQ(summary.blocks, 0u);
+}
+
+TEST_F(ClapPluginTest, ParamEventsApplyAtTheirTimestamps) {
+  plugin_->Activate(44100.0, 64, 512);
+  plugin_->StartProcessing();
+
+  // -40 dBFS stays below the threshold, so only the makeup gain acts
+  constexpr uint32_t frame_count = 512;
+  std::vector<float> in_left(frame_count, 0.01f);
+  std::vector<float> in_right(frame_count, 0.01f);
+  std::vector<float> out_left(frame_count, 0.0f);
+  std::vector<float> out_right(frame_count, 0.0f);
+
+  float* in_ptrs[] = {in_left.data(), in_right.data()};
+  float* out_ptrs[] = {out_left.data(), out_right.data()};
+  clap_audio_buffer_t input = {in_ptrs, nullptr, 2, frame_count, 0};
+  clap_audio_buffer_t output = {out_ptrs, nullptr, 2, frame_count, 0};
+
+  // Makeup is normalized over -12..24 dB. The events at 300 and 305 are
+  // closer than the minimum sub-block, so both apply at frame 300.
+  ParamEventList events;
+  events.Add(100, kParamIdMakeupGain, (6.0 + 12.0) / 36.0);
+  events.Add(300, kParamIdMakeupGain, (12.0 + 12.0) / 36.0);
+  events.Add(305, kParamIdMakeupGain, (0.0 + 12.0) / 36.0);
+
+  clap_process_t process = {};
+  process.frames_count = frame_count;
+  process.audio_inputs = &input;
+  process.audio_inputs_count = 1;
+  process.audio_outputs = &output;
+  process.audio_outputs_count = 1;
+  process.in_events = events.Events();
+
+  EXPECT_EQ(plugin_->Process(&process), CLAP_PROCESS_CONTINUE);
+
+  // Untouched before the first event, then a smoothed ramp up from frame
+  // 100 and back down from frame 300 (towards 0 dB, not 12 dB)
+  for (uint32_t i = 0; i < 100; ++i) {
+    EXPECT_NEAR(out_left[i], 0.01f, 1e-6f) << "frame " << i;
+  }
+  for (uint32_t i = 100; i < 300; ++i) {
+    EXPECT_GT(out_left[i], out_left[i - 1]) << "frame " << i;
+    EXPECT_FLOAT_EQ(out_right[i], out_left[i]);
+  }
+  for (uint32_t i = 300; i < frame_count; ++i) {
+    EXPECT_LT(out_left[i], out_left[i - 1]) << "frame " << i;
+    EXPECT_FLOAT_EQ(out_right[i], out_left[i]);
+  }
+}
+
+TEST_F(ClapPluginTest, ProcessDoesNotAllocate) {
+  // Everything allowed to allocate happens before the guard
+  ASSERT_TRUE(plugin_->Activate(48000.0, 64, 512));
+  ASSERT_TRUE(plugin_->StartProcessing());
+  const auto* stats = static_cast<const stinky_plugin_process_stats_t*>(
+      plugin_->GetExtension(STINKY_EXT_PROCESS_STATS));
+  ASSERT_THAT(stats, NotNull());
+  stats->set_enabled(plugin_->ClapPlugin(), true);
+
+  constexpr uint32_t frame_count = 512;
+  std::vector<float> left(frame_count);
+  std::vector<float> right(frame_count);
+  std::vector<float> sidechain(frame_count);
+  std::vector<double> left64(frame_count);
+  std::vector<double> right64(frame_count);
+  float* ptrs[] = {left.data(), right.data()};
+  float* sc_ptrs[] = {sidechain.data(), sidechain.data()};
+  double* ptrs64[] = {left64.data(), right64.data()};
+  clap_audio_buffer_t inputs[] = {{ptrs, nullptr, 2, 0, 0},
+                                  {sc_ptrs, nullptr, 2, 0, 0}};
+  clap_audio_buffer_t io64 = {nullptr, ptrs64, 2, 0, 0};
+
+  ParamEventList events;
+  events.Add(0, kParamIdThreshold, 0.5);
+  events.Add(100, kParamIdRatio, 0.7);
+  events.Add(200, kParamIdKnee, 0.5);
+  events.Add(300, kParamIdAutoMakeup, 1.0);
+  ParamEventList flush;
+  flush.Add(0, kParamIdAttack, 0.2);
+  flush.Add(0, kParamIdAutoMakeup, 0.0);
+
+  clap_process_t process = {};
+  process.frames_count = frame_count;
+  process.audio_outputs_count = 1;
+  process.in_events = events.Events();
+
+  // Loud blocks in every buffer and port combination, then silence until
+  // the plugin sleeps, with a flush and a reset in between
+  constexpr uint32_t kBlocks = 16;
+  clap_process_status statuses[kBlocks];
+  uint64_t allocations;
+  uint64_t frees;
+  {
+    stinky_dsp::AllocationGuard guard;
+    for (uint32_t block = 0; block < kBlocks; ++block) {
+      const float level = block < 6 ? 0.9f : 0.0f;
+      for (uint32_t i = 0; i < frame_count; ++i) {
+        const float t = static_cast<float>(block * frame_count + i);
+        left[i] = level * std::sin(0.05f * t);
+        right[i] = -left[i];
+        sidechain[i] = level * std::sin(0.003f * t);
+        left64[i] = left[i];
+        right64[i] = right[i];
+      }
+      const bool use_64 = block % 3 == 2;
+      process.audio_inputs = use_64 ? &io64 : inputs;
+      process.audio_inputs_count = !use_64 && block % 2 == 1 ? 2 : 1;
+      process.audio_outputs = use_64 ? &io64 : inputs;
+      statuses[block] = plugin_->Process(&process);
+
+      if (block == 3) plugin_->ParamsFlush(flush.Events(), nullptr);
+      if (block == 8) plugin_->Reset();
+    }
+    allocations = guard.Allocations();
+    frees = guard.Frees();
+  }
+
+  for (clap_process_status status : statuses) {
+    EXPECT_NE(status, CLAP_PROCESS_ERROR);
+  }
+  EXPECT_EQ(allocations, 0u);
+  EXPECT_EQ(frees, 0u);
+  plugin_->StopProcessing();
+  plugin_->Deactivate();
+}
+
 }  // namespace
 }  // namespace fast_compressor
@@ -9,6 +9,8 @@
 #include <cmath>
 #include <vector>
 
+#include "simd_utils.h"
+
 namespace fast_compressor {
 namespace {
 
@@ -252,5 +254,172 @@ TEST_F(CompressorProcessorTest, ExtremeRatioWorks) {
   }
 }
 
+TEST_F(CompressorProcessorTest, BlockSizeDoesNotChangeOutput) {
+  CompressorParams params;
+  params.threshold_db = -24.0f;
+  params.ratio = 6.0f;
+  params.attack_ms = 2.0f;
+  params.release_ms = 80.0f;
+  params.knee_db = 6.0f;
+  params.auto_makeup = true;
+
+  // Decaying sine bursts spanning several detector chunks
+  constexpr size_t kFrames = 3 * CompressorProcessor::kMaxBlockSize + 37;
+  std::vector<float> signal(kFrames);
+  for (size_t i = 0; i < kFrames; ++i) {
+    signal[i] = 0.8f * std::sin(0.05f * static_cast<float>(i)) *
+                std::exp(-static_cast<float>(i % 300) / 120.0f);
+  }
+
+  // Parameters set before Initialize apply without a smoothing ramp
+  CompressorProcessor whole;
+  whole.SetParams(params);
+  whole.Initialize(kSampleRate);
+  std::vector<float> left_whole = signal;
+  std::vector<float> right_whole = signal;
+  whole.ProcessStereo(left_whole.data(), right_whole.data(), kFrames);
+
+  CompressorProcessor split;
+  split.SetParams(params);
+  split.Initialize(kSampleRate);
+  std::vector<float> left_split = signal;
+  std::vector<float> right_split = signal;
+  for (size_t offset = 0; offset < kFrames; offset += 13) {
+    const size_t frames = std::min<size_t>(13, kFrames - offset);
+    split.ProcessStereo(left_split.data() + offset,
+                        right_split.data() + offset, frames);
+  }
+
+  for (size_t i = 0; i < kFrames; ++i) {
+    EXPECT_NEAR(left_whole[i], left_split[i], kEpsilon);
+    EXPECT_NEAR(right_whole[i], right_split[i], kEpsilon);
+  }
+  EXPECT_NEAR(whole.GetGainReduction(), split.GetGainReduction(), kEpsilon);
+}
+
+// Per-sample reference of the whole chain, checking the chunked makeup paths
+TEST_F(CompressorProcessorTest, AutoMakeupMatchesPerSampleReference) {
+  CompressorParams params;
+  params.threshold_db = -24.0f;
+  params.ratio = 6.0f;
+  params.attack_ms = 2.0f;
+  params.release_ms = 80.0f;
+  params.knee_db = 6.0f;
+  params.auto_makeup = true;
+  processor_.SetParams(params);
+  processor_.Initialize(kSampleRate);
+
+  constexpr size_t kFrames = 3 * CompressorProcessor::kMaxBlockSize + 37;
+  std::vector<float> left(kFrames);
+  std::vector<float> right(kFrames);
+  for (size_t i = 0; i < kFrames; ++i) {
+    left[i] = 0.8f * std::sin(0.05f * static_cast<float>(i)) *
+              std::exp(-static_cast<float>(i % 300) / 120.0f);
+    right[i] = 0.5f * std::sin(0.021f * static_cast<float>(i));
+  }
+
+  const float rate = static_cast<float>(kSampleRate);
+  const float attack = std::exp(-1.0f / (params.attack_ms * 0.001f * rate));
+  const float release = std::exp(-1.0f / (params.release_ms * 0.001f * rate));
+  const float alpha = std::exp(-1.0f / (rate * 2.0f));
+  const float slope = 1.0f / params.ratio - 1.0f;
+  const float c_est = -params.threshold_db * slope / 2.0f;
+  std::vector<float> expected_gain(kFrames);
+  float envelope = 1.0f;
+  float c_dev = 0.0f;
+  for (size_t i = 0; i < kFrames; ++i) {
+    const float level_db = stinky_dsp::simd::LinearToDb(
+        std::max(std::abs(left[i]), std::abs(right[i])));
+    float target_db;
+    stinky_dsp::simd::ComputeGainReductionDb(
+        &target_db, &level_db, params.threshold_db, slope, params.knee_db, 1);
+    const float target = stinky_dsp::simd::DbToLinear(target_db);
+    const float coeff = target < envelope ? attack : release;
+    envelope = coeff * envelope + (1.0f - coeff) * target;
+    const float reduction_db = stinky_dsp::simd::LinearToDb(envelope);
+    c_dev = alpha * c_dev + (1.0f - alpha) * (reduction_db - c_est);
+    expected_gain[i] =
+        envelope * stinky_dsp::simd::DbToLinear(-(c_dev + c_est));
+  }
+
+  std::vector<float> out_left(kFrames);
+  std::vector<float> out_right(kFrames);
+  processor_.ProcessStereo(left.data(), right.data(), out_left.data(),
+                           out_right.data(), kFrames);
+
+  for (size_t i = 0; i < kFrames; ++i) {
+    EXPECT_NEAR(out_left[i], left[i] * expected_gain[i], 1e-4f);
+    EXPECT_NEAR(out_right[i], right[i] * expected_gain[i], 1e-4f);
+  }
+}
+
+TEST_F(CompressorProcessorTest, MakeupGainChangeRampsSmoothly) {
+  // -60 dBFS stays far below the threshold, so only the makeup gain acts
+  std::vector<float> left(2048, 0.001f);
+  std::vector<float> right(2048, 0.001f);
+  processor_.ProcessStereo(left.data(), right.data(), 64);
+
+  CompressorParams params = processor_.GetParams();
+  params.makeup_gain_db = 12.0f;
+  processor_.SetParams(params);
+  processor_.ProcessStereo(left.data() + 64, right.data() + 64, 2048 - 64);
+
+  // No step: each sample moves by a small fraction of the 4x change
+  for (size_t i = 1; i < left.size(); ++i) {
+    EXPECT_GE(left[i], left[i - 1]);
+    EXPECT_LT(left[i] - left[i - 1], 0.001f * 0.01f);
+  }
+  // The ramp (20 ms = 882 samples) has finished well before the end
+  const float boosted = 0.001f * std::pow(10.0f, 12.0f / 20.0f);
+  EXPECT_NEAR(left.back(), boosted, 1e-6f);
+  EXPECT_NEAR(right.back(), boosted, 1e-6f);
+}
+
+TEST_F(CompressorProcessorTest, DetectorIsLinkedAcrossChannels) {
+  CompressorParams params;
+  params.threshold_db = -20.0f;
+  params.ratio = 4.0f;
+  params.attack_ms = 1.0f;
+  params.release_ms = 100.0f;
+  processor_.SetParams(params);
+
+  CompressorProcessor stereo;
+  stereo.SetParams(params);
+  stereo.Initialize(kSampleRate);
+
+  // Channel 0 is always the loudest, so a stereo pair of channels 0 and 5
+  // sees the same detector level as all six channels together
+  constexpr uint32_t kChannels = 6;
+  constexpr size_t kFrames = 2048;
+  std::vector<std::vector<float>> channels(kChannels,
+                                           std::vector<float>(kFrames));
+  float* pointers[kChannels];
+  for (uint32_t c = 0; c < kChannels; ++c) {
+    for (size_t i = 0; i < kFrames; ++i) {
+      channels[c][i] = 0.9f * std::sin(0.01f * static_cast<float>(i)) *
+                       (1.0f - 0.15f * static_cast<float>(c));
+    }
+    pointers[c] = channels[c].data();
+  }
+  std::vector<float> left(channels[0].begin(), channels[0].end());
+  std::vector<float> right(channels[5].begin(), channels[5].end());
+  std::vector<float> alone(channels[5].begin(), channels[5].end());
+
+  processor_.ProcessChannels<float>(pointers, pointers, kChannels, kFrames);
+  stereo.ProcessStereo(left.data(), right.data(), kFrames);
+
+  EXPECT_EQ(channels[0], left);
+  EXPECT_EQ(channels[5], right);
+
+  // On its own the quiet channel is compressed less
+  CompressorProcessor mono;
+  mono.SetParams(params);
+  mono.Initialize(kSampleRate);
+  mono.ProcessStereo(alone.data(), alone.data(), alone.data(), alone.data(),
+                     kFrames);
+  EXPECT_GT(std::abs(alone[kFrames - 500]),
+            std::abs(channels[5][kFrames - 500]) * 1.1f);
+}
+
 }  // namespace
 }  // namespace fast_compressor
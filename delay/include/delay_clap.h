@@ -10,6 +10,10 @@
 #include <memory>
 
 #include "delay_processor.h"
+#include "channel_layouts.h"
+#include "constant_detector.h"
+#include "process_stats.h"
+#include "silence_detector.h"
 
 namespace stinky_delay {
 
@@ -39,6 +43,7 @@ class DelayClap {
   explicit DelayClap(const clap_host_t* host);
   ~DelayClap() = default;
 
+  // Activate is the only call that allocates
   bool Init() noexcept;
   bool Activate(double sample_rate, uint32_t min_frames,
                 uint32_t max_frames) noexcept;
@@ -69,10 +74,33 @@ class DelayClap {
   bool AudioPortsGet(uint32_t index, bool is_input,
                      clap_audio_port_info_t* info) const noexcept;
 
+  // Audio ports config extension: the layouts in stinky_dsp::kChannelLayouts.
+  // The host selects one while the plugin is deactivated.
+  uint32_t AudioPortsConfigCount() const noexcept;
+  bool AudioPortsConfigGet(uint32_t index,
+                           clap_audio_ports_config_t* config) const noexcept;
+  bool AudioPortsConfigSelect(clap_id config_id) noexcept;
+
   const clap_plugin_t* ClapPlugin() noexcept { return &plugin_; }
 
+  // Tail extension: frames of output after the input goes silent
+  uint32_t TailGet() const noexcept { return silence_.Tail(); }
+
+  // Per-block cost instrumentation (STINKY_EXT_PROCESS_STATS)
+  stinky_dsp::ProcessStats& GetProcessStats() noexcept {
+    return process_stats_;
+  }
+
  private:
   void ProcessParameterChanges(const clap_input_events_t* events) noexcept;
+  // Applies one event; returns true if it changed a parameter
+  bool ApplyEvent(const clap_event_header_t* header) noexcept;
+  // Process() for 32- or 64-bit buffers
+  template <typename T>
+  clap_process_status ProcessAudio(const clap_process_t* process,
+                                   const T* const* inputs,
+                                   T* const* outputs) noexcept;
+
   void UpdateProcessorParams() noexcept;
   double ParamIdToValue(clap_id param_id) const noexcept;
   void SetParamValue(clap_id param_id, double value) noexcept;
@@ -81,9 +109,15 @@ class DelayClap {
   const clap_host_t* host_;
   DelayProcessor processor_;
   
+  // Shared with the audio thread, which must never wait on a lock
+  static_assert(std::atomic<double>::is_always_lock_free);
   std::atomic<double> param_values_[kParamIdCount];
   double sample_rate_;
   bool is_processing_;
+  uint32_t channel_layout_;  // Index into stinky_dsp::kChannelLayouts
+  stinky_dsp::ProcessStats process_stats_;
+  stinky_dsp::SilenceDetector silence_;
+  stinky_dsp::ConstantDetector constant_;
 };
 
 }  // namespace stinky_delay
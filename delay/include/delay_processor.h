@@ -7,6 +7,10 @@
 #include <cstdint>
 #include <vector>
 
+#include "channels.h"
+#include "ring_buffer.h"
+#include "smoother.h"
+
 namespace stinky_delay {
 
 struct DelayParams {
@@ -19,24 +23,60 @@ class DelayProcessor {
   DelayProcessor();
   ~DelayProcessor() = default;
 
-  void Initialize(double sample_rate);
+  // [main thread] Allocates a delay line for each of `num_channels` (1 to
+  // stinky_dsp::kMaxChannels). The only call here that allocates.
+  void Initialize(double sample_rate, uint32_t num_channels = 2);
+
+  // [audio thread] Clears the delay lines
   void Reset();
+
+  // [audio thread] Clamps and applies the parameters
   void SetParams(const DelayParams& params);
   void ProcessStereo(float* left, float* right, uint32_t frames);
 
+  // Process from input to output buffers of float or double samples. The
+  // output may be the input buffer itself. The delay line stores float, so
+  // only the dry path keeps double precision.
+  template <typename T>
+  void ProcessStereo(const T* in_left, const T* in_right, T* out_left,
+                     T* out_right, uint32_t frames);
+
+  // Process `num_channels` channels, at most the count given to Initialize,
+  // from input to output buffers, each through its own delay line.
+  // ProcessStereo with the same buffer on both sides is mono.
+  template <typename T>
+  void ProcessChannels(const T* const* inputs, T* const* outputs,
+                       uint32_t num_channels, uint32_t frames);
+
+  // The whole delay buffer: silence must reach every slot before the
+  // output is silent at any delay time
+  uint32_t GetTailFrames() const { return max_delay_samples_; }
+
+  // True while a mix change is still ramping in
+  bool IsRamping() const { return mix_.IsSmoothing(); }
+
  private:
+  // Channels are mixed over chunks of at most this many frames
+  static constexpr uint32_t kMaxBlockSize = 256;
+
   void UpdateDelayTimes();
   
   double sample_rate_;
   DelayParams params_;
   
-  std::vector<float> delay_buffer_left_;
-  std::vector<float> delay_buffer_right_;
+  // One line per channel, holding the longest delay plus one chunk
+  std::vector<stinky_dsp::RingBuffer<float>> delay_lines_;
   
-  uint32_t write_pos_;
   uint32_t max_delay_samples_;
-  uint32_t delay_samples_left_;
-  uint32_t delay_samples_right_;
+  uint32_t delay_samples_;
+
+  // Wet amount, ramped per sample. Delay time changes are not smoothed.
+  stinky_dsp::Smoother mix_;
+
+  // Per-chunk wet gain while the mix ramps, shared by every channel, and one
+  // channel's delayed samples
+  float wet_gain_[kMaxBlockSize];
+  float wet_[kMaxBlockSize];
   
   bool initialized_;
 };
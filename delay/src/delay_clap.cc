@@ -8,6 +8,10 @@
 #include <cstdio>
 #include <cstring>
 
+#include "process_block.h"
+#include "process_stats_extension.h"
+#include "simd_utils.h"
+
 namespace stinky_delay {
 
 namespace {
@@ -27,6 +31,19 @@ constexpr const char* kFeatures[] = {
     nullptr
 };
 
+// Every port takes 64-bit buffers; PREFER_64BIT_AUDIO builds also ask for them
+constexpr uint32_t kSampleSizeFlags =
+#ifdef STINKY_PREFER_64BIT_AUDIO
+    CLAP_AUDIO_PORT_SUPPORTS_64BITS | CLAP_AUDIO_PORT_PREFERS_64BITS;
+#else
+    CLAP_AUDIO_PORT_SUPPORTS_64BITS;
+#endif
+
+// Main input and output are processed at one sample size
+constexpr uint32_t kMainPortFlags = CLAP_AUDIO_PORT_IS_MAIN |
+                                    CLAP_AUDIO_PORT_REQUIRES_COMMON_SAMPLE_SIZE |
+                                    kSampleSizeFlags;
+
 // Conversion functions from normalized [0,1] to actual values
 inline double NormalizedToDelayTime(double norm) {
   return kDelayTimeMin + norm * (kDelayTimeMax - kDelayTimeMin);
@@ -173,12 +190,47 @@ static const clap_plugin_audio_ports_t kAudioPortsExtension = {
     ClapAudioPortsGet,
 };
 
+// Audio ports config extension callbacks
+uint32_t ClapAudioPortsConfigCount(const clap_plugin_t* plugin) {
+  auto* delay = static_cast<DelayClap*>(plugin->plugin_data);
+  return delay->AudioPortsConfigCount();
+}
+
+bool ClapAudioPortsConfigGet(const clap_plugin_t* plugin, uint32_t index,
+                             clap_audio_ports_config_t* config) {
+  auto* delay = static_cast<DelayClap*>(plugin->plugin_data);
+  return delay->AudioPortsConfigGet(index, config);
+}
+
+bool ClapAudioPortsConfigSelect(const clap_plugin_t* plugin,
+                                clap_id config_id) {
+  auto* delay = static_cast<DelayClap*>(plugin->plugin_data);
+  return delay->AudioPortsConfigSelect(config_id);
+}
+
+static const clap_plugin_audio_ports_config_t kAudioPortsConfigExtension = {
+    ClapAudioPortsConfigCount,
+    ClapAudioPortsConfigGet,
+    ClapAudioPortsConfigSelect,
+};
+
+// Tail extension callbacks
+uint32_t ClapTailGet(const clap_plugin_t* plugin) {
+  auto* delay = static_cast<DelayClap*>(plugin->plugin_data);
+  return delay->TailGet();
+}
+
+static const clap_plugin_tail_t kTailExtension = {
+    ClapTailGet,
+};
+
 }  // namespace
 
 DelayClap::DelayClap(const clap_host_t* host)
     : host_(host),
       sample_rate_(44100.0),
-      is_processing_(false) {
+      is_processing_(false),
+      channel_layout_(stinky_dsp::kStereoLayout) {
   plugin_.desc = nullptr;
   plugin_.plugin_data = this;
   plugin_.init = ClapInit;
@@ -205,8 +257,17 @@ bool DelayClap::Init() noexcept {
 bool DelayClap::Activate(double sample_rate, uint32_t /*min_frames*/,
                           uint32_t /*max_frames*/) noexcept {
   sample_rate_ = sample_rate;
-  processor_.Initialize(sample_rate);
+  // Sync stored parameter values first, so Initialize starts from them
+  // without a smoothing ramp
   UpdateProcessorParams();
+  processor_.Initialize(
+      sample_rate,
+      stinky_dsp::kChannelLayouts[channel_layout_].channel_count);
+  silence_.SetTail(processor_.GetTailFrames());
+  silence_.Reset();
+  constant_.Reset();
+  process_stats_.SetSampleRate(sample_rate);
+  process_stats_.Reset();
   return true;
 }
 
@@ -225,53 +286,75 @@ void DelayClap::StopProcessing() noexcept {
 
 void DelayClap::Reset() noexcept {
   processor_.Reset();
+  silence_.Reset();
+  constant_.Reset();
+}
+
+template <typename T>
+clap_process_status DelayClap::ProcessAudio(const clap_process_t* process,
+                                            const T* const* inputs,
+                                            T* const* outputs) noexcept {
+  stinky_dsp::BlockOptions options;
+  options.layout_channels =
+      stinky_dsp::kChannelLayouts[channel_layout_].channel_count;
+  options.may_settle = !processor_.IsRamping();
+  return stinky_dsp::ProcessBlock(
+      process, inputs, outputs, options, silence_, constant_,
+      [this](const clap_event_header_t* header) {
+        return ApplyEvent(header);
+      },
+      [this] { UpdateProcessorParams(); },
+      [this](const T* const* in, T* const* out, uint32_t num_channels,
+             uint32_t /*frame*/, uint32_t frames) {
+        processor_.ProcessChannels<T>(in, out, num_channels, frames);
+      });
 }
 
 clap_process_status DelayClap::Process(const clap_process_t* process) noexcept {
-  if (process->in_events) {
-    ProcessParameterChanges(process->in_events);
-  }
-
+  stinky_dsp::ProcessStats::Scope stats_scope(process_stats_,
+                                              process->frames_count);
   const uint32_t frame_count = process->frames_count;
   const uint32_t input_count = process->audio_inputs_count;
   const uint32_t output_count = process->audio_outputs_count;
 
   if (input_count == 0 || output_count == 0 || frame_count == 0) {
+    if (process->in_events) {
+      ProcessParameterChanges(process->in_events);
+    }
     return CLAP_PROCESS_SLEEP;
   }
 
-  const uint32_t in_channels = process->audio_inputs[0].channel_count;
-  const uint32_t out_channels = process->audio_outputs[0].channel_count;
-  
-  float* in_left = process->audio_inputs[0].data32[0];
-  float* in_right = (in_channels > 1) ? process->audio_inputs[0].data32[1] : nullptr;
-  float* out_left = process->audio_outputs[0].data32[0];
-  float* out_right = (out_channels > 1) ? process->audio_outputs[0].data32[1] : nullptr;
-
-  std::memcpy(out_left, in_left, frame_count * sizeof(float));
-  if (in_right && out_right) {
-    std::memcpy(out_right, in_right, frame_count * sizeof(float));
+  // The ports take either sample size; the host picks one per block
+  const clap_audio_buffer_t& input = process->audio_inputs[0];
+  const clap_audio_buffer_t& output = process->audio_outputs[0];
+  if (input.data32 && output.data32) {
+    return ProcessAudio(process, input.data32, output.data32);
   }
-
-  if (out_right) {
-    processor_.ProcessStereo(out_left, out_right, frame_count);
-  } else {
-    processor_.ProcessStereo(out_left, out_left, frame_count);
+  if (input.data64 && output.data64) {
+    return ProcessAudio(process, input.data64, output.data64);
   }
-
-  return CLAP_PROCESS_CONTINUE;
+  return CLAP_PROCESS_ERROR;
 }
 
 const void* DelayClap::GetExtension(const char* id) noexcept {
   if (std::strcmp(id, CLAP_EXT_AUDIO_PORTS) == 0) {
     return &kAudioPortsExtension;
   }
+  if (std::strcmp(id, CLAP_EXT_AUDIO_PORTS_CONFIG) == 0) {
+    return &kAudioPortsConfigExtension;
+  }
   if (std::strcmp(id, CLAP_EXT_PARAMS) == 0) {
     return &kParamsExtension;
   }
   if (std::strcmp(id, CLAP_EXT_STATE) == 0) {
     return &kStateExtension;
   }
+  if (std::strcmp(id, CLAP_EXT_TAIL) == 0) {
+    return &kTailExtension;
+  }
+  if (std::strcmp(id, STINKY_EXT_PROCESS_STATS) == 0) {
+    return stinky_dsp::ProcessStatsExtension<DelayClap>();
+  }
   return nullptr;
 }
 
@@ -389,29 +472,33 @@ bool DelayClap::StateLoad(const clap_istream_t* stream) noexcept {
   return true;
 }
 
-void DelayClap::ProcessParameterChanges(const clap_input_events_t* events) noexcept {
+void DelayClap::ProcessParameterChanges(
+    const clap_input_events_t* events) noexcept {
   const uint32_t event_count = events->size(events);
 
   for (uint32_t i = 0; i < event_count; ++i) {
-    const clap_event_header_t* header = events->get(events, i);
-
-    if (header->space_id != CLAP_CORE_EVENT_SPACE_ID) continue;
-
-    if (header->type == CLAP_EVENT_PARAM_VALUE) {
-      auto* param_event = reinterpret_cast<const clap_event_param_value_t*>(header);
-      SetParamValue(param_event->param_id, param_event->value);
-    }
+    ApplyEvent(events->get(events, i));
   }
 
   UpdateProcessorParams();
 }
 
+bool DelayClap::ApplyEvent(const clap_event_header_t* header) noexcept {
+  if (header->space_id != CLAP_CORE_EVENT_SPACE_ID) return false;
+  if (header->type != CLAP_EVENT_PARAM_VALUE) return false;
+
+  auto* param_event = reinterpret_cast<const clap_event_param_value_t*>(header);
+  SetParamValue(param_event->param_id, param_event->value);
+  return true;
+}
+
 void DelayClap::UpdateProcessorParams() noexcept {
   DelayParams params;
   params.delay_time_ms = static_cast<float>(NormalizedToDelayTime(param_values_[kParamIdDelayTime].load()));
   params.mix = static_cast<float>(NormalizedToMix(param_values_[kParamIdMix].load()));
   
   processor_.SetParams(params);
+  silence_.SetTail(processor_.GetTailFrames());
 }
 
 void DelayClap::SetParamValue(clap_id param_id, double value) noexcept {
@@ -430,14 +517,31 @@ bool DelayClap::AudioPortsGet(uint32_t index, bool is_input,
 
   info->id = 0;
   std::snprintf(info->name, sizeof(info->name), is_input ? "Audio Input" : "Audio Output");
-  info->channel_count = 2;
-  info->flags = CLAP_AUDIO_PORT_IS_MAIN;
-  info->port_type = CLAP_PORT_STEREO;
+  info->channel_count =
+      stinky_dsp::kChannelLayouts[channel_layout_].channel_count;
+  info->flags = kMainPortFlags;
+  info->port_type = stinky_dsp::kChannelLayouts[channel_layout_].port_type;
   info->in_place_pair = is_input ? 0 : 0;
 
   return true;
 }
 
+uint32_t DelayClap::AudioPortsConfigCount() const noexcept {
+  return stinky_dsp::kChannelLayoutCount;
+}
+
+bool DelayClap::AudioPortsConfigGet(
+    uint32_t index, clap_audio_ports_config_t* config) const noexcept {
+  return stinky_dsp::GetChannelLayoutConfig(index, AudioPortsCount(true),
+                                            config);
+}
+
+bool DelayClap::AudioPortsConfigSelect(clap_id config_id) noexcept {
+  if (config_id >= stinky_dsp::kChannelLayoutCount) return false;
+  channel_layout_ = config_id;
+  return true;
+}
+
 }  // namespace stinky_delay
 
 // CLAP plugin factory
@@ -496,7 +600,10 @@ static const void* ClapGetFactory(const char* factory_id) {
 
 CLAP_EXPORT const clap_plugin_entry_t clap_entry = {
     CLAP_VERSION,
-    [](const char* /*plugin_path*/) { return true; },
+    [](const char* /*plugin_path*/) {
+      stinky_dsp::simd::Initialize();
+      return true;
+    },
     []() {},
     ClapGetFactory,
 };
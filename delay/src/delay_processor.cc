@@ -9,35 +9,44 @@
 
 namespace stinky_delay {
 
+namespace {
+
+// Parameter ramp length; long enough to remove zipper noise on sweeps
+constexpr double kSmoothingMs = 20.0;
+
+}  // namespace
+
 DelayProcessor::DelayProcessor()
     : sample_rate_(44100.0),
-      write_pos_(0),
       max_delay_samples_(0),
-      delay_samples_left_(0),
-      delay_samples_right_(0),
+      delay_samples_(0),
       initialized_(false) {}
 
-void DelayProcessor::Initialize(double sample_rate) {
+void DelayProcessor::Initialize(double sample_rate, uint32_t num_channels) {
   sample_rate_ = sample_rate;
   
   // Allocate for maximum delay time (2 seconds + stereo offset)
   max_delay_samples_ = static_cast<uint32_t>(sample_rate * 2.5);
   
-  delay_buffer_left_.resize(max_delay_samples_, 0.0f);
-  delay_buffer_right_.resize(max_delay_samples_, 0.0f);
-  
-  write_pos_ = 0;
+  delay_lines_.resize(num_channels);
+  for (auto& line : delay_lines_) {
+    line.Allocate(max_delay_samples_ + kMaxBlockSize);
+  }
   initialized_ = true;
   
   UpdateDelayTimes();
+
+  mix_.Configure(stinky_dsp::SmoothingType::kLinear, sample_rate,
+                 kSmoothingMs);
+  mix_.Reset(params_.mix);
 }
 
 void DelayProcessor::Reset() {
   if (!initialized_) return;
   
-  std::fill(delay_buffer_left_.begin(), delay_buffer_left_.end(), 0.0f);
-  std::fill(delay_buffer_right_.begin(), delay_buffer_right_.end(), 0.0f);
-  write_pos_ = 0;
+  for (auto& line : delay_lines_) {
+    line.Clear();
+  }
 }
 
 void DelayProcessor::SetParams(const DelayParams& params) {
@@ -48,12 +57,13 @@ void DelayProcessor::SetParams(const DelayParams& params) {
   params_.mix = std::clamp(params_.mix, 0.0f, 1.0f);
   
   UpdateDelayTimes();
+  mix_.SetTarget(params_.mix);
 }
 
 void DelayProcessor::UpdateDelayTimes() {
   if (!initialized_) return;
   
-  // Calculate delay samples (same for both channels)
+  // Calculate delay samples (same for every channel)
   uint32_t delay_samples = static_cast<uint32_t>(
       (params_.delay_time_ms / 1000.0f) * sample_rate_);
   
@@ -63,35 +73,80 @@ void DelayProcessor::UpdateDelayTimes() {
   // Minimum delay of 1 sample
   delay_samples = std::max(1u, delay_samples);
   
-  delay_samples_left_ = delay_samples;
-  delay_samples_right_ = delay_samples;
+  delay_samples_ = delay_samples;
 }
 
 void DelayProcessor::ProcessStereo(float* left, float* right, uint32_t frames) {
-  if (!initialized_) return;
-  
-  const float dry_gain = 1.0f - params_.mix;
-  const float wet_gain = params_.mix;
+  ProcessStereo(left, right, left, right, frames);
+}
+
+template <typename T>
+void DelayProcessor::ProcessStereo(const T* in_left, const T* in_right,
+                                   T* out_left, T* out_right,
+                                   uint32_t frames) {
+  const T* inputs[] = {in_left, in_right};
+  T* outputs[] = {out_left, out_right};
+  ProcessChannels(inputs, outputs, out_left == out_right ? 1 : 2, frames);
+}
+
+template <typename T>
+void DelayProcessor::ProcessChannels(const T* const* inputs,
+                                     T* const* outputs, uint32_t num_channels,
+                                     uint32_t frames) {
+  if (!initialized_) {
+    // Pass through
+    for (uint32_t channel = 0; channel < num_channels; ++channel) {
+      if (outputs[channel] != inputs[channel]) {
+        std::memcpy(outputs[channel], inputs[channel], frames * sizeof(T));
+      }
+    }
+    return;
+  }
   
-  for (uint32_t i = 0; i < frames; ++i) {
-    // Calculate read positions
-    uint32_t read_pos = (write_pos_ + max_delay_samples_ - delay_samples_left_) % max_delay_samples_;
-    
-    // Read delayed samples
-    float delayed_left = delay_buffer_left_[read_pos];
-    float delayed_right = delay_buffer_right_[read_pos];
-    
-    // Write input to delay buffer (no feedback)
-    delay_buffer_left_[write_pos_] = left[i];
-    delay_buffer_right_[write_pos_] = right[i];
-    
-    // Mix dry and wet signals
-    left[i] = left[i] * dry_gain + delayed_left * wet_gain;
-    right[i] = right[i] * dry_gain + delayed_right * wet_gain;
-    
-    // Advance write position
-    write_pos_ = (write_pos_ + 1) % max_delay_samples_;
+  for (uint32_t offset = 0; offset < frames;) {
+    const uint32_t block_frames = std::min(kMaxBlockSize, frames - offset);
+    // Per-sample wet gains only while the mix ramps
+    const bool ramping = mix_.IsSmoothing();
+    if (ramping) {
+      mix_.Process(wet_gain_, block_frames);
+    }
+
+    for (uint32_t channel = 0; channel < num_channels; ++channel) {
+      const T* in = inputs[channel] + offset;
+      T* out = outputs[channel] + offset;
+
+      // Write the input, then read the delayed chunk (no feedback). Delays
+      // shorter than the chunk read back frames written just now.
+      delay_lines_[channel].Write(in, block_frames);
+      delay_lines_[channel].Read(wet_, delay_samples_, block_frames);
+
+      // Mix dry and wet signals
+      if (ramping) {
+        for (uint32_t i = 0; i < block_frames; ++i) {
+          const float wet_gain = wet_gain_[i];
+          out[i] = in[i] * (1.0f - wet_gain) + wet_[i] * wet_gain;
+        }
+      } else {
+        const float wet_gain = mix_.Current();
+        const float dry_gain = 1.0f - wet_gain;
+        for (uint32_t i = 0; i < block_frames; ++i) {
+          out[i] = in[i] * dry_gain + wet_[i] * wet_gain;
+        }
+      }
+    }
+    offset += block_frames;
   }
 }
 
+template void DelayProcessor::ProcessStereo(const float*, const float*,
+                                            float*, float*, uint32_t);
+template void DelayProcessor::ProcessStereo(const double*, const double*,
+                                            double*, double*, uint32_t);
+template void DelayProcessor::ProcessChannels(const float* const*,
+                                              float* const*, uint32_t,
+                                              uint32_t);
+template void DelayProcessor::ProcessChannels(const double* const*,
+                                              double* const*, uint32_t,
+                                              uint32_t);
+
 }  // namespace stinky_delay
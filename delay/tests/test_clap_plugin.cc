@@ -2,16 +2,24 @@
 // Basic CLAP plugin tests for Delay
 
 #include "delay_clap.h"
+#include "allocation_guard.h"
+#include "param_event_list.h"
+#include "process_stats_extension.h"
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <memory>
+#include <vector>
 
 using namespace stinky_delay;
 
 namespace {
 
+using stinky_dsp::ParamEventList;
+
 // Mock CLAP host
 struct MockHost {
   clap_host_t host;
@@ -103,9 +111,494 @@ TEST_F(ClapDelayPluginTest, GetExtensionReturnsValidPointers) {
   EXPECT_NE(plugin_->GetExtension(CLAP_EXT_PARAMS), nullptr);
   EXPECT_NE(plugin_->GetExtension(CLAP_EXT_STATE), nullptr);
   EXPECT_NE(plugin_->GetExtension(CLAP_EXT_AUDIO_PORTS), nullptr);
+  EXPECT_NE(plugin_->GetExtension(STINKY_EXT_PROCESS_STATS), nullptr);
+  EXPECT_NE(plugin_->GetExtension(CLAP_EXT_TAIL), nullptr);
   EXPECT_EQ(plugin_->GetExtension("invalid.extension"), nullptr);
 }
 
+TEST_F(ClapDelayPluginTest, SilentInputSleepsOnceTailHasPassed) {
+  ASSERT_TRUE(plugin_->Init());
+  ASSERT_TRUE(plugin_->Activate(48000.0, 64, 512));
+  ASSERT_TRUE(plugin_->StartProcessing());
+
+  auto* tail = static_cast<const clap_plugin_tail_t*>(
+      plugin_->GetExtension(CLAP_EXT_TAIL));
+  ASSERT_NE(tail, nullptr);
+  const uint32_t tail_frames = tail->get(plugin_->ClapPlugin());
+  EXPECT_EQ(tail_frames, 120000u);  // The whole 2.5 s buffer
+
+  constexpr uint32_t frame_count = 512;
+  std::vector<float> in_left(frame_count, 0.0f);
+  std::vector<float> in_right(frame_count, 0.0f);
+  std::vector<float> out_left(frame_count, 1.0f);
+  std::vector<float> out_right(frame_count, 1.0f);
+  float* in_ptrs[] = {in_left.data(), in_right.data()};
+  float* out_ptrs[] = {out_left.data(), out_right.data()};
+  clap_audio_buffer_t input = {in_ptrs, nullptr, 2, 0, 0};
+  clap_audio_buffer_t output = {out_ptrs, nullptr, 2, 0, 0};
+
+  clap_process_t process = {};
+  process.frames_count = frame_count;
+  process.audio_inputs = &input;
+  process.audio_inputs_count = 1;
+  process.audio_outputs = &output;
+  process.audio_outputs_count = 1;
+
+  // Silence keeps processing until it has filled the delay buffer
+  uint64_t processed = 0;
+  while (plugin_->Process(&process) == CLAP_PROCESS_CONTINUE) {
+    processed += frame_count;
+    ASSERT_LT(processed, tail_frames) << "never went to sleep";
+  }
+  EXPECT_GE(processed + frame_count, tail_frames);
+
+  // Past the tail the block is skipped and cleared
+  std::fill(out_left.begin(), out_left.end(), 1.0f);
+  std::fill(out_right.begin(), out_right.end(), 1.0f);
+  EXPECT_EQ(plugin_->Process(&process), CLAP_PROCESS_SLEEP);
+  for (uint32_t i = 0; i < frame_count; ++i) {
+    ASSERT_EQ(out_left[i], 0.0f);
+    ASSERT_EQ(out_right[i], 0.0f);
+  }
+  EXPECT_EQ(output.constant_mask, 0b11u);
+
+  // Input wakes it up
+  in_left[0] = 0.5f;
+  EXPECT_EQ(plugin_->Process(&process), CLAP_PROCESS_CONTINUE);
+  EXPECT_EQ(output.constant_mask, 0u);
+}
+
+TEST_F(ClapDelayPluginTest, InPlaceMatchesSeparateBuffers) {
+  ASSERT_TRUE(plugin_->Init());
+  auto in_place = std::make_unique<DelayClap>(&mock_host_->host);
+  ASSERT_TRUE(in_place->Init());
+  for (auto* plugin : {plugin_.get(), in_place.get()}) {
+    ASSERT_TRUE(plugin->Activate(48000.0, 64, 512));
+    ASSERT_TRUE(plugin->StartProcessing());
+  }
+
+  constexpr uint32_t frame_count = 512;
+  std::vector<float> in_left(frame_count);
+  std::vector<float> in_right(frame_count);
+  std::vector<float> out_left(frame_count);
+  std::vector<float> out_right(frame_count);
+  std::vector<float> io_left(frame_count);
+  std::vector<float> io_right(frame_count);
+  float* in_ptrs[] = {in_left.data(), in_right.data()};
+  float* out_ptrs[] = {out_left.data(), out_right.data()};
+  float* io_ptrs[] = {io_left.data(), io_right.data()};
+  clap_audio_buffer_t input = {in_ptrs, nullptr, 2, 0, 0};
+  clap_audio_buffer_t output = {out_ptrs, nullptr, 2, 0, 0};
+  clap_audio_buffer_t io = {io_ptrs, nullptr, 2, 0, 0};
+
+  clap_process_t separate = {};
+  separate.frames_count = frame_count;
+  separate.audio_inputs = &input;
+  separate.audio_inputs_count = 1;
+  separate.audio_outputs = &output;
+  separate.audio_outputs_count = 1;
+
+  // The host hands the same buffer in and out
+  clap_process_t shared = separate;
+  shared.audio_inputs = &io;
+  shared.audio_outputs = &io;
+
+  for (uint32_t block = 0; block < 8; ++block) {
+    for (uint32_t i = 0; i < frame_count; ++i) {
+      const float t = static_cast<float>(block * frame_count + i);
+      in_left[i] = io_left[i] = 0.9f * std::sin(0.01f * t);
+      in_right[i] = io_right[i] = 0.6f * std::sin(0.023f * t);
+    }
+
+    ASSERT_EQ(plugin_->Process(&separate), CLAP_PROCESS_CONTINUE);
+    ASSERT_EQ(in_place->Process(&shared), CLAP_PROCESS_CONTINUE);
+    ASSERT_EQ(io_left, out_left) << "block " << block;
+    ASSERT_EQ(io_right, out_right) << "block " << block;
+  }
+}
+
+TEST_F(ClapDelayPluginTest, DoubleBuffersMatchFloat) {
+  ASSERT_TRUE(plugin_->Init());
+  auto wide = std::make_unique<DelayClap>(&mock_host_->host);
+  ASSERT_TRUE(wide->Init());
+  for (auto* plugin : {plugin_.get(), wide.get()}) {
+    ASSERT_TRUE(plugin->Activate(48000.0, 64, 512));
+    ASSERT_TRUE(plugin->StartProcessing());
+  }
+
+  clap_audio_port_info_t info;
+  ASSERT_TRUE(wide->AudioPortsGet(0, true, &info));
+  EXPECT_TRUE(info.flags & CLAP_AUDIO_PORT_SUPPORTS_64BITS);
+  ASSERT_TRUE(wide->AudioPortsGet(0, false, &info));
+  EXPECT_TRUE(info.flags & CLAP_AUDIO_PORT_SUPPORTS_64BITS);
+
+  constexpr uint32_t frame_count = 512;
+  std::vector<float> left(frame_count);
+  std::vector<float> right(frame_count);
+  std::vector<double> wide_left(frame_count);
+  std::vector<double> wide_right(frame_count);
+  float* ptrs[] = {left.data(), right.data()};
+  double* wide_ptrs[] = {wide_left.data(), wide_right.data()};
+  clap_audio_buffer_t io = {ptrs, nullptr, 2, 0, 0};
+  clap_audio_buffer_t wide_io = {nullptr, wide_ptrs, 2, 0, 0};
+
+  clap_process_t process = {};
+  process.frames_count = frame_count;
+  process.audio_inputs = &io;
+  process.audio_inputs_count = 1;
+  process.audio_outputs = &io;
+  process.audio_outputs_count = 1;
+
+  clap_process_t wide_process = process;
+  wide_process.audio_inputs = &wide_io;
+  wide_process.audio_outputs = &wide_io;
+
+  for (uint32_t block = 0; block < 8; ++block) {
+    for (uint32_t i = 0; i < frame_count; ++i) {
+      const float t = static_cast<float>(block * frame_count + i);
+      left[i] = 0.9f * std::sin(0.01f * t);
+      right[i] = 0.6f * std::sin(0.023f * t);
+      wide_left[i] = left[i];
+      wide_right[i] = right[i];
+    }
+
+    ASSERT_EQ(plugin_->Process(&process), CLAP_PROCESS_CONTINUE);
+    ASSERT_EQ(wide->Process(&wide_process), CLAP_PROCESS_CONTINUE);
+    for (uint32_t i = 0; i < frame_count; ++i) {
+      ASSERT_NEAR(wide_left[i], left[i], 1e-4) << "block " << block;
+      ASSERT_NEAR(wide_right[i], right[i], 1e-4) << "block " << block;
+    }
+  }
+
+  // Input and output must share a sample size
+  process.audio_outputs = &wide_io;
+  EXPECT_EQ(plugin_->Process(&process), CLAP_PROCESS_ERROR);
+}
+
+TEST_F(ClapDelayPluginTest, SurroundLayoutMatchesStereoPerChannel) {
+  ASSERT_TRUE(plugin_->Init());
+  auto* config = static_cast<const clap_plugin_audio_ports_config_t*>(
+      plugin_->GetExtension(CLAP_EXT_AUDIO_PORTS_CONFIG));
+  ASSERT_NE(config, nullptr);
+  const clap_plugin_t* clap_plugin = plugin_->ClapPlugin();
+  EXPECT_EQ(config->count(clap_plugin), stinky_dsp::kChannelLayoutCount);
+
+  clap_audio_ports_config_t layout;
+  EXPECT_FALSE(config->get(clap_plugin, stinky_dsp::kChannelLayoutCount,
+                           &layout));
+  ASSERT_TRUE(config->get(clap_plugin, 2, &layout));
+  EXPECT_EQ(layout.input_port_count, plugin_->AudioPortsCount(true));
+  EXPECT_EQ(layout.main_input_channel_count, 6u);
+  EXPECT_STREQ(layout.main_output_port_type, CLAP_PORT_SURROUND);
+  EXPECT_FALSE(config->select(clap_plugin, stinky_dsp::kChannelLayoutCount));
+  ASSERT_TRUE(config->select(clap_plugin, layout.id));
+
+  clap_audio_port_info_t port;
+  ASSERT_TRUE(plugin_->AudioPortsGet(0, false, &port));
+  EXPECT_EQ(port.channel_count, 6u);
+  EXPECT_STREQ(port.port_type, CLAP_PORT_SURROUND);
+
+  auto stereo = std::make_unique<DelayClap>(&mock_host_->host);
+  ASSERT_TRUE(stereo->Init());
+  for (auto* plugin : {plugin_.get(), stereo.get()}) {
+    ASSERT_TRUE(plugin->Activate(48000.0, 64, 512));
+    ASSERT_TRUE(plugin->StartProcessing());
+  }
+
+  constexpr uint32_t kChannels = 6;
+  constexpr uint32_t frame_count = 512;
+  std::vector<std::vector<float>> surround(kChannels,
+                                           std::vector<float>(frame_count));
+  std::vector<float> left(frame_count);
+  std::vector<float> right(frame_count);
+  float* surround_ptrs[kChannels];
+  for (uint32_t c = 0; c < kChannels; ++c) {
+    surround_ptrs[c] = surround[c].data();
+  }
+  float* stereo_ptrs[] = {left.data(), right.data()};
+  clap_audio_buffer_t surround_io = {surround_ptrs, nullptr, kChannels, 0, 0};
+  clap_audio_buffer_t stereo_io = {stereo_ptrs, nullptr, 2, 0, 0};
+
+  clap_process_t process = {};
+  process.frames_count = frame_count;
+  process.audio_inputs = &surround_io;
+  process.audio_inputs_count = 1;
+  process.audio_outputs = &surround_io;
+  process.audio_outputs_count = 1;
+
+  clap_process_t stereo_process = process;
+  stereo_process.audio_inputs = &stereo_io;
+  stereo_process.audio_outputs = &stereo_io;
+
+  // Channels 0 and 5 through a stereo instance give the same output.
+  // Channel 0 is the loudest, so linked detectors see the same peak.
+  for (uint32_t block = 0; block < 8; ++block) {
+    for (uint32_t i = 0; i < frame_count; ++i) {
+      const float t = static_cast<float>(block * frame_count + i);
+      const float signal = 0.9f * std::sin(0.01f * t);
+      for (uint32_t c = 0; c < kChannels; ++c) {
+        surround[c][i] = signal * (1.0f - 0.15f * static_cast<float>(c));
+      }
+      left[i] = surround[0][i];
+      right[i] = surround[5][i];
+    }
+
+    ASSERT_EQ(plugin_->Process(&process), CLAP_PROCESS_CONTINUE);
+    ASSERT_EQ(stereo->Process(&stereo_process), CLAP_PROCESS_CONTINUE);
+    ASSERT_EQ(surround[0], left) << "block " << block;
+    ASSERT_EQ(surround[5], right) << "block " << block;
+  }
+}
+
+TEST_F(ClapDelayPluginTest, MonoLayoutMatchesStereoWithBothSidesEqual) {
+  ASSERT_TRUE(plugin_->Init());
+  auto* config = static_cast<const clap_plugin_audio_ports_config_t*>(
+      plugin_->GetExtension(CLAP_EXT_AUDIO_PORTS_CONFIG));
+  ASSERT_NE(config, nullptr);
+  ASSERT_TRUE(config->select(plugin_->ClapPlugin(), 0));
+
+  clap_audio_port_info_t port;
+  ASSERT_TRUE(plugin_->AudioPortsGet(0, true, &port));
+  EXPECT_EQ(port.channel_count, 1u);
+  EXPECT_STREQ(port.port_type, CLAP_PORT_MONO);
+
+  auto stereo = std::make_unique<DelayClap>(&mock_host_->host);
+  ASSERT_TRUE(stereo->Init());
+  for (auto* plugin : {plugin_.get(), stereo.get()}) {
+    ASSERT_TRUE(plugin->Activate(48000.0, 64, 512));
+    ASSERT_TRUE(plugin->StartProcessing());
+  }
+
+  constexpr uint32_t frame_count = 512;
+  std::vector<float> mono(frame_count);
+  std::vector<float> left(frame_count);
+  std::vector<float> right(frame_count);
+  float* mono_ptrs[] = {mono.data()};
+  float* stereo_ptrs[] = {left.data(), right.data()};
+  clap_audio_buffer_t mono_io = {mono_ptrs, nullptr, 1, 0, 0};
+  clap_audio_buffer_t stereo_io = {stereo_ptrs, nullptr, 2, 0, 0};
+
+  clap_process_t process = {};
+  process.frames_count = frame_count;
+  process.audio_inputs = &mono_io;
+  process.audio_inputs_count = 1;
+  process.audio_outputs = &mono_io;
+  process.audio_outputs_count = 1;
+
+  clap_process_t stereo_process = process;
+  stereo_process.audio_inputs = &stereo_io;
+  stereo_process.audio_outputs = &stereo_io;
+
+  // The one channel is processed once, like either side of a stereo pair
+  for (uint32_t block = 0; block < 8; ++block) {
+    for (uint32_t i = 0; i < frame_count; ++i) {
+      const float t = static_cast<float>(block * frame_count + i);
+      mono[i] = left[i] = right[i] = 0.9f * std::sin(0.01f * t);
+    }
+
+    ASSERT_EQ(plugin_->Process(&process), CLAP_PROCESS_CONTINUE);
+    ASSERT_EQ(stereo->Process(&stereo_process), CLAP_PROCESS_CONTINUE);
+    ASSERT_EQ(mono, left) << "block " << block;
+  }
+}
+
+TEST_F(ClapDelayPluginTest, SettledConstantInputGivesConstantOutput) {
+  ASSERT_TRUE(plugin_->Init());
+  ASSERT_TRUE(plugin_->Activate(48000.0, 64, 512));
+  ASSERT_TRUE(plugin_->StartProcessing());
+
+  auto* tail = static_cast<const clap_plugin_tail_t*>(
+      plugin_->GetExtension(CLAP_EXT_TAIL));
+  ASSERT_NE(tail, nullptr);
+  const uint32_t tail_frames = tail->get(plugin_->ClapPlugin());
+
+  constexpr uint32_t frame_count = 512;
+  std::vector<float> in_left(frame_count, 0.5f);
+  std::vector<float> in_right(frame_count, 0.5f);
+  std::vector<float> out_left(frame_count, 0.0f);
+  std::vector<float> out_right(frame_count, 0.0f);
+  float* in_ptrs[] = {in_left.data(), in_right.data()};
+  float* out_ptrs[] = {out_left.data(), out_right.data()};
+  clap_audio_buffer_t input = {in_ptrs, nullptr, 2, 0, 0b11};
+  clap_audio_buffer_t output = {out_ptrs, nullptr, 2, 0, 0};
+
+  clap_process_t process = {};
+  process.frames_count = frame_count;
+  process.audio_inputs = &input;
+  process.audio_inputs_count = 1;
+  process.audio_outputs = &output;
+  process.audio_outputs_count = 1;
+
+  // Runs the DSP until the constant has outlasted the tail and the output
+  // stopped changing
+  uint64_t processed = 0;
+  while (true) {
+    EXPECT_EQ(plugin_->Process(&process), CLAP_PROCESS_CONTINUE);
+    if (output.constant_mask == 0b11u) break;
+    processed += frame_count;
+    ASSERT_LT(processed, tail_frames + 96000u) << "never settled";
+  }
+  EXPECT_GE(processed, tail_frames);
+
+  const float steady_value = out_left[0];
+  for (uint32_t i = 0; i < frame_count; ++i) {
+    ASSERT_EQ(out_left[i], steady_value);
+    ASSERT_EQ(out_right[i], steady_value);
+  }
+
+  // The full DSP agrees with the shortcut
+  input.constant_mask = 0;
+  EXPECT_EQ(plugin_->Process(&process), CLAP_PROCESS_CONTINUE);
+  EXPECT_EQ(output.constant_mask, 0u);
+  for (uint32_t i = 0; i < frame_count; ++i) {
+    ASSERT_NEAR(out_left[i], steady_value, 1e-6f);
+    ASSERT_NEAR(out_right[i], steady_value, 1e-6f);
+  }
+}
+
+TEST_F(ClapDelayPluginTest, ProcessDoesNotAllocate) {
+  // Everything allowed to allocate happens before the guard
+  ASSERT_TRUE(plugin_->Init());
+  ASSERT_TRUE(plugin_->Activate(48000.0, 64, 512));
+  ASSERT_TRUE(plugin_->StartProcessing());
+  const auto* stats = static_cast<const stinky_plugin_process_stats_t*>(
+      plugin_->GetExtension(STINKY_EXT_PROCESS_STATS));
+  ASSERT_NE(stats, nullptr);
+  stats->set_enabled(plugin_->ClapPlugin(), true);
+
+  constexpr uint32_t frame_count = 512;
+  std::vector<float> left(frame_count);
+  std::vector<float> right(frame_count);
+  std::vector<double> left64(frame_count);
+  std::vector<double> right64(frame_count);
+  float* ptrs[] = {left.data(), right.data()};
+  double* ptrs64[] = {left64.data(), right64.data()};
+  clap_audio_buffer_t io = {ptrs, nullptr, 2, 0, 0};
+  clap_audio_buffer_t io64 = {nullptr, ptrs64, 2, 0, 0};
+
+  ParamEventList events;
+  events.Add(0, kParamIdDelayTime, 0.25);
+  events.Add(200, kParamIdMix, 0.5);
+  ParamEventList flush;
+  flush.Add(0, kParamIdDelayTime, 0.01);
+
+  clap_process_t process = {};
+  process.frames_count = frame_count;
+  process.audio_inputs_count = 1;
+  process.audio_outputs_count = 1;
+  process.in_events = events.Events();
+
+  // Signal blocks at both sample sizes, then silence, with a flush and a
+  // reset in between
+  constexpr uint32_t kBlocks = 16;
+  clap_process_status statuses[kBlocks];
+  uint64_t allocations;
+  uint64_t frees;
+  {
+    stinky_dsp::AllocationGuard guard;
+    for (uint32_t block = 0; block < kBlocks; ++block) {
+      const float level = block < 6 ? 0.5f : 0.0f;
+      for (uint32_t i = 0; i < frame_count; ++i) {
+        const float t = static_cast<float>(block * frame_count + i);
+        left[i] = level * std::sin(0.05f * t);
+        right[i] = -left[i];
+        left64[i] = left[i];
+        right64[i] = right[i];
+      }
+      clap_audio_buffer_t* buffers = block % 3 == 2 ? &io64 : &io;
+      process.audio_inputs = buffers;
+      process.audio_outputs = buffers;
+      statuses[block] = plugin_->Process(&process);
+
+      if (block == 3) plugin_->ParamsFlush(flush.Events(), nullptr);
+      if (block == 8) plugin_->Reset();
+    }
+    allocations = guard.Allocations();
+    frees = guard.Frees();
+  }
+
+  for (clap_process_status status : statuses) {
+    EXPECT_NE(status, CLAP_PROCESS_ERROR);
+  }
+  EXPECT_EQ(allocations, 0u);
+  EXPECT_EQ(frees, 0u);
+  plugin_->StopProcessing();
+  plugin_->Deactivate();
+}
+
+TEST(DelayProcessorTest, DelaysByWholeSamplesAcrossBlocks) {
+  // Delays shorter and longer than a chunk, with blocks of uneven length so
+  // reads and writes straddle the end of the delay line
+  constexpr uint32_t kBlocks[] = {100, 300, 1, 257, 64};
+  for (float delay_ms : {0.0f, 1.0f, 1000.0f}) {
+    DelayProcessor processor;
+    processor.Initialize(48000.0, 2);
+    DelayParams params;
+    params.delay_time_ms = delay_ms;
+    params.mix = 1.0f;
+    processor.SetParams(params);
+    // 0 ms still delays by one sample
+    const uint32_t delay = std::max(1u, static_cast<uint32_t>(delay_ms * 48));
+
+    // Long enough for the line to wrap several times
+    uint32_t frame = 0;
+    while (frame < 3 * 48000 * 5 / 2) {
+      for (uint32_t frames : kBlocks) {
+        std::vector<float> left(frames);
+        std::vector<float> right(frames);
+        for (uint32_t i = 0; i < frames; ++i) {
+          left[i] = static_cast<float>(frame + i + 1);
+          right[i] = -left[i];
+        }
+        processor.ProcessStereo(left.data(), right.data(), frames);
+        for (uint32_t i = 0; i < frames; ++i) {
+          const uint32_t n = frame + i + 1;
+          const float expected =
+              n > delay ? static_cast<float>(n - delay) : 0.0f;
+          ASSERT_EQ(left[i], expected) << delay_ms << " ms, frame " << n;
+          ASSERT_EQ(right[i], -expected) << delay_ms << " ms, frame " << n;
+        }
+        frame += frames;
+      }
+    }
+  }
+}
+
+TEST(DelayProcessorTest, MixRampsThenHoldsItsTarget) {
+  // The delayed signal stays silent for the first second, so the output is
+  // the dry share of a constant input
+  DelayProcessor processor;
+  processor.Initialize(48000.0, 2);
+  DelayParams params;
+  params.delay_time_ms = 1000.0f;
+  params.mix = 1.0f;
+  processor.SetParams(params);
+  params.mix = 0.25f;
+  processor.SetParams(params);
+
+  // 20 ms ramp
+  constexpr uint32_t kRampFrames = 960;
+  constexpr uint32_t kFrames = 256;
+  float previous = 0.0f;
+  for (uint32_t frame = 0; frame < 4 * kRampFrames; frame += kFrames) {
+    std::vector<float> left(kFrames, 1.0f);
+    std::vector<float> right(kFrames, 1.0f);
+    processor.ProcessStereo(left.data(), right.data(), kFrames);
+    for (uint32_t i = 0; i < kFrames; ++i) {
+      const uint32_t n = frame + i + 1;
+      ASSERT_EQ(left[i], right[i]) << "frame " << n;
+      if (n < kRampFrames) {
+        ASSERT_GE(left[i], previous) << "frame " << n;
+        ASSERT_LT(left[i], 0.75f) << "frame " << n;
+      } else {
+        ASSERT_EQ(left[i], 0.75f) << "frame " << n;
+      }
+      previous = left[i];
+    }
+  }
+  EXPECT_FALSE(processor.IsRamping());
+}
+
 TEST_F(ClapDelayPluginTest, AudioPortsCountReturnsOne) {
   EXPECT_EQ(plugin_->AudioPortsCount(true), 1u);
   EXPECT_EQ(plugin_->AudioPortsCount(false), 1u);
@@ -0,0 +1,131 @@
+// Copyright 2025
+// Stinky DSP - Stereo biquad cascade (channels in SIMD lanes)
+
+#ifndef BIQUAD_CASCADE_H_
+#define BIQUAD_CASCADE_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace stinky_dsp {
+
+// Biquad coefficients normalized by a0
+struct BiquadCoefficients {
+  double b0 = 1.0;
+  double b1 = 0.0;
+  double b2 = 0.0;
+  double a1 = 0.0;
+  double a2 = 0.0;
+};
+
+// Frames for the impulse response of `coefficients` to fall below
+// `attenuation` (e.g. 1e-6 for -120 dB), from the largest pole radius.
+// UINT32_MAX if the filter is unstable or too slow to fit.
+uint32_t BiquadDecayFrames(const BiquadCoefficients& coefficients,
+                           double attenuation);
+
+// Arithmetic precision of one cascade stage
+enum class BiquadPrecision {
+  kDouble,  // Low-frequency / high-Q stages where float TDF-II loses accuracy
+  kFloat,   // Everything else; runs two stages per SIMD register
+};
+
+// Series chain of biquads over a stereo pair, transposed direct form II.
+// Left and right run in SIMD lanes. Double stages use the two lanes of one
+// double register; float stages are paired and software-pipelined across the
+// four float lanes (stage A at frame t next to stage B at frame t - 1), which
+// halves the serial dependency chain. Double stages run before float stages;
+// the stages are linear and time-invariant, so order does not change the
+// response. Coefficients and state are stored structure-of-arrays (per
+// stage, per lane). Disabled stages are dropped from the active lists when
+// they change, so the sample loop never tests them.
+class BiquadCascade {
+ public:
+  static constexpr size_t kMaxStages = 8;
+  static constexpr size_t kLanes = 2;
+
+  BiquadCascade();
+
+  // Sets the same coefficients on both lanes of `stage`. Changing precision
+  // carries the filter state over.
+  void SetStage(size_t stage, const BiquadCoefficients& coefficients,
+                BiquadPrecision precision = BiquadPrecision::kDouble);
+
+  BiquadPrecision StagePrecision(size_t stage) const {
+    return precision_[stage];
+  }
+
+  // Disabled stages keep their state and are skipped until re-enabled.
+  // Stages start disabled.
+  void SetStageEnabled(size_t stage, bool enabled);
+
+  void Reset();
+
+  // Runs every enabled stage, then scales by `output_gain`.
+  // left and right may alias (mono).
+  void Process(float* left, float* right, size_t num_frames,
+               float output_gain);
+
+  // Same as Process, reading the input from `in_left`/`in_right`. The first
+  // pass reads the input, so out-of-place costs no copy. The input may be
+  // the output buffer itself.
+  void Process(const float* in_left, const float* in_right, float* out_left,
+               float* out_right, size_t num_frames, float output_gain);
+
+  // 64-bit buffers. Double stages run on the samples directly; float stages
+  // narrow them on the way in.
+  void Process(const double* in_left, const double* in_right,
+               double* out_left, double* out_right, size_t num_frames,
+               float output_gain);
+
+  // Same as Process for an interleaved L/R buffer
+  void ProcessInterleaved(float* buffer, size_t num_frames, float output_gain);
+
+ private:
+  // Index of an identity stage that pads an odd number of float stages
+  static constexpr size_t kIdentityStage = kMaxStages;
+
+  void RebuildActiveStages();
+
+  template <typename Io>
+  void Run(Io io, size_t num_frames, float output_gain);
+
+  template <typename Io>
+  void RunDoubleStages(Io io, size_t num_frames, float output_gain);
+
+  template <typename Io>
+  void RunFloatPair(Io io, size_t num_frames, size_t stage_a, size_t stage_b,
+                    float output_gain);
+
+  // Double-precision stages
+  alignas(16) double b0_[kMaxStages][kLanes];
+  alignas(16) double b1_[kMaxStages][kLanes];
+  alignas(16) double b2_[kMaxStages][kLanes];
+  alignas(16) double a1_[kMaxStages][kLanes];
+  alignas(16) double a2_[kMaxStages][kLanes];
+  alignas(16) double s1_[kMaxStages][kLanes];
+  alignas(16) double s2_[kMaxStages][kLanes];
+
+  // Single-precision stages, plus the identity padding stage
+  alignas(8) float fb0_[kMaxStages + 1][kLanes];
+  alignas(8) float fb1_[kMaxStages + 1][kLanes];
+  alignas(8) float fb2_[kMaxStages + 1][kLanes];
+  alignas(8) float fa1_[kMaxStages + 1][kLanes];
+  alignas(8) float fa2_[kMaxStages + 1][kLanes];
+  alignas(8) float fs1_[kMaxStages + 1][kLanes];
+  alignas(8) float fs2_[kMaxStages + 1][kLanes];
+
+  std::array<BiquadPrecision, kMaxStages> precision_;
+  std::array<bool, kMaxStages> enabled_;
+
+  // Active stages by precision; float stages are consumed in pairs
+  std::array<uint8_t, kMaxStages> active_double_;
+  std::array<uint8_t, kMaxStages + 1> active_float_;
+  size_t num_active_double_;
+  size_t num_active_float_;  // Always even (padded with kIdentityStage)
+};
+
+}  // namespace stinky_dsp
+
+#endif  // BIQUAD_CASCADE_H_
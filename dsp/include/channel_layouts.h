@@ -0,0 +1,64 @@
+// Copyright 2025
+// Stinky DSP - Channel layouts offered through clap.audio-ports-config
+
+#ifndef CHANNEL_LAYOUTS_H_
+#define CHANNEL_LAYOUTS_H_
+
+#include <clap/clap.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+
+#include "channels.h"
+
+namespace stinky_dsp {
+
+struct ChannelLayout {
+  const char* name;
+  uint32_t channel_count;
+  const char* port_type;
+};
+
+// Main-port layouts every plugin offers. The config id is the index. The
+// DSP treats every channel alike, so surround and ambisonic layouts differ
+// only in their channel count.
+inline constexpr ChannelLayout kChannelLayouts[] = {
+    {"Mono", 1, CLAP_PORT_MONO},
+    {"Stereo", 2, CLAP_PORT_STEREO},
+    {"5.1 Surround", 6, CLAP_PORT_SURROUND},
+    {"7.1.4 Surround", 12, CLAP_PORT_SURROUND},
+    {"Ambisonics 1st Order", 4, CLAP_PORT_AMBISONIC},
+    {"Ambisonics 2nd Order", 9, CLAP_PORT_AMBISONIC},
+    {"Ambisonics 3rd Order", 16, CLAP_PORT_AMBISONIC},
+};
+
+inline constexpr uint32_t kChannelLayoutCount =
+    static_cast<uint32_t>(std::size(kChannelLayouts));
+
+// Layout a plugin starts with
+inline constexpr uint32_t kStereoLayout = 1;
+
+// Describes layout `index` as a config with a main input and output of its
+// width. `input_port_count` includes any extra inputs (a sidechain).
+inline bool GetChannelLayoutConfig(uint32_t index, uint32_t input_port_count,
+                                   clap_audio_ports_config_t* config) {
+  if (index >= kChannelLayoutCount) return false;
+
+  const ChannelLayout& layout = kChannelLayouts[index];
+  config->id = index;
+  std::snprintf(config->name, sizeof(config->name), "%s", layout.name);
+  config->input_port_count = input_port_count;
+  config->output_port_count = 1;
+  config->has_main_input = true;
+  config->main_input_channel_count = layout.channel_count;
+  config->main_input_port_type = layout.port_type;
+  config->has_main_output = true;
+  config->main_output_channel_count = layout.channel_count;
+  config->main_output_port_type = layout.port_type;
+  return true;
+}
+
+}  // namespace stinky_dsp
+
+#endif  // CHANNEL_LAYOUTS_H_
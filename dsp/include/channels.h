@@ -0,0 +1,34 @@
+// Copyright 2025
+// Stinky DSP - Channel pointer sets for N-channel processing
+
+#ifndef CHANNELS_H_
+#define CHANNELS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace stinky_dsp {
+
+// Most channels a processor handles (third-order ambisonics)
+inline constexpr uint32_t kMaxChannels = 16;
+
+// The channel pointers of a block moved `frame` frames in, for processing a
+// sub-block of every channel. Converts to the pointer array it holds.
+template <typename T>
+class ChannelOffsets {
+ public:
+  ChannelOffsets(T* const* channels, uint32_t num_channels, size_t frame) {
+    for (uint32_t channel = 0; channel < num_channels; ++channel) {
+      pointers_[channel] = channels[channel] + frame;
+    }
+  }
+
+  operator T* const*() const { return pointers_; }
+
+ private:
+  T* pointers_[kMaxChannels];
+};
+
+}  // namespace stinky_dsp
+
+#endif  // CHANNELS_H_
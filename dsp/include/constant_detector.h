@@ -0,0 +1,68 @@
+// Copyright 2025
+// Stinky DSP - Constant input tracking for steady-state blocks
+
+#ifndef CONSTANT_DETECTOR_H_
+#define CONSTANT_DETECTOR_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace stinky_dsp {
+
+// Follows the channels a host marks constant (clap_audio_buffer_t's
+// constant_mask: every sample equals the first). A plugin fed the same
+// constant for longer than its tail settles into a steady state, where each
+// output frame repeats the one before. Once a one-frame probe confirms that,
+// the probe's output is the whole block's output and the per-sample DSP can
+// be skipped.
+class ConstantDetector {
+ public:
+  // One bit per channel of a constant_mask
+  static constexpr uint32_t kMaxChannels = 64;
+
+  ConstantDetector();
+
+  // [audio thread] Forgets the input run and the last output
+  void Reset();
+
+  // Mask with a bit set for each of the first `num_channels` channels
+  static uint64_t ChannelMask(uint32_t num_channels);
+
+  // [audio thread] Feeds one block. Returns true if every channel is flagged
+  // constant at the same values as before, and was for at least
+  // `settle_frames` frames before this block. UINT32_MAX never settles.
+  // The channel functions take float or double buffers.
+  template <typename T>
+  bool Update(const T* const* channels, uint32_t num_channels,
+              uint64_t constant_mask, uint32_t num_frames,
+              uint32_t settle_frames);
+
+  // [audio thread] Remembers the last frame of a block's output
+  template <typename T>
+  void SetLastOutput(const T* const* channels, uint32_t num_channels,
+                     size_t num_frames);
+
+  // [audio thread] True if the first frame of `channels` repeats the last
+  // output frame exactly, i.e. the DSP has reached its steady state
+  template <typename T>
+  bool MatchesLastOutput(const T* const* channels,
+                         uint32_t num_channels) const;
+
+  // Copies the first frame of each channel over the rest of the block
+  template <typename T>
+  static void Fill(T* const* channels, uint32_t num_channels,
+                   size_t num_frames);
+
+ private:
+  // Doubles hold either sample type exactly
+  std::array<double, kMaxChannels> input_;
+  std::array<double, kMaxChannels> output_;
+  uint64_t constant_frames_;
+  uint32_t input_channels_;
+  uint32_t output_channels_;
+};
+
+}  // namespace stinky_dsp
+
+#endif  // CONSTANT_DETECTOR_H_
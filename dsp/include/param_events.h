@@ -0,0 +1,48 @@
+// Copyright 2025
+// Stinky DSP - Splitting process blocks at parameter event timestamps
+
+#ifndef PARAM_EVENTS_H_
+#define PARAM_EVENTS_H_
+
+#include <clap/clap.h>
+
+#include <cstdint>
+
+namespace stinky_dsp {
+
+// Parameter events closer together than this are applied together at the
+// earlier one, so automation never splits a block into tiny sub-blocks
+constexpr uint32_t kMinSubBlockFrames = 16;
+
+// [audio thread] Hands the events from `*next_event` that fall before
+// `frame` plus kMinSubBlockFrames to `apply`, one header at a time, and
+// returns the frame where the next sub-block starts. Events stamped past
+// the block (out of spec) go to the last sub-block. `events` may be null.
+//
+// A plugin processes a block as
+//   for (uint32_t frame = 0, next = 0; frame < frame_count;) {
+//     const uint32_t end = ApplyDueEvents(events, &next, frame, frame_count,
+//                                         apply);
+//     ... process frames [frame, end) ...
+//     frame = end;
+//   }
+template <typename Apply>
+uint32_t ApplyDueEvents(const clap_input_events_t* events,
+                        uint32_t* next_event, uint32_t frame,
+                        uint32_t frame_count, Apply&& apply) {
+  if (!events) return frame_count;
+  const uint32_t event_count = events->size(events);
+  for (; *next_event < event_count; ++*next_event) {
+    const clap_event_header_t* header = events->get(events, *next_event);
+    if (header->time >= frame + kMinSubBlockFrames &&
+        header->time < frame_count) {
+      return header->time;
+    }
+    apply(header);
+  }
+  return frame_count;
+}
+
+}  // namespace stinky_dsp
+
+#endif  // PARAM_EVENTS_H_
@@ -0,0 +1,153 @@
+// Copyright 2025
+// Stinky DSP - The main-port block loop shared by every plugin's process()
+
+#ifndef PROCESS_BLOCK_H_
+#define PROCESS_BLOCK_H_
+
+#include <clap/clap.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "channels.h"
+#include "constant_detector.h"
+#include "param_events.h"
+#include "silence_detector.h"
+
+namespace stinky_dsp {
+
+// What ProcessBlock needs to know about a block beyond the main ports
+struct BlockOptions {
+  // Channels of the selected layout. The DSP runs the output's channels up
+  // to this many.
+  uint32_t layout_channels = kMaxChannels;
+
+  // False if another input that drives the DSP (a sidechain) is sounding,
+  // so a silent main input alone does not silence the output
+  bool other_inputs_silent = true;
+
+  // False if the DSP cannot be in a steady state whatever the input does,
+  // e.g. while a parameter ramps
+  bool may_settle = true;
+};
+
+// [audio thread] Runs one block of a plugin's main ports:
+//  - once the input has been silent for the whole tail, applies the block's
+//    events, writes silence and returns CLAP_PROCESS_SLEEP without the DSP
+//  - once a constant input has settled the DSP, and the block has no
+//    events, one probed frame gives the whole block
+//  - otherwise runs the DSP, split at parameter event timestamps
+// Channels the input lacks repeat its first one, so a mono input feeds
+// every side; with no input channels the DSP is fed silence. Output
+// channels past the selected layout are silent. The DSP reads the input
+// and writes the output, so hosts may process in place.
+//
+// `apply_event(header)` applies one event and returns true if it changed a
+// parameter. `update_params()` passes changed parameters to the processor.
+// `process_channels(in, out, num_channels, frame, frames)` runs the DSP on
+// `frames` frames starting at `frame`; `in` and `out` already point there.
+template <typename T, typename ApplyEvent, typename UpdateParams,
+          typename ProcessChannels>
+clap_process_status ProcessBlock(const clap_process_t* process,
+                                 const T* const* inputs, T* const* outputs,
+                                 const BlockOptions& options,
+                                 SilenceDetector& silence,
+                                 ConstantDetector& constant,
+                                 ApplyEvent&& apply_event,
+                                 UpdateParams&& update_params,
+                                 ProcessChannels&& process_channels) {
+  const uint32_t frame_count = process->frames_count;
+  const uint32_t in_channels = process->audio_inputs[0].channel_count;
+  const uint32_t out_channels = process->audio_outputs[0].channel_count;
+  const uint64_t in_constant_mask = process->audio_inputs[0].constant_mask;
+  const clap_input_events_t* events = process->in_events;
+
+  const uint32_t num_channels =
+      std::min(out_channels, options.layout_channels);
+  const T* in[kMaxChannels];
+  for (uint32_t channel = 0; channel < num_channels; ++channel) {
+    in[channel] = in_channels > 0
+                      ? inputs[channel < in_channels ? channel : 0]
+                      : outputs[channel];
+  }
+
+  const bool input_silent =
+      SilenceDetector::IsSilent(inputs, in_channels, frame_count,
+                                in_constant_mask) &&
+      options.other_inputs_silent;
+
+  clap_audio_buffer_t& output = process->audio_outputs[0];
+  if (silence.Update(input_silent, frame_count)) {
+    if (events) {
+      const uint32_t event_count = events->size(events);
+      bool changed = false;
+      for (uint32_t i = 0; i < event_count; ++i) {
+        changed |= apply_event(events->get(events, i));
+      }
+      if (changed) {
+        update_params();
+      }
+    }
+    for (uint32_t channel = 0; channel < out_channels; ++channel) {
+      std::memset(outputs[channel], 0, frame_count * sizeof(T));
+    }
+    output.constant_mask = ConstantDetector::ChannelMask(out_channels);
+    constant.SetLastOutput(outputs, out_channels, frame_count);
+    return CLAP_PROCESS_SLEEP;
+  }
+
+  // A constant input held for longer than the tail may have settled the
+  // DSP, as long as no parameter is moving
+  bool steady = constant.Update(inputs, in_channels, in_constant_mask,
+                                frame_count, silence.Tail()) &&
+                (!events || events->size(events) == 0) && options.may_settle;
+
+  // Output channels past the layout get silence. Without an input the DSP
+  // runs in place on silence, so its tail still plays out. Cleared only
+  // now, as the output may share its buffers with the input.
+  const uint32_t first_cleared = in_channels > 0 ? num_channels : 0;
+  for (uint32_t channel = first_cleared; channel < out_channels; ++channel) {
+    std::memset(outputs[channel], 0, frame_count * sizeof(T));
+  }
+
+  if (steady) {
+    // One frame gives the whole block once it repeats the last block's
+    // output exactly
+    process_channels(in, outputs, num_channels, 0u, 1u);
+    steady = constant.MatchesLastOutput(outputs, out_channels);
+    if (steady) {
+      ConstantDetector::Fill(outputs, out_channels, frame_count);
+    } else {
+      process_channels(ChannelOffsets(in, num_channels, 1),
+                       ChannelOffsets(outputs, num_channels, 1),
+                       num_channels, 1u, frame_count - 1);
+    }
+  } else {
+    uint32_t next_event = 0;
+    for (uint32_t frame = 0; frame < frame_count;) {
+      bool changed = false;
+      const uint32_t end = ApplyDueEvents(
+          events, &next_event, frame, frame_count,
+          [&](const clap_event_header_t* header) {
+            changed |= apply_event(header);
+          });
+      if (changed) {
+        update_params();
+      }
+      process_channels(ChannelOffsets(in, num_channels, frame),
+                       ChannelOffsets(outputs, num_channels, frame),
+                       num_channels, frame, end - frame);
+      frame = end;
+    }
+  }
+  constant.SetLastOutput(outputs, out_channels, frame_count);
+  output.constant_mask =
+      steady ? ConstantDetector::ChannelMask(out_channels) : 0;
+
+  return silence.IsDecayed() ? CLAP_PROCESS_SLEEP : CLAP_PROCESS_CONTINUE;
+}
+
+}  // namespace stinky_dsp
+
+#endif  // PROCESS_BLOCK_H_
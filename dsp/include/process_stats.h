@@ -0,0 +1,144 @@
+// Copyright 2025
+// Stinky DSP - Per-block processing cost instrumentation
+
+#ifndef PROCESS_STATS_H_
+#define PROCESS_STATS_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace stinky_dsp {
+
+// Time-stamp counter on x86-64; 0 elsewhere (only wall time is recorded)
+inline uint64_t ReadCycleCounter() {
+#if defined(__x86_64__) || defined(_M_X64)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+// Records the cost of each process() call: cycles, wall time and DSP load
+// (wall time over the block's audio duration). The audio thread writes block
+// records to a single-producer/single-consumer ring and updates running
+// totals, the worst case and a load histogram; the main thread reads them.
+// Nothing allocates or locks. Disabled instances cost one relaxed load per
+// block.
+class ProcessStats {
+ public:
+  static constexpr size_t kRingSize = 512;  // Power of two
+  // 5% load buckets; the last one counts blocks at or over the deadline
+  static constexpr size_t kHistogramBuckets = 21;
+
+  struct Block {
+    uint64_t cycles = 0;
+    uint64_t nanoseconds = 0;
+    uint32_t frames = 0;
+  };
+
+  struct Summary {
+    uint64_t blocks = 0;
+    uint64_t frames = 0;
+    uint64_t total_cycles = 0;
+    uint64_t total_nanoseconds = 0;
+    uint64_t max_block_cycles = 0;
+    uint64_t max_block_nanoseconds = 0;
+    double max_load = 0.0;          // Worst block time / block duration
+    uint64_t dropped_records = 0;   // Ring full; totals still count them
+    std::array<uint64_t, kHistogramBuckets> load_histogram = {};
+  };
+
+  // Measures one process() call while in scope
+  class Scope {
+   public:
+    Scope(ProcessStats& stats, uint32_t frames)
+        : stats_(stats.IsEnabled() ? &stats : nullptr), frames_(frames) {
+      if (stats_ == nullptr) return;
+      start_time_ = std::chrono::steady_clock::now();
+      start_cycles_ = ReadCycleCounter();
+    }
+
+    ~Scope() {
+      if (stats_ == nullptr) return;
+      const uint64_t cycles = ReadCycleCounter() - start_cycles_;
+      const auto elapsed = std::chrono::steady_clock::now() - start_time_;
+      stats_->Record(
+          frames_, cycles,
+          static_cast<uint64_t>(
+              std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                  .count()));
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    ProcessStats* stats_;
+    uint32_t frames_;
+    std::chrono::steady_clock::time_point start_time_;
+    uint64_t start_cycles_ = 0;
+  };
+
+  ProcessStats();
+
+  // [main thread, while not processing] Block durations derive from this
+  void SetSampleRate(double sample_rate);
+
+  // [any thread] Starts disabled
+  void SetEnabled(bool enabled);
+  bool IsEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  // [audio thread] Adds one block
+  void Record(uint32_t frames, uint64_t cycles, uint64_t nanoseconds);
+
+  // [main thread] Totals so far. Fields are read individually, so a block
+  // recorded concurrently may show in some of them and not yet in others.
+  Summary GetSummary() const;
+
+  // [main thread] Pops up to `capacity` block records, oldest first, and
+  // returns how many were written
+  size_t ReadBlocks(Block* out, size_t capacity);
+
+  // [main thread] Clears the ring and the totals. The audio thread owns the
+  // totals, so it clears them before its next block; until then GetSummary()
+  // reports zeros.
+  void Reset();
+
+ private:
+  void ClearTotals();
+
+  std::atomic<bool> enabled_;
+  std::atomic<bool> reset_requested_;
+  double nanoseconds_per_frame_;
+
+  // Written by the audio thread only
+  std::atomic<uint64_t> blocks_;
+  std::atomic<uint64_t> frames_;
+  std::atomic<uint64_t> total_cycles_;
+  std::atomic<uint64_t> total_nanoseconds_;
+  std::atomic<uint64_t> max_block_cycles_;
+  std::atomic<uint64_t> max_block_nanoseconds_;
+  std::atomic<double> max_load_;
+  std::atomic<uint64_t> dropped_records_;
+  std::array<std::atomic<uint64_t>, kHistogramBuckets> load_histogram_;
+
+  // Ring indices count up forever; the slot is index % kRingSize
+  std::array<Block, kRingSize> ring_;
+  alignas(64) std::atomic<uint64_t> write_index_;
+  alignas(64) std::atomic<uint64_t> read_index_;
+};
+
+}  // namespace stinky_dsp
+
+#endif  // PROCESS_STATS_H_
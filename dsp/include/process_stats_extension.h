@@ -0,0 +1,122 @@
+// Copyright 2025
+// Stinky DSP - CLAP extension exposing ProcessStats to the host
+
+#ifndef PROCESS_STATS_EXTENSION_H_
+#define PROCESS_STATS_EXTENSION_H_
+
+#include <clap/clap.h>
+
+#include "process_stats.h"
+
+// Custom extension, queried with plugin->get_extension(plugin,
+// STINKY_EXT_PROCESS_STATS). Plain C layout so any host can use it.
+#define STINKY_EXT_PROCESS_STATS "com.stinky.process-stats/1"
+
+extern "C" {
+
+enum { STINKY_PROCESS_STATS_HISTOGRAM_BUCKETS = 21 };
+
+typedef struct stinky_process_stats_block {
+  uint64_t cycles;       // Time-stamp counter ticks; 0 where unavailable
+  uint64_t nanoseconds;  // Wall time of the process() call
+  uint32_t frames;
+} stinky_process_stats_block_t;
+
+typedef struct stinky_process_stats_summary {
+  uint64_t blocks;
+  uint64_t frames;
+  uint64_t total_cycles;
+  uint64_t total_nanoseconds;
+  uint64_t max_block_cycles;
+  uint64_t max_block_nanoseconds;
+  double max_load;  // Worst block time over the block's audio duration
+  uint64_t dropped_records;
+  // Blocks per 5% of load; the last bucket counts blocks at or over 100%
+  uint64_t load_histogram[STINKY_PROCESS_STATS_HISTOGRAM_BUCKETS];
+} stinky_process_stats_summary_t;
+
+typedef struct stinky_plugin_process_stats {
+  // Recording starts disabled. [main-thread]
+  void(CLAP_ABI* set_enabled)(const clap_plugin_t* plugin, bool enabled);
+  bool(CLAP_ABI* is_enabled)(const clap_plugin_t* plugin);
+
+  // Totals since activation or the last reset. [main-thread]
+  bool(CLAP_ABI* get_summary)(const clap_plugin_t* plugin,
+                              stinky_process_stats_summary_t* summary);
+
+  // Pops up to `capacity` per-block records, oldest first; returns the count.
+  // Records that found the ring full are dropped (totals still count them).
+  // [main-thread]
+  uint32_t(CLAP_ABI* read_blocks)(const clap_plugin_t* plugin,
+                                  stinky_process_stats_block_t* blocks,
+                                  uint32_t capacity);
+
+  // [main-thread]
+  void(CLAP_ABI* reset)(const clap_plugin_t* plugin);
+} stinky_plugin_process_stats_t;
+
+}  // extern "C"
+
+namespace stinky_dsp {
+
+static_assert(STINKY_PROCESS_STATS_HISTOGRAM_BUCKETS ==
+              ProcessStats::kHistogramBuckets);
+
+// Extension table for a plugin class whose plugin_data points to an object
+// with `ProcessStats& GetProcessStats()`
+template <typename Plugin>
+const stinky_plugin_process_stats_t* ProcessStatsExtension() {
+  static const stinky_plugin_process_stats_t kExtension = {
+      [](const clap_plugin_t* plugin, bool enabled) {
+        static_cast<Plugin*>(plugin->plugin_data)
+            ->GetProcessStats()
+            .SetEnabled(enabled);
+      },
+      [](const clap_plugin_t* plugin) {
+        return static_cast<Plugin*>(plugin->plugin_data)
+            ->GetProcessStats()
+            .IsEnabled();
+      },
+      [](const clap_plugin_t* plugin,
+         stinky_process_stats_summary_t* summary) {
+        const ProcessStats::Summary stats =
+            static_cast<Plugin*>(plugin->plugin_data)
+                ->GetProcessStats()
+                .GetSummary();
+        summary->blocks = stats.blocks;
+        summary->frames = stats.frames;
+        summary->total_cycles = stats.total_cycles;
+        summary->total_nanoseconds = stats.total_nanoseconds;
+        summary->max_block_cycles = stats.max_block_cycles;
+        summary->max_block_nanoseconds = stats.max_block_nanoseconds;
+        summary->max_load = stats.max_load;
+        summary->dropped_records = stats.dropped_records;
+        for (size_t i = 0; i < ProcessStats::kHistogramBuckets; ++i) {
+          summary->load_histogram[i] = stats.load_histogram[i];
+        }
+        return true;
+      },
+      [](const clap_plugin_t* plugin, stinky_process_stats_block_t* blocks,
+         uint32_t capacity) {
+        ProcessStats& stats =
+            static_cast<Plugin*>(plugin->plugin_data)->GetProcessStats();
+        ProcessStats::Block block;
+        uint32_t count = 0;
+        while (count < capacity && stats.ReadBlocks(&block, 1) == 1) {
+          blocks[count].cycles = block.cycles;
+          blocks[count].nanoseconds = block.nanoseconds;
+          blocks[count].frames = block.frames;
+          ++count;
+        }
+        return count;
+      },
+      [](const clap_plugin_t* plugin) {
+        static_cast<Plugin*>(plugin->plugin_data)->GetProcessStats().Reset();
+      },
+  };
+  return &kExtension;
+}
+
+}  // namespace stinky_dsp
+
+#endif  // PROCESS_STATS_EXTENSION_H_
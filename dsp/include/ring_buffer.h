@@ -0,0 +1,105 @@
+// Copyright 2025
+// Stinky DSP - Power-of-two ring buffer for delay lines
+
+#ifndef RING_BUFFER_H_
+#define RING_BUFFER_H_
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace stinky_dsp {
+
+// Delay line of T with a power-of-two capacity, so positions wrap with a
+// mask instead of a division. Blocks go in and out as at most two
+// contiguous copies, split where the ring wraps. The storage is owned and
+// starts on a cache line.
+template <typename T>
+class RingBuffer {
+  static_assert(std::is_trivially_copyable_v<T>);
+
+ public:
+  RingBuffer() = default;
+
+  // Allocates room for at least `min_capacity` values, all zero
+  explicit RingBuffer(size_t min_capacity) { Allocate(min_capacity); }
+
+  // Allocates room for at least `min_capacity` values, all zero. Not for
+  // the audio thread.
+  void Allocate(size_t min_capacity) {
+    capacity_ = std::bit_ceil(std::max<size_t>(min_capacity, 1));
+    buffer_.reset(static_cast<T*>(::operator new[](
+        capacity_ * sizeof(T), std::align_val_t{kCacheLineSize})));
+    mask_ = capacity_ - 1;
+    Clear();
+  }
+
+  size_t Capacity() const { return capacity_; }
+
+  // [audio thread] Zeroes every value
+  void Clear() {
+    std::fill_n(buffer_.get(), capacity_, T{});
+    write_pos_ = 0;
+  }
+
+  // [audio thread] Zeroes the last `delay` values written, which is all a
+  // Read with at most that delay can still return before new writes
+  void Clear(size_t delay) {
+    const size_t start = (write_pos_ - delay) & mask_;
+    const size_t first = std::min(delay, capacity_ - start);
+    std::fill_n(buffer_.get() + start, first, T{});
+    std::fill_n(buffer_.get(), delay - first, T{});
+  }
+
+  // Appends `count` (at most Capacity()) values, converted to T
+  template <typename U>
+  void Write(const U* src, size_t count) {
+    const size_t first = std::min(count, capacity_ - write_pos_);
+    std::copy_n(src, first, buffer_.get() + write_pos_);
+    std::copy_n(src + first, count - first, buffer_.get());
+    write_pos_ = (write_pos_ + count) & mask_;
+  }
+
+  // Copies, converted to U, the `count` values written `delay` values
+  // before the last `count` ones. With a delay of 0 that is the last block
+  // written. `delay + count` must not exceed Capacity().
+  template <typename U>
+  void Read(U* dest, size_t delay, size_t count) const {
+    const size_t start = (write_pos_ - delay - count) & mask_;
+    const size_t first = std::min(count, capacity_ - start);
+    std::copy_n(buffer_.get() + start, first, dest);
+    std::copy_n(buffer_.get(), count - first, dest + first);
+  }
+
+  // Appends one value
+  void Push(T value) {
+    buffer_[write_pos_] = value;
+    write_pos_ = (write_pos_ + 1) & mask_;
+  }
+
+  // The value pushed `delay` values before the last one
+  T Delayed(size_t delay) const {
+    return buffer_[(write_pos_ - 1 - delay) & mask_];
+  }
+
+ private:
+  static constexpr size_t kCacheLineSize = 64;
+
+  struct AlignedDelete {
+    void operator()(T* values) const {
+      ::operator delete[](values, std::align_val_t{kCacheLineSize});
+    }
+  };
+
+  std::unique_ptr<T[], AlignedDelete> buffer_;
+  size_t capacity_ = 0;
+  size_t mask_ = 0;
+  size_t write_pos_ = 0;  // Next slot to write, always below Capacity()
+};
+
+}  // namespace stinky_dsp
+
+#endif  // RING_BUFFER_H_
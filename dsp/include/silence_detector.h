@@ -0,0 +1,59 @@
+// Copyright 2025
+// Stinky DSP - Input silence tracking for idle plugins
+
+#ifndef SILENCE_DETECTOR_H_
+#define SILENCE_DETECTOR_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace stinky_dsp {
+
+// Counts how long a plugin's input has been silent and compares it to the
+// plugin's tail: the frames it keeps producing output (or settling its
+// state) after the input stops. Once the silence covers the tail, the output
+// is silent too, processing can be skipped and process() can return
+// CLAP_PROCESS_SLEEP.
+class SilenceDetector {
+ public:
+  // Samples at or below -120 dBFS count as silence
+  static constexpr float kThreshold = 1e-6f;
+
+  // A tail that never decays (CLAP reports it as UINT32_MAX)
+  static constexpr uint32_t kInfiniteTail = UINT32_MAX;
+
+  SilenceDetector();
+
+  // [audio thread] Sets the tail in frames
+  void SetTail(uint32_t frames);
+
+  // [any thread]
+  uint32_t Tail() const { return tail_frames_.load(std::memory_order_relaxed); }
+
+  // [audio thread] Forgets the silence seen so far
+  void Reset() { silent_frames_ = 0; }
+
+  // True if every sample of the first `num_channels` channels is silent.
+  // Channels flagged in `constant_mask` only have their first sample checked.
+  static bool IsSilent(const float* const* channels, uint32_t num_channels,
+                       size_t num_frames, uint64_t constant_mask = 0);
+  static bool IsSilent(const double* const* channels, uint32_t num_channels,
+                       size_t num_frames, uint64_t constant_mask = 0);
+
+  // [audio thread] Feeds one block. Returns true if the input was already
+  // silent for the whole tail before this block and still is, so the block's
+  // output is silence and its processing can be skipped.
+  bool Update(bool input_silent, uint32_t num_frames);
+
+  // [audio thread] True once the input has been silent for the whole tail
+  bool IsDecayed() const;
+
+ private:
+  std::atomic<uint32_t> tail_frames_;
+  uint64_t silent_frames_;
+};
+
+}  // namespace stinky_dsp
+
+#endif  // SILENCE_DETECTOR_H_
@@ -0,0 +1,150 @@
+// Copyright 2025
+// Stinky DSP - SIMD Utilities with Scalar Fallback
+
+#ifndef SIMD_UTILS_H_
+#define SIMD_UTILS_H_
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace stinky_dsp {
+namespace simd {
+
+// Kernel sets, in increasing order of preference
+enum class Isa { kScalar, kSse2, kAvx2, kAvx512 };
+
+// Selects the fastest kernel set this CPU supports. Call when the module
+// loads (clap_entry.init); until then the baseline set (SSE2 on x86-64) is
+// used. Thread-safe; only the first call has an effect.
+void Initialize();
+
+// Fastest kernel set supported by this CPU and build
+Isa DetectIsa();
+
+// Kernel set used by the functions below
+Isa ActiveIsa();
+
+// Forces a kernel set (tests, benchmarks). Returns false and leaves the active
+// set unchanged if this CPU or build cannot run it.
+bool SetIsa(Isa isa);
+
+const char* IsaName(Isa isa);
+
+// Check if SIMD is available at runtime
+bool IsSimdAvailable();
+
+// Vector operations with SIMD acceleration and scalar fallback
+void MultiplyAdd(float* dest, const float* src, float multiplier,
+                 size_t count);
+
+void Multiply(float* dest, const float* src, float multiplier, size_t count);
+
+void ApplyGain(float* buffer, float gain, size_t count);
+
+// dest[i] = 20 * log10(max(|src[i]|, 1e-8)), using the LinearToDb kernel
+void ConvertToDb(float* dest, const float* src, size_t count);
+
+// Polynomial dB conversions.
+// LinearToDb: dest[i] = 20 * log10(max(src[i], 1e-8)), max error < 2e-4 dB.
+// DbToLinear: dest[i] = 10^(src[i] / 20), max error < 5e-5 dB (input is
+// clamped to about +/-758 dB). 1.0 <-> 0 dB map exactly.
+// dest may alias src.
+void LinearToDb(float* dest, const float* src, size_t count);
+void DbToLinear(float* dest, const float* src, size_t count);
+
+void Max(float* dest, const float* src1, const float* src2, size_t count);
+
+void Min(float* dest, const float* src1, const float* src2, size_t count);
+
+// dest[i] = max(|src1[i]|, |src2[i]|), the linked stereo peak of two channels
+void MaxAbs(float* dest, const float* src1, const float* src2, size_t count);
+
+// max(|src[i]|) over the buffer, 0 when empty
+float PeakAbs(const float* src, size_t count);
+
+// Linked peak of `num_channels` (at least one) channels:
+// dest[i] = max(|channels[c][i]|) over c
+void MaxAbs(float* dest, const float* const* channels, uint32_t num_channels,
+            size_t count);
+
+// 64-bit input versions for hosts that run in double. Levels feed float
+// detectors, so MaxAbs narrows its result. Scalar, not dispatched.
+void MaxAbs(float* dest, const double* src1, const double* src2,
+            size_t count);
+void MaxAbs(float* dest, const double* const* channels,
+            uint32_t num_channels, size_t count);
+double PeakAbs(const double* src, size_t count);
+
+// Static compressor gain curve. For each level in dB, writes the gain change
+// in dB (<= 0 above threshold) using `slope` = 1/ratio - 1 and an optional
+// soft knee of `knee_db` width centred on the threshold. dest may alias src.
+void ComputeGainReductionDb(float* dest, const float* level_db,
+                            float threshold_db, float slope, float knee_db,
+                            size_t count);
+
+// FIR filter: dest[i] = sum over t of taps[t] * src[i - t]. src must be
+// readable from src - (num_taps - 1), and dest must not alias src.
+void Fir(float* dest, const float* src, const float* taps, size_t num_taps,
+         size_t count);
+
+// Scalar versions of the same approximations, for per-sample code paths
+namespace internal {
+
+constexpr float kMinLinear = 1e-8f;
+constexpr float kDbPerLog2 = 6.0205999132796239f;   // 20 * log10(2)
+constexpr float kLog2PerDb = 0.16609640474436813f;  // log2(10) / 20
+constexpr float kMaxExp2 = 126.0f;
+
+// log2(1 + m) for m in [0, 1), minimax degree 5 (max error 1.5e-5)
+constexpr float kLog2C1 = 1.44196561f;
+constexpr float kLog2C2 = -0.709662797f;
+constexpr float kLog2C3 = 0.417595709f;
+constexpr float kLog2C4 = -0.196269546f;
+constexpr float kLog2C5 = 0.046385322f;
+
+// 2^f for f in [0, 1), minimax degree 4 (max relative error 2.9e-6)
+constexpr float kExp2C1 = 0.693044845f;
+constexpr float kExp2C2 = 0.241280205f;
+constexpr float kExp2C3 = 0.0522424736f;
+constexpr float kExp2C4 = 0.0134266846f;
+
+inline float FastLog2(float x) {
+  const uint32_t bits = std::bit_cast<uint32_t>(x);
+  const float exponent =
+      static_cast<float>(static_cast<int32_t>(bits >> 23) - 127);
+  const float m =
+      std::bit_cast<float>((bits & 0x007FFFFFu) | 0x3F800000u) - 1.0f;
+  const float poly =
+      kLog2C1 + m * (kLog2C2 + m * (kLog2C3 + m * (kLog2C4 + m * kLog2C5)));
+  return exponent + m * poly;
+}
+
+inline float FastExp2(float x) {
+  x = std::clamp(x, -kMaxExp2, kMaxExp2);
+  const float n = std::floor(x);
+  const float f = x - n;
+  const float poly =
+      1.0f + f * (kExp2C1 + f * (kExp2C2 + f * (kExp2C3 + f * kExp2C4)));
+  const uint32_t scale_bits =
+      static_cast<uint32_t>(static_cast<int32_t>(n) + 127) << 23;
+  return poly * std::bit_cast<float>(scale_bits);
+}
+
+}  // namespace internal
+
+inline float LinearToDb(float linear) {
+  return internal::kDbPerLog2 *
+         internal::FastLog2(std::max(linear, internal::kMinLinear));
+}
+
+inline float DbToLinear(float db) {
+  return internal::FastExp2(db * internal::kLog2PerDb);
+}
+
+}  // namespace simd
+}  // namespace stinky_dsp
+
+#endif  // SIMD_UTILS_H_
@@ -0,0 +1,100 @@
+// Copyright 2025
+// Stinky DSP - Running maximum and mean over a sliding window
+
+#ifndef SLIDING_WINDOW_H_
+#define SLIDING_WINDOW_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace stinky_dsp {
+
+// Maximum of the last Window() values pushed, in O(1) amortized time per
+// value whatever the window length. A monotonic deque keeps only the values
+// that can still become the maximum, in decreasing order; a value leaves
+// when a larger one arrives or when it falls out of the window.
+class SlidingMax {
+ public:
+  // Allocates for windows of up to `max_window` values
+  explicit SlidingMax(size_t max_window);
+
+  // [audio thread] Sets the window length (1 to max_window) and forgets the
+  // values seen so far
+  void SetWindow(size_t window);
+  size_t Window() const { return window_; }
+
+  // [audio thread] Forgets the values seen so far
+  void Reset();
+
+  // Pushes a value and returns the maximum of the last Window() values,
+  // including this one
+  float Push(float value) {
+    // Each push moves the window by one, so at most one value expires
+    if (size_ > 0 && expiry_[front_] == count_) {
+      front_ = Wrap(front_ + 1);
+      --size_;
+    }
+
+    // Values no larger than the new one can never be the maximum again
+    while (size_ > 0 && values_[Wrap(front_ + size_ - 1)] <= value) {
+      --size_;
+    }
+
+    const size_t back = Wrap(front_ + size_);
+    values_[back] = value;
+    expiry_[back] = count_ + window_;
+    ++size_;
+    ++count_;
+    return values_[front_];
+  }
+
+ private:
+  size_t Wrap(size_t index) const {
+    return index >= values_.size() ? index - values_.size() : index;
+  }
+
+  std::vector<float> values_;     // Deque ring, decreasing from front_
+  std::vector<uint64_t> expiry_;  // Push count at which each value expires
+  size_t window_;
+  size_t front_;
+  size_t size_;
+  uint64_t count_;  // Values pushed since the last reset
+};
+
+// Mean of the last Window() values pushed, in O(1) time per value: a box
+// filter with a running sum. A step input comes out as a linear ramp that
+// reaches the new value exactly Window() - 1 values later.
+class MovingAverage {
+ public:
+  // Allocates for windows of up to `max_window` values
+  explicit MovingAverage(size_t max_window);
+
+  // [audio thread] Sets the window length (1 to max_window) and fills it
+  // with `value`
+  void SetWindow(size_t window, float value);
+  size_t Window() const { return window_; }
+
+  // [audio thread] Fills the window with `value`
+  void Reset(float value);
+
+  // Pushes a value and returns the mean of the last Window() values,
+  // including this one
+  float Push(float value) {
+    sum_ += static_cast<double>(value) - history_[pos_];
+    history_[pos_] = value;
+    if (++pos_ == window_) pos_ = 0;
+    return static_cast<float>(sum_ * inv_window_);
+  }
+
+ private:
+  std::vector<float> history_;
+  double sum_;  // Double, so the running sum does not drift
+  double inv_window_;
+  size_t window_;
+  size_t pos_;
+};
+
+}  // namespace stinky_dsp
+
+#endif  // SLIDING_WINDOW_H_
@@ -0,0 +1,73 @@
+// Copyright 2025
+// Stinky DSP - Parameter smoothing
+
+#ifndef SMOOTHER_H_
+#define SMOOTHER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace stinky_dsp {
+
+// Shape of a parameter ramp
+enum class SmoothingType {
+  kLinear,   // Constant step; reaches the target exactly after the ramp time
+  kOnePole,  // Exponential approach; snaps to the target after the ramp time
+};
+
+// Ramps a parameter towards its target to avoid zipper noise. Use Next() for
+// per-sample values (gains), or Advance() once per sub-block for block-rate
+// ramps of expensive derived values (filter coefficients, thresholds). Once
+// the target is reached IsSmoothing() is false, and callers should take
+// their constant-parameter path.
+class Smoother {
+ public:
+  Smoother();
+
+  // Sets the ramp shape and length. Does not change the current value.
+  void Configure(SmoothingType type, double sample_rate, double ramp_ms);
+
+  // Jumps to `value` without a ramp
+  void Reset(float value);
+
+  // Starts a ramp from the current value. Setting the current target again
+  // is free and does not restart the ramp.
+  void SetTarget(float target);
+
+  float Current() const { return current_; }
+  float Target() const { return target_; }
+  bool IsSmoothing() const { return remaining_ != 0; }
+
+  // Advances one sample and returns the new value
+  float Next() {
+    if (remaining_ == 0) return current_;
+
+    if (--remaining_ == 0) {
+      current_ = target_;
+    } else if (type_ == SmoothingType::kLinear) {
+      current_ += step_;
+    } else {
+      current_ = target_ + (current_ - target_) * pole_;
+    }
+    return current_;
+  }
+
+  // Advances `num_frames` samples and returns the value reached
+  float Advance(size_t num_frames);
+
+  // Writes the next `num_frames` values to `dest`
+  void Process(float* dest, size_t num_frames);
+
+ private:
+  SmoothingType type_;
+  uint32_t ramp_samples_;
+  uint32_t remaining_;
+  float current_;
+  float target_;
+  float step_;  // Linear increment per sample
+  float pole_;  // One-pole feedback coefficient
+};
+
+}  // namespace stinky_dsp
+
+#endif  // SMOOTHER_H_
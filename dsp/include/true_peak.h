@@ -0,0 +1,53 @@
+// Copyright 2025
+// Stinky DSP - Oversampled true-peak level
+
+#ifndef TRUE_PEAK_H_
+#define TRUE_PEAK_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "channels.h"
+
+namespace stinky_dsp {
+
+// True-peak level after ITU-R BS.1770-4 Annex 2: each channel is upsampled
+// 4x with the standard's 48-tap polyphase FIR, and the largest magnitude of
+// the samples and the interpolated points is the level. This catches the
+// inter-sample peaks a D/A converter or lossy encoder reconstructs above the
+// sample peak. Each phase runs over the whole block through simd::Fir.
+class TruePeakDetector {
+ public:
+  static constexpr uint32_t kOversampling = 4;
+  static constexpr size_t kTaps = 12;  // Per phase
+
+  // Frames the level trails the input by: at frame n it covers frame
+  // n - kDelay and the points interpolated between it and the next frame
+  static constexpr size_t kDelay = 6;
+
+  // Frames per Process call
+  static constexpr size_t kMaxBlockSize = 256;
+
+  TruePeakDetector();
+
+  // [audio thread] Clears the filter history
+  void Reset();
+
+  // Writes the true-peak level of `num_frames` (at most kMaxBlockSize)
+  // frames, linked across `num_channels` (at most kMaxChannels) channels.
+  // The filter runs in float for float or double input.
+  template <typename T>
+  void Process(float* dest, const T* const* channels, uint32_t num_channels,
+               size_t num_frames);
+
+ private:
+  // Per channel, the last kTaps - 1 input frames followed by the block
+  alignas(32) float history_[kMaxChannels][kTaps - 1 + kMaxBlockSize];
+
+  // One phase of the upsampled block
+  alignas(32) float phase_[kMaxBlockSize];
+};
+
+}  // namespace stinky_dsp
+
+#endif  // TRUE_PEAK_H_
@@ -0,0 +1,447 @@
+// Copyright 2025
+// Stinky DSP - Stereo biquad cascade implementation
+
+#include "biquad_cascade.h"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+#ifdef USE_SIMD
+#include <emmintrin.h>
+#endif
+
+namespace stinky_dsp {
+
+namespace {
+
+#ifdef USE_SIMD
+// A frame is two floats in lanes 0 (left) and 1 (right); lanes 2 and 3 load
+// as zero. SSE2 is the x86-64 baseline, so this file needs no dispatch.
+struct SplitIo {
+  const float* in_left;
+  const float* in_right;
+  float* left;
+  float* right;
+
+  // Later passes run in place on the output
+  SplitIo Output() const { return {left, right, left, right}; }
+
+  __m128 LoadPair(size_t i) const {
+    return _mm_unpacklo_ps(_mm_load_ss(&in_left[i]),
+                           _mm_load_ss(&in_right[i]));
+  }
+
+  void StorePair(size_t i, __m128 out) const {
+    // Right first: for mono, left == right and both lanes hold the same value
+    right[i] = _mm_cvtss_f32(_mm_shuffle_ps(out, out, 1));
+    left[i] = _mm_cvtss_f32(out);
+  }
+
+  // Double stages widen the input and scale after narrowing
+  __m128d LoadPairPd(size_t i) const { return _mm_cvtps_pd(LoadPair(i)); }
+
+  void StorePairPd(size_t i, __m128d out, __m128 gain) const {
+    StorePair(i, _mm_mul_ps(_mm_cvtpd_ps(out), gain));
+  }
+};
+
+// 64-bit buffers: double stages run on the samples as they are, float
+// stages narrow on load and widen on store
+struct DoubleSplitIo {
+  const double* in_left;
+  const double* in_right;
+  double* left;
+  double* right;
+
+  DoubleSplitIo Output() const { return {left, right, left, right}; }
+
+  __m128d LoadPairPd(size_t i) const {
+    return _mm_loadh_pd(_mm_load_sd(&in_left[i]), &in_right[i]);
+  }
+
+  void StorePairPd(size_t i, __m128d out, __m128 gain) const {
+    out = _mm_mul_pd(out, _mm_cvtps_pd(gain));
+    // Right first, as in SplitIo
+    _mm_storeh_pd(&right[i], out);
+    _mm_storel_pd(&left[i], out);
+  }
+
+  __m128 LoadPair(size_t i) const { return _mm_cvtpd_ps(LoadPairPd(i)); }
+
+  void StorePair(size_t i, __m128 out) const {
+    const __m128d wide = _mm_cvtps_pd(out);
+    _mm_storeh_pd(&right[i], wide);
+    _mm_storel_pd(&left[i], wide);
+  }
+};
+
+struct InterleavedIo {
+  float* buffer;
+
+  InterleavedIo Output() const { return *this; }
+
+  __m128 LoadPair(size_t i) const {
+    return _mm_castsi128_ps(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&buffer[2 * i])));
+  }
+
+  void StorePair(size_t i, __m128 out) const {
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(&buffer[2 * i]),
+                     _mm_castps_si128(out));
+  }
+
+  __m128d LoadPairPd(size_t i) const { return _mm_cvtps_pd(LoadPair(i)); }
+
+  void StorePairPd(size_t i, __m128d out, __m128 gain) const {
+    StorePair(i, _mm_mul_ps(_mm_cvtpd_ps(out), gain));
+  }
+};
+
+inline __m128 LoadStagePair(const float* stage_a, const float* stage_b) {
+  const __m128 a = _mm_castsi128_ps(
+      _mm_loadl_epi64(reinterpret_cast<const __m128i*>(stage_a)));
+  const __m128 b = _mm_castsi128_ps(
+      _mm_loadl_epi64(reinterpret_cast<const __m128i*>(stage_b)));
+  return _mm_movelh_ps(a, b);
+}
+
+inline void StoreStagePair(float* stage_a, float* stage_b, __m128 v) {
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(stage_a), _mm_castps_si128(v));
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(stage_b),
+                   _mm_castps_si128(_mm_movehl_ps(v, v)));
+}
+#else
+template <typename T>
+struct BasicSplitIo {
+  using Sample = T;
+
+  const T* in_left;
+  const T* in_right;
+  T* left;
+  T* right;
+
+  void LoadPair(size_t i, T* x) const {
+    x[0] = in_left[i];
+    x[1] = in_right[i];
+  }
+
+  void StorePair(size_t i, const T* out) const {
+    right[i] = out[1];
+    left[i] = out[0];
+  }
+};
+
+using SplitIo = BasicSplitIo<float>;
+using DoubleSplitIo = BasicSplitIo<double>;
+
+struct InterleavedIo {
+  using Sample = float;
+
+  float* buffer;
+
+  void LoadPair(size_t i, float* x) const {
+    x[0] = buffer[2 * i];
+    x[1] = buffer[2 * i + 1];
+  }
+
+  void StorePair(size_t i, const float* out) const {
+    buffer[2 * i] = out[0];
+    buffer[2 * i + 1] = out[1];
+  }
+};
+#endif
+
+}  // namespace
+
+uint32_t BiquadDecayFrames(const BiquadCoefficients& coefficients,
+                           double attenuation) {
+  // Poles are the roots of z^2 + a1 z + a2
+  const double a1 = coefficients.a1;
+  const double a2 = coefficients.a2;
+  const double discriminant = a1 * a1 - 4.0 * a2;
+  double radius;
+  if (discriminant < 0.0) {
+    radius = std::sqrt(a2);  // Complex pair, |p|^2 = a2
+  } else {
+    const double root = std::sqrt(discriminant);
+    radius = std::max(std::abs(-a1 + root), std::abs(-a1 - root)) / 2.0;
+  }
+
+  // The zeros add at most two frames of FIR response
+  if (radius <= 0.0) return 2;
+  if (radius >= 1.0) return UINT32_MAX;
+  const double frames = std::ceil(std::log(attenuation) / std::log(radius));
+  return frames >= static_cast<double>(UINT32_MAX - 2)
+             ? UINT32_MAX
+             : static_cast<uint32_t>(frames) + 2;
+}
+
+BiquadCascade::BiquadCascade()
+    : num_active_double_(0), num_active_float_(0) {
+  precision_.fill(BiquadPrecision::kDouble);
+  enabled_.fill(false);
+  active_double_.fill(0);
+  active_float_.fill(0);
+  for (size_t stage = 0; stage < kMaxStages; ++stage) {
+    SetStage(stage, BiquadCoefficients());
+  }
+
+  // Pass-through partner for an unpaired float stage
+  for (size_t lane = 0; lane < kLanes; ++lane) {
+    fb0_[kIdentityStage][lane] = 1.0f;
+    fb1_[kIdentityStage][lane] = 0.0f;
+    fb2_[kIdentityStage][lane] = 0.0f;
+    fa1_[kIdentityStage][lane] = 0.0f;
+    fa2_[kIdentityStage][lane] = 0.0f;
+  }
+  Reset();
+}
+
+void BiquadCascade::SetStage(size_t stage,
+                             const BiquadCoefficients& coefficients,
+                             BiquadPrecision precision) {
+  for (size_t lane = 0; lane < kLanes; ++lane) {
+    b0_[stage][lane] = coefficients.b0;
+    b1_[stage][lane] = coefficients.b1;
+    b2_[stage][lane] = coefficients.b2;
+    a1_[stage][lane] = coefficients.a1;
+    a2_[stage][lane] = coefficients.a2;
+    fb0_[stage][lane] = static_cast<float>(coefficients.b0);
+    fb1_[stage][lane] = static_cast<float>(coefficients.b1);
+    fb2_[stage][lane] = static_cast<float>(coefficients.b2);
+    fa1_[stage][lane] = static_cast<float>(coefficients.a1);
+    fa2_[stage][lane] = static_cast<float>(coefficients.a2);
+  }
+
+  if (precision_[stage] == precision) return;
+
+  // Carry the state across so a precision switch does not click
+  for (size_t lane = 0; lane < kLanes; ++lane) {
+    if (precision == BiquadPrecision::kFloat) {
+      fs1_[stage][lane] = static_cast<float>(s1_[stage][lane]);
+      fs2_[stage][lane] = static_cast<float>(s2_[stage][lane]);
+    } else {
+      s1_[stage][lane] = fs1_[stage][lane];
+      s2_[stage][lane] = fs2_[stage][lane];
+    }
+  }
+  precision_[stage] = precision;
+  RebuildActiveStages();
+}
+
+void BiquadCascade::SetStageEnabled(size_t stage, bool enabled) {
+  if (enabled_[stage] == enabled) return;
+
+  enabled_[stage] = enabled;
+  RebuildActiveStages();
+}
+
+void BiquadCascade::RebuildActiveStages() {
+  num_active_double_ = 0;
+  num_active_float_ = 0;
+  for (size_t stage = 0; stage < kMaxStages; ++stage) {
+    if (!enabled_[stage]) continue;
+
+    if (precision_[stage] == BiquadPrecision::kFloat) {
+      active_float_[num_active_float_++] = static_cast<uint8_t>(stage);
+    } else {
+      active_double_[num_active_double_++] = static_cast<uint8_t>(stage);
+    }
+  }
+  if (num_active_float_ % 2 != 0) {
+    active_float_[num_active_float_++] = kIdentityStage;
+  }
+}
+
+void BiquadCascade::Reset() {
+  for (size_t stage = 0; stage <= kMaxStages; ++stage) {
+    for (size_t lane = 0; lane < kLanes; ++lane) {
+      if (stage < kMaxStages) {
+        s1_[stage][lane] = 0.0;
+        s2_[stage][lane] = 0.0;
+      }
+      fs1_[stage][lane] = 0.0f;
+      fs2_[stage][lane] = 0.0f;
+    }
+  }
+}
+
+void BiquadCascade::Process(float* left, float* right, size_t num_frames,
+                            float output_gain) {
+  Run(SplitIo{left, right, left, right}, num_frames, output_gain);
+}
+
+void BiquadCascade::Process(const float* in_left, const float* in_right,
+                            float* out_left, float* out_right,
+                            size_t num_frames, float output_gain) {
+  Run(SplitIo{in_left, in_right, out_left, out_right}, num_frames,
+      output_gain);
+}
+
+void BiquadCascade::Process(const double* in_left, const double* in_right,
+                            double* out_left, double* out_right,
+                            size_t num_frames, float output_gain) {
+  Run(DoubleSplitIo{in_left, in_right, out_left, out_right}, num_frames,
+      output_gain);
+}
+
+void BiquadCascade::ProcessInterleaved(float* buffer, size_t num_frames,
+                                       float output_gain) {
+  Run(InterleavedIo{buffer}, num_frames, output_gain);
+}
+
+#ifdef USE_SIMD
+template <typename Io>
+void BiquadCascade::Run(Io io, size_t num_frames, float output_gain) {
+  const size_t num_pairs = num_active_float_ / 2;
+
+  // The double pass also applies the gain when there is nothing after it.
+  // The first pass reads the input; the rest run in place on the output.
+  const bool double_pass = num_active_double_ > 0 || num_pairs == 0;
+  if (double_pass) {
+    RunDoubleStages(io, num_frames, num_pairs == 0 ? output_gain : 1.0f);
+  }
+  for (size_t pair = 0; pair < num_pairs; ++pair) {
+    RunFloatPair(pair == 0 && !double_pass ? io : io.Output(), num_frames,
+                 active_float_[2 * pair], active_float_[2 * pair + 1],
+                 pair + 1 == num_pairs ? output_gain : 1.0f);
+  }
+}
+
+template <typename Io>
+void BiquadCascade::RunDoubleStages(Io io, size_t num_frames,
+                                    float output_gain) {
+  const size_t num_stages = num_active_double_;
+
+  // Gather the active stages into registers (or at worst L1-resident locals)
+  __m128d b0[kMaxStages], b1[kMaxStages], b2[kMaxStages];
+  __m128d a1[kMaxStages], a2[kMaxStages];
+  __m128d s1[kMaxStages], s2[kMaxStages];
+  for (size_t k = 0; k < num_stages; ++k) {
+    const size_t stage = active_double_[k];
+    b0[k] = _mm_load_pd(b0_[stage]);
+    b1[k] = _mm_load_pd(b1_[stage]);
+    b2[k] = _mm_load_pd(b2_[stage]);
+    a1[k] = _mm_load_pd(a1_[stage]);
+    a2[k] = _mm_load_pd(a2_[stage]);
+    s1[k] = _mm_load_pd(s1_[stage]);
+    s2[k] = _mm_load_pd(s2_[stage]);
+  }
+  const __m128 gain = _mm_set1_ps(output_gain);
+
+  for (size_t i = 0; i < num_frames; ++i) {
+    __m128d x = io.LoadPairPd(i);
+
+    // Transposed direct form II:
+    //   y  = b0*x + s1
+    //   s1 = b1*x - a1*y + s2
+    //   s2 = b2*x - a2*y
+    for (size_t k = 0; k < num_stages; ++k) {
+      const __m128d y = _mm_add_pd(_mm_mul_pd(b0[k], x), s1[k]);
+      s1[k] = _mm_add_pd(
+          _mm_sub_pd(_mm_mul_pd(b1[k], x), _mm_mul_pd(a1[k], y)), s2[k]);
+      s2[k] = _mm_sub_pd(_mm_mul_pd(b2[k], x), _mm_mul_pd(a2[k], y));
+      x = y;
+    }
+
+    io.StorePairPd(i, x, gain);
+  }
+
+  for (size_t k = 0; k < num_stages; ++k) {
+    const size_t stage = active_double_[k];
+    _mm_store_pd(s1_[stage], s1[k]);
+    _mm_store_pd(s2_[stage], s2[k]);
+  }
+}
+
+// Lanes 0-1 run stage A on frame t, lanes 2-3 run stage B on frame t - 1
+// (stage A's previous output). One TDF-II step advances both stages.
+template <typename Io>
+void BiquadCascade::RunFloatPair(Io io, size_t num_frames, size_t stage_a,
+                                 size_t stage_b, float output_gain) {
+  if (num_frames == 0) return;
+
+  const __m128 b0 = LoadStagePair(fb0_[stage_a], fb0_[stage_b]);
+  const __m128 b1 = LoadStagePair(fb1_[stage_a], fb1_[stage_b]);
+  const __m128 b2 = LoadStagePair(fb2_[stage_a], fb2_[stage_b]);
+  const __m128 a1 = LoadStagePair(fa1_[stage_a], fa1_[stage_b]);
+  const __m128 a2 = LoadStagePair(fa2_[stage_a], fa2_[stage_b]);
+  __m128 s1 = LoadStagePair(fs1_[stage_a], fs1_[stage_b]);
+  __m128 s2 = LoadStagePair(fs2_[stage_a], fs2_[stage_b]);
+  const __m128 gain = _mm_set1_ps(output_gain);
+
+  auto step = [&](__m128 x) {
+    const __m128 y = _mm_add_ps(_mm_mul_ps(b0, x), s1);
+    s1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(b1, x), _mm_mul_ps(a1, y)), s2);
+    s2 = _mm_sub_ps(_mm_mul_ps(b2, x), _mm_mul_ps(a2, y));
+    return y;
+  };
+
+  // Prologue: stage A on frame 0 only; stage B already ran up to frame -1,
+  // so its lanes keep their state
+  __m128 saved_s1 = s1;
+  __m128 saved_s2 = s2;
+  __m128 y = step(io.LoadPair(0));
+  s1 = _mm_shuffle_ps(s1, saved_s1, _MM_SHUFFLE(3, 2, 1, 0));
+  s2 = _mm_shuffle_ps(s2, saved_s2, _MM_SHUFFLE(3, 2, 1, 0));
+
+  for (size_t i = 1; i < num_frames; ++i) {
+    // Load frame i before storing frame i - 1, so in-place is safe
+    y = step(_mm_movelh_ps(io.LoadPair(i), y));
+    io.StorePair(i - 1, _mm_mul_ps(_mm_movehl_ps(y, y), gain));
+  }
+
+  // Epilogue: stage B on the last frame only; stage A's lanes keep their state
+  saved_s1 = s1;
+  saved_s2 = s2;
+  y = step(_mm_movelh_ps(_mm_setzero_ps(), y));
+  io.StorePair(num_frames - 1, _mm_mul_ps(_mm_movehl_ps(y, y), gain));
+  s1 = _mm_shuffle_ps(saved_s1, s1, _MM_SHUFFLE(3, 2, 1, 0));
+  s2 = _mm_shuffle_ps(saved_s2, s2, _MM_SHUFFLE(3, 2, 1, 0));
+
+  StoreStagePair(fs1_[stage_a], fs1_[stage_b], s1);
+  StoreStagePair(fs2_[stage_a], fs2_[stage_b], s2);
+}
+#else
+template <typename Io>
+void BiquadCascade::Run(Io io, size_t num_frames, float output_gain) {
+  using Sample = typename Io::Sample;
+  for (size_t i = 0; i < num_frames; ++i) {
+    Sample frame[kLanes];
+    io.LoadPair(i, frame);
+
+    for (size_t lane = 0; lane < kLanes; ++lane) {
+      double x = frame[lane];
+      for (size_t k = 0; k < num_active_double_; ++k) {
+        const size_t stage = active_double_[k];
+        const double y = b0_[stage][lane] * x + s1_[stage][lane];
+        s1_[stage][lane] = b1_[stage][lane] * x - a1_[stage][lane] * y +
+                           s2_[stage][lane];
+        s2_[stage][lane] = b2_[stage][lane] * x - a2_[stage][lane] * y;
+        x = y;
+      }
+
+      // 64-bit samples stay double unless a float stage follows
+      if (std::is_same_v<Sample, double> && num_active_float_ == 0) {
+        frame[lane] = static_cast<Sample>(x * output_gain);
+        continue;
+      }
+
+      float xf = static_cast<float>(x);
+      for (size_t k = 0; k < num_active_float_; ++k) {
+        const size_t stage = active_float_[k];
+        const float y = fb0_[stage][lane] * xf + fs1_[stage][lane];
+        fs1_[stage][lane] = fb1_[stage][lane] * xf - fa1_[stage][lane] * y +
+                            fs2_[stage][lane];
+        fs2_[stage][lane] = fb2_[stage][lane] * xf - fa2_[stage][lane] * y;
+        xf = y;
+      }
+      frame[lane] = xf * output_gain;
+    }
+    io.StorePair(i, frame);
+  }
+}
+#endif
+
+}  // namespace stinky_dsp
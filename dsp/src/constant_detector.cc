@@ -0,0 +1,99 @@
+// Copyright 2025
+// Stinky DSP - Constant input tracking implementation
+
+#include "constant_detector.h"
+
+#include <algorithm>
+
+namespace stinky_dsp {
+
+ConstantDetector::ConstantDetector()
+    : input_{}, output_{}, constant_frames_(0), input_channels_(0),
+      output_channels_(0) {}
+
+void ConstantDetector::Reset() {
+  constant_frames_ = 0;
+  input_channels_ = 0;
+  output_channels_ = 0;
+}
+
+uint64_t ConstantDetector::ChannelMask(uint32_t num_channels) {
+  return num_channels >= kMaxChannels ? ~uint64_t{0}
+                                      : (uint64_t{1} << num_channels) - 1;
+}
+
+template <typename T>
+bool ConstantDetector::Update(const T* const* channels,
+                              uint32_t num_channels, uint64_t constant_mask,
+                              uint32_t num_frames, uint32_t settle_frames) {
+  const uint64_t mask = ChannelMask(num_channels);
+  if (num_channels == 0 || num_channels > kMaxChannels ||
+      (constant_mask & mask) != mask) {
+    constant_frames_ = 0;
+    input_channels_ = 0;
+    return false;
+  }
+
+  bool same = num_channels == input_channels_;
+  for (uint32_t channel = 0; channel < num_channels; ++channel) {
+    same = same && channels[channel][0] == input_[channel];
+    input_[channel] = channels[channel][0];
+  }
+  if (!same) {
+    constant_frames_ = 0;
+    input_channels_ = num_channels;
+  }
+
+  const bool settled =
+      settle_frames != UINT32_MAX && constant_frames_ >= settle_frames;
+  constant_frames_ += num_frames;
+  return settled;
+}
+
+template <typename T>
+void ConstantDetector::SetLastOutput(const T* const* channels,
+                                     uint32_t num_channels,
+                                     size_t num_frames) {
+  if (num_frames == 0) return;
+  output_channels_ = std::min(num_channels, kMaxChannels);
+  for (uint32_t channel = 0; channel < output_channels_; ++channel) {
+    output_[channel] = channels[channel][num_frames - 1];
+  }
+}
+
+template <typename T>
+bool ConstantDetector::MatchesLastOutput(const T* const* channels,
+                                         uint32_t num_channels) const {
+  if (num_channels == 0 || num_channels != output_channels_) return false;
+  for (uint32_t channel = 0; channel < num_channels; ++channel) {
+    if (channels[channel][0] != output_[channel]) return false;
+  }
+  return true;
+}
+
+template <typename T>
+void ConstantDetector::Fill(T* const* channels, uint32_t num_channels,
+                            size_t num_frames) {
+  if (num_frames < 2) return;
+  for (uint32_t channel = 0; channel < num_channels; ++channel) {
+    std::fill(channels[channel] + 1, channels[channel] + num_frames,
+              channels[channel][0]);
+  }
+}
+
+template bool ConstantDetector::Update(const float* const*, uint32_t,
+                                       uint64_t, uint32_t, uint32_t);
+template bool ConstantDetector::Update(const double* const*, uint32_t,
+                                       uint64_t, uint32_t, uint32_t);
+template void ConstantDetector::SetLastOutput(const float* const*, uint32_t,
+                                              size_t);
+template void ConstantDetector::SetLastOutput(const double* const*, uint32_t,
+                                              size_t);
+template bool ConstantDetector::MatchesLastOutput(const float* const*,
+                                                  uint32_t) const;
+template bool ConstantDetector::MatchesLastOutput(const double* const*,
+                                                  uint32_t) const;
+template void ConstantDetector::Fill(float* const*, uint32_t, size_t);
+template void ConstantDetector::Fill(double* const*, uint32_t, size_t);
+
+}  // namespace stinky_dsp
@@ -0,0 +1,127 @@
+// Copyright 2025
+// Stinky DSP - Per-block processing cost instrumentation
+
+#include "process_stats.h"
+
+#include <algorithm>
+
+namespace stinky_dsp {
+
+static_assert((ProcessStats::kRingSize & (ProcessStats::kRingSize - 1)) == 0,
+              "ring size must be a power of two");
+
+ProcessStats::ProcessStats()
+    : enabled_(false),
+      reset_requested_(false),
+      nanoseconds_per_frame_(1e9 / 48000.0),
+      write_index_(0),
+      read_index_(0) {
+  ClearTotals();
+}
+
+void ProcessStats::SetSampleRate(double sample_rate) {
+  nanoseconds_per_frame_ = 1e9 / sample_rate;
+}
+
+void ProcessStats::SetEnabled(bool enabled) {
+  enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void ProcessStats::Record(uint32_t frames, uint64_t cycles,
+                          uint64_t nanoseconds) {
+  if (reset_requested_.exchange(false, std::memory_order_acquire)) {
+    ClearTotals();
+  }
+
+  // Single writer: plain read-modify-write through relaxed atomics
+  const auto add = [](std::atomic<uint64_t>& total, uint64_t value) {
+    total.store(total.load(std::memory_order_relaxed) + value,
+                std::memory_order_relaxed);
+  };
+  add(blocks_, 1);
+  add(frames_, frames);
+  add(total_cycles_, cycles);
+  add(total_nanoseconds_, nanoseconds);
+  if (cycles > max_block_cycles_.load(std::memory_order_relaxed)) {
+    max_block_cycles_.store(cycles, std::memory_order_relaxed);
+  }
+  if (nanoseconds > max_block_nanoseconds_.load(std::memory_order_relaxed)) {
+    max_block_nanoseconds_.store(nanoseconds, std::memory_order_relaxed);
+  }
+
+  const double deadline = frames * nanoseconds_per_frame_;
+  const double load = deadline > 0.0 ? nanoseconds / deadline : 0.0;
+  if (load > max_load_.load(std::memory_order_relaxed)) {
+    max_load_.store(load, std::memory_order_relaxed);
+  }
+  const size_t bucket = std::min(static_cast<size_t>(load * 20.0),
+                                 kHistogramBuckets - 1);
+  add(load_histogram_[bucket], 1);
+
+  const uint64_t write = write_index_.load(std::memory_order_relaxed);
+  if (write - read_index_.load(std::memory_order_acquire) >= kRingSize) {
+    add(dropped_records_, 1);
+    return;
+  }
+  Block& block = ring_[write % kRingSize];
+  block.cycles = cycles;
+  block.nanoseconds = nanoseconds;
+  block.frames = frames;
+  write_index_.store(write + 1, std::memory_order_release);
+}
+
+ProcessStats::Summary ProcessStats::GetSummary() const {
+  Summary summary;
+  if (reset_requested_.load(std::memory_order_relaxed)) return summary;
+
+  summary.blocks = blocks_.load(std::memory_order_relaxed);
+  summary.frames = frames_.load(std::memory_order_relaxed);
+  summary.total_cycles = total_cycles_.load(std::memory_order_relaxed);
+  summary.total_nanoseconds =
+      total_nanoseconds_.load(std::memory_order_relaxed);
+  summary.max_block_cycles = max_block_cycles_.load(std::memory_order_relaxed);
+  summary.max_block_nanoseconds =
+      max_block_nanoseconds_.load(std::memory_order_relaxed);
+  summary.max_load = max_load_.load(std::memory_order_relaxed);
+  summary.dropped_records = dropped_records_.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < kHistogramBuckets; ++i) {
+    summary.load_histogram[i] =
+        load_histogram_[i].load(std::memory_order_relaxed);
+  }
+  return summary;
+}
+
+size_t ProcessStats::ReadBlocks(Block* out, size_t capacity) {
+  const uint64_t read = read_index_.load(std::memory_order_relaxed);
+  const uint64_t available =
+      write_index_.load(std::memory_order_acquire) - read;
+  const size_t count =
+      static_cast<size_t>(std::min<uint64_t>(available, capacity));
+  for (size_t i = 0; i < count; ++i) {
+    out[i] = ring_[(read + i) % kRingSize];
+  }
+  read_index_.store(read + count, std::memory_order_release);
+  return count;
+}
+
+void ProcessStats::Reset() {
+  read_index_.store(write_index_.load(std::memory_order_acquire),
+                    std::memory_order_release);
+  reset_requested_.store(true, std::memory_order_release);
+}
+
+void ProcessStats::ClearTotals() {
+  blocks_.store(0, std::memory_order_relaxed);
+  frames_.store(0, std::memory_order_relaxed);
+  total_cycles_.store(0, std::memory_order_relaxed);
+  total_nanoseconds_.store(0, std::memory_order_relaxed);
+  max_block_cycles_.store(0, std::memory_order_relaxed);
+  max_block_nanoseconds_.store(0, std::memory_order_relaxed);
+  max_load_.store(0.0, std::memory_order_relaxed);
+  dropped_records_.store(0, std::memory_order_relaxed);
+  for (std::atomic<uint64_t>& count : load_histogram_) {
+    count.store(0, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace stinky_dsp
@@ -0,0 +1,64 @@
+// Copyright 2025
+// Stinky DSP - Input silence tracking implementation
+
+#include "silence_detector.h"
+
+#include <algorithm>
+
+#include "simd_utils.h"
+
+namespace stinky_dsp {
+
+namespace {
+
+template <typename T>
+bool AllSilent(const T* const* channels, uint32_t num_channels,
+               size_t num_frames, uint64_t constant_mask) {
+  for (uint32_t channel = 0; channel < num_channels; ++channel) {
+    const bool constant = channel < 64 && (constant_mask >> channel) & 1;
+    const size_t frames = constant ? std::min<size_t>(num_frames, 1)
+                                   : num_frames;
+    if (simd::PeakAbs(channels[channel], frames) >
+        SilenceDetector::kThreshold) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+SilenceDetector::SilenceDetector() : tail_frames_(0), silent_frames_(0) {}
+
+void SilenceDetector::SetTail(uint32_t frames) {
+  tail_frames_.store(frames, std::memory_order_relaxed);
+}
+
+bool SilenceDetector::IsSilent(const float* const* channels,
+                               uint32_t num_channels, size_t num_frames,
+                               uint64_t constant_mask) {
+  return AllSilent(channels, num_channels, num_frames, constant_mask);
+}
+
+bool SilenceDetector::IsSilent(const double* const* channels,
+                               uint32_t num_channels, size_t num_frames,
+                               uint64_t constant_mask) {
+  return AllSilent(channels, num_channels, num_frames, constant_mask);
+}
+
+bool SilenceDetector::Update(bool input_silent, uint32_t num_frames) {
+  if (!input_silent) {
+    silent_frames_ = 0;
+    return false;
+  }
+  const bool skip = IsDecayed();
+  silent_frames_ += num_frames;
+  return skip;
+}
+
+bool SilenceDetector::IsDecayed() const {
+  const uint32_t tail = Tail();
+  return tail != kInfiniteTail && silent_frames_ >= tail;
+}
+
+}  // namespace stinky_dsp
@@ -0,0 +1,70 @@
+// Copyright 2025
+// Stinky DSP - Per-ISA kernel tables (internal to stinky_dsp)
+
+#ifndef SIMD_KERNELS_H_
+#define SIMD_KERNELS_H_
+
+#include <cstddef>
+
+namespace stinky_dsp {
+namespace simd {
+
+// One entry per public kernel in simd_utils.h, same signatures
+struct KernelTable {
+  void (*multiply_add)(float* dest, const float* src, float multiplier,
+                       size_t count);
+  void (*multiply)(float* dest, const float* src, float multiplier,
+                   size_t count);
+  void (*apply_gain)(float* buffer, float gain, size_t count);
+  void (*convert_to_db)(float* dest, const float* src, size_t count);
+  void (*linear_to_db)(float* dest, const float* src, size_t count);
+  void (*db_to_linear)(float* dest, const float* src, size_t count);
+  void (*max)(float* dest, const float* src1, const float* src2, size_t count);
+  void (*min)(float* dest, const float* src1, const float* src2, size_t count);
+  void (*max_abs)(float* dest, const float* src1, const float* src2,
+                  size_t count);
+  float (*peak_abs)(const float* src, size_t count);
+  void (*compute_gain_reduction_db)(float* dest, const float* level_db,
+                                    float threshold_db, float slope,
+                                    float knee_db, size_t count);
+  void (*fir)(float* dest, const float* src, const float* taps,
+              size_t num_taps, size_t count);
+};
+
+// Scalar kernels, built with baseline flags. The vector TUs call these for
+// loop tails rather than header inline helpers: an inline function emitted in
+// an AVX TU may be the copy the linker keeps for the whole module.
+namespace scalar {
+
+void MultiplyAdd(float* dest, const float* src, float multiplier,
+                 size_t count);
+void Multiply(float* dest, const float* src, float multiplier, size_t count);
+void ApplyGain(float* buffer, float gain, size_t count);
+void ConvertToDb(float* dest, const float* src, size_t count);
+void LinearToDb(float* dest, const float* src, size_t count);
+void DbToLinear(float* dest, const float* src, size_t count);
+void Max(float* dest, const float* src1, const float* src2, size_t count);
+void Min(float* dest, const float* src1, const float* src2, size_t count);
+void MaxAbs(float* dest, const float* src1, const float* src2, size_t count);
+float PeakAbs(const float* src, size_t count);
+void ComputeGainReductionDb(float* dest, const float* level_db,
+                            float threshold_db, float slope, float knee_db,
+                            size_t count);
+void Fir(float* dest, const float* src, const float* taps, size_t num_taps,
+         size_t count);
+
+}  // namespace scalar
+
+extern const KernelTable kScalarKernels;
+
+#ifdef USE_SIMD
+// x86-64 only; each table lives in a TU compiled for its instruction set
+extern const KernelTable kSse2Kernels;
+extern const KernelTable kAvx2Kernels;
+extern const KernelTable kAvx512Kernels;
+#endif
+
+}  // namespace simd
+}  // namespace stinky_dsp
+
+#endif  // SIMD_KERNELS_H_
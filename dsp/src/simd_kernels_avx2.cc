@@ -0,0 +1,265 @@
+// Copyright 2025
+// Stinky DSP - AVX2 + FMA kernels (this file alone is built with -mavx2 -mfma)
+
+#include "simd_kernels.h"
+
+#include <immintrin.h>
+
+#include "simd_utils.h"
+
+namespace stinky_dsp {
+namespace simd {
+namespace avx2 {
+namespace {
+
+// Vector forms of internal::FastLog2 / internal::FastExp2 (see simd_utils.h)
+inline __m256 Log2Avx2(__m256 x) {
+  const __m256i bits = _mm256_castps_si256(x);
+  const __m256 exponent = _mm256_cvtepi32_ps(
+      _mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(127)));
+  const __m256 m = _mm256_sub_ps(
+      _mm256_castsi256_ps(_mm256_or_si256(
+          _mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)),
+          _mm256_set1_epi32(0x3F800000))),
+      _mm256_set1_ps(1.0f));
+  __m256 poly = _mm256_set1_ps(internal::kLog2C5);
+  poly = _mm256_fmadd_ps(poly, m, _mm256_set1_ps(internal::kLog2C4));
+  poly = _mm256_fmadd_ps(poly, m, _mm256_set1_ps(internal::kLog2C3));
+  poly = _mm256_fmadd_ps(poly, m, _mm256_set1_ps(internal::kLog2C2));
+  poly = _mm256_fmadd_ps(poly, m, _mm256_set1_ps(internal::kLog2C1));
+  return _mm256_fmadd_ps(poly, m, exponent);
+}
+
+inline __m256 Exp2Avx2(__m256 x) {
+  x = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(-internal::kMaxExp2)),
+                    _mm256_set1_ps(internal::kMaxExp2));
+  const __m256 n = _mm256_floor_ps(x);
+  const __m256 f = _mm256_sub_ps(x, n);
+  __m256 poly = _mm256_set1_ps(internal::kExp2C4);
+  poly = _mm256_fmadd_ps(poly, f, _mm256_set1_ps(internal::kExp2C3));
+  poly = _mm256_fmadd_ps(poly, f, _mm256_set1_ps(internal::kExp2C2));
+  poly = _mm256_fmadd_ps(poly, f, _mm256_set1_ps(internal::kExp2C1));
+  poly = _mm256_fmadd_ps(poly, f, _mm256_set1_ps(1.0f));
+  const __m256i scale = _mm256_slli_epi32(
+      _mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127)), 23);
+  return _mm256_mul_ps(poly, _mm256_castsi256_ps(scale));
+}
+
+void MultiplyAdd(float* dest, const float* src, float multiplier,
+                 size_t count) {
+  const size_t simd_count = count & ~size_t{7};
+  const __m256 mult_vec = _mm256_set1_ps(multiplier);
+
+  for (size_t i = 0; i < simd_count; i += 8) {
+    __m256 src_vec = _mm256_loadu_ps(&src[i]);
+    __m256 dest_vec = _mm256_loadu_ps(&dest[i]);
+    dest_vec = _mm256_fmadd_ps(src_vec, mult_vec, dest_vec);
+    _mm256_storeu_ps(&dest[i], dest_vec);
+  }
+  scalar::MultiplyAdd(dest + simd_count, src + simd_count, multiplier,
+                      count - simd_count);
+}
+
+void Multiply(float* dest, const float* src, float multiplier, size_t count) {
+  const size_t simd_count = count & ~size_t{7};
+  const __m256 mult_vec = _mm256_set1_ps(multiplier);
+
+  for (size_t i = 0; i < simd_count; i += 8) {
+    __m256 src_vec = _mm256_loadu_ps(&src[i]);
+    _mm256_storeu_ps(&dest[i], _mm256_mul_ps(src_vec, mult_vec));
+  }
+  scalar::Multiply(dest + simd_count, src + simd_count, multiplier,
+                   count - simd_count);
+}
+
+void ApplyGain(float* buffer, float gain, size_t count) {
+  const size_t simd_count = count & ~size_t{7};
+  const __m256 gain_vec = _mm256_set1_ps(gain);
+
+  for (size_t i = 0; i < simd_count; i += 8) {
+    __m256 buf_vec = _mm256_loadu_ps(&buffer[i]);
+    _mm256_storeu_ps(&buffer[i], _mm256_mul_ps(buf_vec, gain_vec));
+  }
+  scalar::ApplyGain(buffer + simd_count, gain, count - simd_count);
+}
+
+void ConvertToDb(float* dest, const float* src, size_t count) {
+  const size_t simd_count = count & ~size_t{7};
+  const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+  const __m256 min_vec = _mm256_set1_ps(internal::kMinLinear);
+  const __m256 scale_vec = _mm256_set1_ps(internal::kDbPerLog2);
+
+  for (size_t i = 0; i < simd_count; i += 8) {
+    __m256 vec = _mm256_and_ps(_mm256_loadu_ps(&src[i]), abs_mask);
+    vec = Log2Avx2(_mm256_max_ps(vec, min_vec));
+    _mm256_storeu_ps(&dest[i], _mm256_mul_ps(vec, scale_vec));
+  }
+  scalar::ConvertToDb(dest + simd_count, src + simd_count,
+                      count - simd_count);
+}
+
+void LinearToDb(float* dest, const float* src, size_t count) {
+  const size_t simd_count = count & ~size_t{7};
+  const __m256 min_vec = _mm256_set1_ps(internal::kMinLinear);
+  const __m256 scale_vec = _mm256_set1_ps(internal::kDbPerLog2);
+
+  for (size_t i = 0; i < simd_count; i += 8) {
+    __m256 vec = Log2Avx2(_mm256_max_ps(_mm256_loadu_ps(&src[i]), min_vec));
+    _mm256_storeu_ps(&dest[i], _mm256_mul_ps(vec, scale_vec));
+  }
+  scalar::LinearToDb(dest + simd_count, src + simd_count, count - simd_count);
+}
+
+void DbToLinear(float* dest, const float* src, size_t count) {
+  const size_t simd_count = count & ~size_t{7};
+  const __m256 scale_vec = _mm256_set1_ps(internal::kLog2PerDb);
+
+  for (size_t i = 0; i < simd_count; i += 8) {
+    __m256 vec = _mm256_mul_ps(_mm256_loadu_ps(&src[i]), scale_vec);
+    _mm256_storeu_ps(&dest[i], Exp2Avx2(vec));
+  }
+  scalar::DbToLinear(dest + simd_count, src + simd_count, count - simd_count);
+}
+
+void Max(float* dest, const float* src1, const float* src2, size_t count) {
+  const size_t simd_count = count & ~size_t{7};
+
+  for (size_t i = 0; i < simd_count; i += 8) {
+    __m256 vec1 = _mm256_loadu_ps(&src1[i]);
+    __m256 vec2 = _mm256_loadu_ps(&src2[i]);
+    _mm256_storeu_ps(&dest[i], _mm256_max_ps(vec1, vec2));
+  }
+  scalar::Max(dest + simd_count, src1 + simd_count, src2 + simd_count,
+              count - simd_count);
+}
+
+void Min(float* dest, const float* src1, const float* src2, size_t count) {
+  const size_t simd_count = count & ~size_t{7};
+
+  for (size_t i = 0; i < simd_count; i += 8) {
+    __m256 vec1 = _mm256_loadu_ps(&src1[i]);
+    __m256 vec2 = _mm256_loadu_ps(&src2[i]);
+    _mm256_storeu_ps(&dest[i], _mm256_min_ps(vec1, vec2));
+  }
+  scalar::Min(dest + simd_count, src1 + simd_count, src2 + simd_count,
+              count - simd_count);
+}
+
+void MaxAbs(float* dest, const float* src1, const float* src2, size_t count) {
+  const size_t simd_count = count & ~size_t{7};
+  const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+
+  for (size_t i = 0; i < simd_count; i += 8) {
+    __m256 vec1 = _mm256_and_ps(_mm256_loadu_ps(&src1[i]), abs_mask);
+    __m256 vec2 = _mm256_and_ps(_mm256_loadu_ps(&src2[i]), abs_mask);
+    _mm256_storeu_ps(&dest[i], _mm256_max_ps(vec1, vec2));
+  }
+  scalar::MaxAbs(dest + simd_count, src1 + simd_count, src2 + simd_count,
+                 count - simd_count);
+}
+
+float PeakAbs(const float* src, size_t count) {
+  const size_t simd_count = count & ~size_t{7};
+  const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+  __m256 peak = _mm256_setzero_ps();
+
+  for (size_t i = 0; i < simd_count; i += 8) {
+    peak = _mm256_max_ps(peak,
+                         _mm256_and_ps(_mm256_loadu_ps(&src[i]), abs_mask));
+  }
+  __m128 half = _mm_max_ps(_mm256_castps256_ps128(peak),
+                           _mm256_extractf128_ps(peak, 1));
+  half = _mm_max_ps(half, _mm_set1_ps(scalar::PeakAbs(
+                               src + simd_count, count - simd_count)));
+  half = _mm_max_ps(half, _mm_movehl_ps(half, half));
+  half = _mm_max_ss(half, _mm_shuffle_ps(half, half, 1));
+  return _mm_cvtss_f32(half);
+}
+
+void ComputeGainReductionDb(float* dest, const float* level_db,
+                            float threshold_db, float slope, float knee_db,
+                            size_t count) {
+  const size_t simd_count = count & ~size_t{7};
+  const bool has_knee = knee_db > 0.0f;
+  const __m256 threshold_vec = _mm256_set1_ps(threshold_db);
+  const __m256 slope_vec = _mm256_set1_ps(slope);
+  const __m256 low_vec = _mm256_set1_ps(threshold_db - knee_db / 2.0f);
+  const __m256 high_vec = _mm256_set1_ps(threshold_db + knee_db / 2.0f);
+  const __m256 inv_knee_vec =
+      _mm256_set1_ps(has_knee ? 1.0f / knee_db : 0.0f);
+  const __m256 zero = _mm256_setzero_ps();
+
+  for (size_t i = 0; i < simd_count; i += 8) {
+    const __m256 level = _mm256_loadu_ps(&level_db[i]);
+    const __m256 overshoot = _mm256_sub_ps(level, threshold_vec);
+    const __m256 hard = _mm256_mul_ps(overshoot, slope_vec);
+
+    // Hard knee: gain change only above threshold
+    const __m256 above = _mm256_cmp_ps(level, threshold_vec, _CMP_GT_OQ);
+    __m256 result = _mm256_blendv_ps(zero, hard, above);
+
+    if (has_knee) {
+      // Soft knee region overrides the hard curve inside the knee
+      const __m256 in_knee =
+          _mm256_and_ps(_mm256_cmp_ps(level, low_vec, _CMP_GT_OQ),
+                        _mm256_cmp_ps(level, high_vec, _CMP_LT_OQ));
+      const __m256 knee_factor =
+          _mm256_mul_ps(_mm256_sub_ps(level, low_vec), inv_knee_vec);
+      result = _mm256_blendv_ps(result, _mm256_mul_ps(hard, knee_factor),
+                                in_knee);
+    }
+    _mm256_storeu_ps(&dest[i], result);
+  }
+  scalar::ComputeGainReductionDb(dest + simd_count, level_db + simd_count,
+                                 threshold_db, slope, knee_db,
+                                 count - simd_count);
+}
+
+void Fir(float* dest, const float* src, const float* taps, size_t num_taps,
+         size_t count) {
+  // Four independent sums per step hide the FMA latency
+  const size_t unrolled_count = count & ~size_t{31};
+  const size_t simd_count = count & ~size_t{7};
+  size_t i = 0;
+
+  for (; i < unrolled_count; i += 32) {
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+    __m256 sum2 = _mm256_setzero_ps();
+    __m256 sum3 = _mm256_setzero_ps();
+    for (size_t t = 0; t < num_taps; ++t) {
+      const __m256 tap = _mm256_set1_ps(taps[t]);
+      const float* x = src + i - t;
+      sum0 = _mm256_fmadd_ps(tap, _mm256_loadu_ps(x), sum0);
+      sum1 = _mm256_fmadd_ps(tap, _mm256_loadu_ps(x + 8), sum1);
+      sum2 = _mm256_fmadd_ps(tap, _mm256_loadu_ps(x + 16), sum2);
+      sum3 = _mm256_fmadd_ps(tap, _mm256_loadu_ps(x + 24), sum3);
+    }
+    _mm256_storeu_ps(&dest[i], sum0);
+    _mm256_storeu_ps(&dest[i + 8], sum1);
+    _mm256_storeu_ps(&dest[i + 16], sum2);
+    _mm256_storeu_ps(&dest[i + 24], sum3);
+  }
+  for (; i < simd_count; i += 8) {
+    __m256 sum = _mm256_setzero_ps();
+    for (size_t t = 0; t < num_taps; ++t) {
+      sum = _mm256_fmadd_ps(_mm256_set1_ps(taps[t]),
+                            _mm256_loadu_ps(src + i - t), sum);
+    }
+    _mm256_storeu_ps(&dest[i], sum);
+  }
+  scalar::Fir(dest + i, src + i, taps, num_taps, count - i);
+}
+
+}  // namespace
+}  // namespace avx2
+
+const KernelTable kAvx2Kernels = {
+    avx2::MultiplyAdd, avx2::Multiply,   avx2::ApplyGain,
+    avx2::ConvertToDb, avx2::LinearToDb, avx2::DbToLinear,
+    avx2::Max,         avx2::Min,        avx2::MaxAbs,
+    avx2::PeakAbs,     avx2::ComputeGainReductionDb, avx2::Fir,
+};
+
+}  // namespace simd
+}  // namespace stinky_dsp
@@ -0,0 +1,251 @@
+// Copyright 2025
+// Stinky DSP - AVX-512F kernels (this file alone is built with -mavx512f)
+
+#include "simd_kernels.h"
+
+#include <immintrin.h>
+
+#include "simd_utils.h"
+
+namespace stinky_dsp {
+namespace simd {
+namespace avx512 {
+namespace {
+
+// Lanes of the 16-wide step starting at `i` that lie inside `count`. Tails
+// use masked loads and stores, so no scalar remainder loop is needed.
+inline __mmask16 LaneMask(size_t i, size_t count) {
+  const size_t remaining = count - i;
+  return remaining >= 16 ? static_cast<__mmask16>(0xFFFF)
+                         : static_cast<__mmask16>((1u << remaining) - 1u);
+}
+
+// Vector forms of internal::FastLog2 / internal::FastExp2 (see simd_utils.h)
+inline __m512 Log2Avx512(__m512 x) {
+  const __m512i bits = _mm512_castps_si512(x);
+  const __m512 exponent = _mm512_cvtepi32_ps(
+      _mm512_sub_epi32(_mm512_srli_epi32(bits, 23), _mm512_set1_epi32(127)));
+  const __m512 m = _mm512_sub_ps(
+      _mm512_castsi512_ps(_mm512_or_si512(
+          _mm512_and_si512(bits, _mm512_set1_epi32(0x007FFFFF)),
+          _mm512_set1_epi32(0x3F800000))),
+      _mm512_set1_ps(1.0f));
+  __m512 poly = _mm512_set1_ps(internal::kLog2C5);
+  poly = _mm512_fmadd_ps(poly, m, _mm512_set1_ps(internal::kLog2C4));
+  poly = _mm512_fmadd_ps(poly, m, _mm512_set1_ps(internal::kLog2C3));
+  poly = _mm512_fmadd_ps(poly, m, _mm512_set1_ps(internal::kLog2C2));
+  poly = _mm512_fmadd_ps(poly, m, _mm512_set1_ps(internal::kLog2C1));
+  return _mm512_fmadd_ps(poly, m, exponent);
+}
+
+inline __m512 Exp2Avx512(__m512 x) {
+  x = _mm512_min_ps(_mm512_max_ps(x, _mm512_set1_ps(-internal::kMaxExp2)),
+                    _mm512_set1_ps(internal::kMaxExp2));
+  const __m512 n =
+      _mm512_roundscale_ps(x, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+  const __m512 f = _mm512_sub_ps(x, n);
+  __m512 poly = _mm512_set1_ps(internal::kExp2C4);
+  poly = _mm512_fmadd_ps(poly, f, _mm512_set1_ps(internal::kExp2C3));
+  poly = _mm512_fmadd_ps(poly, f, _mm512_set1_ps(internal::kExp2C2));
+  poly = _mm512_fmadd_ps(poly, f, _mm512_set1_ps(internal::kExp2C1));
+  poly = _mm512_fmadd_ps(poly, f, _mm512_set1_ps(1.0f));
+  const __m512i scale = _mm512_slli_epi32(
+      _mm512_add_epi32(_mm512_cvtps_epi32(n), _mm512_set1_epi32(127)), 23);
+  return _mm512_mul_ps(poly, _mm512_castsi512_ps(scale));
+}
+
+void MultiplyAdd(float* dest, const float* src, float multiplier,
+                 size_t count) {
+  const __m512 mult_vec = _mm512_set1_ps(multiplier);
+
+  for (size_t i = 0; i < count; i += 16) {
+    const __mmask16 k = LaneMask(i, count);
+    const __m512 src_vec = _mm512_maskz_loadu_ps(k, &src[i]);
+    const __m512 dest_vec = _mm512_maskz_loadu_ps(k, &dest[i]);
+    _mm512_mask_storeu_ps(&dest[i], k,
+                          _mm512_fmadd_ps(src_vec, mult_vec, dest_vec));
+  }
+}
+
+void Multiply(float* dest, const float* src, float multiplier, size_t count) {
+  const __m512 mult_vec = _mm512_set1_ps(multiplier);
+
+  for (size_t i = 0; i < count; i += 16) {
+    const __mmask16 k = LaneMask(i, count);
+    const __m512 src_vec = _mm512_maskz_loadu_ps(k, &src[i]);
+    _mm512_mask_storeu_ps(&dest[i], k, _mm512_mul_ps(src_vec, mult_vec));
+  }
+}
+
+void ApplyGain(float* buffer, float gain, size_t count) {
+  const __m512 gain_vec = _mm512_set1_ps(gain);
+
+  for (size_t i = 0; i < count; i += 16) {
+    const __mmask16 k = LaneMask(i, count);
+    const __m512 buf_vec = _mm512_maskz_loadu_ps(k, &buffer[i]);
+    _mm512_mask_storeu_ps(&buffer[i], k, _mm512_mul_ps(buf_vec, gain_vec));
+  }
+}
+
+void ConvertToDb(float* dest, const float* src, size_t count) {
+  const __m512 min_vec = _mm512_set1_ps(internal::kMinLinear);
+  const __m512 scale_vec = _mm512_set1_ps(internal::kDbPerLog2);
+
+  for (size_t i = 0; i < count; i += 16) {
+    const __mmask16 k = LaneMask(i, count);
+    __m512 vec = _mm512_abs_ps(_mm512_maskz_loadu_ps(k, &src[i]));
+    vec = Log2Avx512(_mm512_max_ps(vec, min_vec));
+    _mm512_mask_storeu_ps(&dest[i], k, _mm512_mul_ps(vec, scale_vec));
+  }
+}
+
+void LinearToDb(float* dest, const float* src, size_t count) {
+  const __m512 min_vec = _mm512_set1_ps(internal::kMinLinear);
+  const __m512 scale_vec = _mm512_set1_ps(internal::kDbPerLog2);
+
+  for (size_t i = 0; i < count; i += 16) {
+    const __mmask16 k = LaneMask(i, count);
+    __m512 vec = _mm512_max_ps(_mm512_maskz_loadu_ps(k, &src[i]), min_vec);
+    vec = Log2Avx512(vec);
+    _mm512_mask_storeu_ps(&dest[i], k, _mm512_mul_ps(vec, scale_vec));
+  }
+}
+
+void DbToLinear(float* dest, const float* src, size_t count) {
+  const __m512 scale_vec = _mm512_set1_ps(internal::kLog2PerDb);
+
+  for (size_t i = 0; i < count; i += 16) {
+    const __mmask16 k = LaneMask(i, count);
+    __m512 vec = _mm512_mul_ps(_mm512_maskz_loadu_ps(k, &src[i]), scale_vec);
+    _mm512_mask_storeu_ps(&dest[i], k, Exp2Avx512(vec));
+  }
+}
+
+void Max(float* dest, const float* src1, const float* src2, size_t count) {
+  for (size_t i = 0; i < count; i += 16) {
+    const __mmask16 k = LaneMask(i, count);
+    const __m512 vec1 = _mm512_maskz_loadu_ps(k, &src1[i]);
+    const __m512 vec2 = _mm512_maskz_loadu_ps(k, &src2[i]);
+    _mm512_mask_storeu_ps(&dest[i], k, _mm512_max_ps(vec1, vec2));
+  }
+}
+
+void Min(float* dest, const float* src1, const float* src2, size_t count) {
+  for (size_t i = 0; i < count; i += 16) {
+    const __mmask16 k = LaneMask(i, count);
+    const __m512 vec1 = _mm512_maskz_loadu_ps(k, &src1[i]);
+    const __m512 vec2 = _mm512_maskz_loadu_ps(k, &src2[i]);
+    _mm512_mask_storeu_ps(&dest[i], k, _mm512_min_ps(vec1, vec2));
+  }
+}
+
+void MaxAbs(float* dest, const float* src1, const float* src2, size_t count) {
+  for (size_t i = 0; i < count; i += 16) {
+    const __mmask16 k = LaneMask(i, count);
+    const __m512 vec1 = _mm512_abs_ps(_mm512_maskz_loadu_ps(k, &src1[i]));
+    const __m512 vec2 = _mm512_abs_ps(_mm512_maskz_loadu_ps(k, &src2[i]));
+    _mm512_mask_storeu_ps(&dest[i], k, _mm512_max_ps(vec1, vec2));
+  }
+}
+
+float PeakAbs(const float* src, size_t count) {
+  __m512 peak = _mm512_setzero_ps();
+  for (size_t i = 0; i < count; i += 16) {
+    const __mmask16 k = LaneMask(i, count);
+    peak = _mm512_max_ps(peak,
+                         _mm512_abs_ps(_mm512_maskz_loadu_ps(k, &src[i])));
+  }
+  // Reduce through memory: GCC's 512-bit extract and reduce intrinsics trip
+  // -Wuninitialized on their undefined pass-through operand
+  alignas(64) float lanes[16];
+  _mm512_store_ps(lanes, peak);
+  __m128 half =
+      _mm_max_ps(_mm_max_ps(_mm_load_ps(lanes), _mm_load_ps(lanes + 4)),
+                 _mm_max_ps(_mm_load_ps(lanes + 8), _mm_load_ps(lanes + 12)));
+  half = _mm_max_ps(half, _mm_movehl_ps(half, half));
+  half = _mm_max_ss(half, _mm_shuffle_ps(half, half, 1));
+  return _mm_cvtss_f32(half);
+}
+
+void ComputeGainReductionDb(float* dest, const float* level_db,
+                            float threshold_db, float slope, float knee_db,
+                            size_t count) {
+  const bool has_knee = knee_db > 0.0f;
+  const __m512 threshold_vec = _mm512_set1_ps(threshold_db);
+  const __m512 slope_vec = _mm512_set1_ps(slope);
+  const __m512 low_vec = _mm512_set1_ps(threshold_db - knee_db / 2.0f);
+  const __m512 high_vec = _mm512_set1_ps(threshold_db + knee_db / 2.0f);
+  const __m512 inv_knee_vec =
+      _mm512_set1_ps(has_knee ? 1.0f / knee_db : 0.0f);
+
+  for (size_t i = 0; i < count; i += 16) {
+    const __mmask16 k = LaneMask(i, count);
+    const __m512 level = _mm512_maskz_loadu_ps(k, &level_db[i]);
+    const __m512 hard =
+        _mm512_mul_ps(_mm512_sub_ps(level, threshold_vec), slope_vec);
+
+    // Hard knee: gain change only above threshold
+    const __mmask16 above =
+        _mm512_cmp_ps_mask(level, threshold_vec, _CMP_GT_OQ);
+    __m512 result = _mm512_maskz_mov_ps(above, hard);
+
+    if (has_knee) {
+      // Soft knee region overrides the hard curve inside the knee
+      const __mmask16 in_knee = _mm512_mask_cmp_ps_mask(
+          _mm512_cmp_ps_mask(level, low_vec, _CMP_GT_OQ), level, high_vec,
+          _CMP_LT_OQ);
+      const __m512 knee_factor =
+          _mm512_mul_ps(_mm512_sub_ps(level, low_vec), inv_knee_vec);
+      result = _mm512_mask_mul_ps(result, in_knee, hard, knee_factor);
+    }
+    _mm512_mask_storeu_ps(&dest[i], k, result);
+  }
+}
+
+void Fir(float* dest, const float* src, const float* taps, size_t num_taps,
+         size_t count) {
+  // Four independent sums per step hide the FMA latency
+  const size_t unrolled_count = count & ~size_t{63};
+  size_t i = 0;
+
+  for (; i < unrolled_count; i += 64) {
+    __m512 sum0 = _mm512_setzero_ps();
+    __m512 sum1 = _mm512_setzero_ps();
+    __m512 sum2 = _mm512_setzero_ps();
+    __m512 sum3 = _mm512_setzero_ps();
+    for (size_t t = 0; t < num_taps; ++t) {
+      const __m512 tap = _mm512_set1_ps(taps[t]);
+      const float* x = src + i - t;
+      sum0 = _mm512_fmadd_ps(tap, _mm512_loadu_ps(x), sum0);
+      sum1 = _mm512_fmadd_ps(tap, _mm512_loadu_ps(x + 16), sum1);
+      sum2 = _mm512_fmadd_ps(tap, _mm512_loadu_ps(x + 32), sum2);
+      sum3 = _mm512_fmadd_ps(tap, _mm512_loadu_ps(x + 48), sum3);
+    }
+    _mm512_storeu_ps(&dest[i], sum0);
+    _mm512_storeu_ps(&dest[i + 16], sum1);
+    _mm512_storeu_ps(&dest[i + 32], sum2);
+    _mm512_storeu_ps(&dest[i + 48], sum3);
+  }
+  for (; i < count; i += 16) {
+    const __mmask16 k = LaneMask(i, count);
+    __m512 sum = _mm512_setzero_ps();
+    for (size_t t = 0; t < num_taps; ++t) {
+      sum = _mm512_fmadd_ps(_mm512_set1_ps(taps[t]),
+                            _mm512_maskz_loadu_ps(k, src + i - t), sum);
+    }
+    _mm512_mask_storeu_ps(&dest[i], k, sum);
+  }
+}
+
+}  // namespace
+}  // namespace avx512
+
+const KernelTable kAvx512Kernels = {
+    avx512::MultiplyAdd, avx512::Multiply,   avx512::ApplyGain,
+    avx512::ConvertToDb, avx512::LinearToDb, avx512::DbToLinear,
+    avx512::Max,         avx512::Min,        avx512::MaxAbs,
+    avx512::PeakAbs,     avx512::ComputeGainReductionDb, avx512::Fir,
+};
+
+}  // namespace simd
+}  // namespace stinky_dsp
@@ -0,0 +1,126 @@
+// Copyright 2025
+// Stinky DSP - Scalar kernels (portable fallback and vector loop tails)
+
+#include "simd_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "simd_utils.h"
+
+namespace stinky_dsp {
+namespace simd {
+namespace scalar {
+
+void MultiplyAdd(float* dest, const float* src, float multiplier,
+                 size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    dest[i] += src[i] * multiplier;
+  }
+}
+
+void Multiply(float* dest, const float* src, float multiplier, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    dest[i] = src[i] * multiplier;
+  }
+}
+
+void ApplyGain(float* buffer, float gain, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    buffer[i] *= gain;
+  }
+}
+
+void ConvertToDb(float* dest, const float* src, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    dest[i] = simd::LinearToDb(std::abs(src[i]));
+  }
+}
+
+void LinearToDb(float* dest, const float* src, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    dest[i] = simd::LinearToDb(src[i]);
+  }
+}
+
+void DbToLinear(float* dest, const float* src, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    dest[i] = simd::DbToLinear(src[i]);
+  }
+}
+
+void Max(float* dest, const float* src1, const float* src2, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    dest[i] = std::max(src1[i], src2[i]);
+  }
+}
+
+void Min(float* dest, const float* src1, const float* src2, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    dest[i] = std::min(src1[i], src2[i]);
+  }
+}
+
+void MaxAbs(float* dest, const float* src1, const float* src2, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    dest[i] = std::max(std::abs(src1[i]), std::abs(src2[i]));
+  }
+}
+
+float PeakAbs(const float* src, size_t count) {
+  float peak = 0.0f;
+  for (size_t i = 0; i < count; ++i) {
+    peak = std::max(peak, std::abs(src[i]));
+  }
+  return peak;
+}
+
+void ComputeGainReductionDb(float* dest, const float* level_db,
+                            float threshold_db, float slope, float knee_db,
+                            size_t count) {
+  // The knee test is hoisted so each curve runs its own loop
+  if (knee_db <= 0.0f) {
+    for (size_t i = 0; i < count; ++i) {
+      const float overshoot = level_db[i] - threshold_db;
+      dest[i] = (overshoot > 0.0f) ? overshoot * slope : 0.0f;
+    }
+    return;
+  }
+
+  const float knee_low = threshold_db - knee_db / 2.0f;
+  const float knee_high = threshold_db + knee_db / 2.0f;
+  const float inv_knee = 1.0f / knee_db;
+  for (size_t i = 0; i < count; ++i) {
+    const float level = level_db[i];
+    const float overshoot = level - threshold_db;
+    if (level > knee_low && level < knee_high) {
+      dest[i] = overshoot * slope * ((level - knee_low) * inv_knee);
+    } else {
+      dest[i] = (level > threshold_db) ? overshoot * slope : 0.0f;
+    }
+  }
+}
+
+void Fir(float* dest, const float* src, const float* taps, size_t num_taps,
+         size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    const float* x = src + i;
+    float sum = 0.0f;
+    for (size_t t = 0; t < num_taps; ++t) {
+      sum += taps[t] * *(x - t);
+    }
+    dest[i] = sum;
+  }
+}
+
+}  // namespace scalar
+
+const KernelTable kScalarKernels = {
+    scalar::MultiplyAdd, scalar::Multiply,   scalar::ApplyGain,
+    scalar::ConvertToDb, scalar::LinearToDb, scalar::DbToLinear,
+    scalar::Max,         scalar::Min,        scalar::MaxAbs,
+    scalar::PeakAbs,     scalar::ComputeGainReductionDb, scalar::Fir,
+};
+
+}  // namespace simd
+}  // namespace stinky_dsp
@@ -0,0 +1,258 @@
+// Copyright 2025
+// Stinky DSP - SSE2 kernels (x86-64 baseline, no extra compile flags)
+
+#include "simd_kernels.h"
+
+#include <emmintrin.h>
+
+#include "simd_utils.h"
+
+namespace stinky_dsp {
+namespace simd {
+namespace sse2 {
+namespace {
+
+// Vector forms of internal::FastLog2 / internal::FastExp2 (see simd_utils.h)
+inline __m128 Log2Sse(__m128 x) {
+  const __m128i bits = _mm_castps_si128(x);
+  const __m128 exponent = _mm_cvtepi32_ps(
+      _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127)));
+  const __m128 m = _mm_sub_ps(
+      _mm_castsi128_ps(_mm_or_si128(
+          _mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)),
+          _mm_set1_epi32(0x3F800000))),
+      _mm_set1_ps(1.0f));
+  __m128 poly = _mm_set1_ps(internal::kLog2C5);
+  poly = _mm_add_ps(_mm_mul_ps(poly, m), _mm_set1_ps(internal::kLog2C4));
+  poly = _mm_add_ps(_mm_mul_ps(poly, m), _mm_set1_ps(internal::kLog2C3));
+  poly = _mm_add_ps(_mm_mul_ps(poly, m), _mm_set1_ps(internal::kLog2C2));
+  poly = _mm_add_ps(_mm_mul_ps(poly, m), _mm_set1_ps(internal::kLog2C1));
+  return _mm_add_ps(_mm_mul_ps(poly, m), exponent);
+}
+
+inline __m128 Exp2Sse(__m128 x) {
+  x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(-internal::kMaxExp2)),
+                 _mm_set1_ps(internal::kMaxExp2));
+  // SSE2 has no floor: truncate, then step down where truncation rounded up
+  __m128 n = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+  n = _mm_sub_ps(n, _mm_and_ps(_mm_cmplt_ps(x, n), _mm_set1_ps(1.0f)));
+  const __m128 f = _mm_sub_ps(x, n);
+  __m128 poly = _mm_set1_ps(internal::kExp2C4);
+  poly = _mm_add_ps(_mm_mul_ps(poly, f), _mm_set1_ps(internal::kExp2C3));
+  poly = _mm_add_ps(_mm_mul_ps(poly, f), _mm_set1_ps(internal::kExp2C2));
+  poly = _mm_add_ps(_mm_mul_ps(poly, f), _mm_set1_ps(internal::kExp2C1));
+  poly = _mm_add_ps(_mm_mul_ps(poly, f), _mm_set1_ps(1.0f));
+  const __m128i scale = _mm_slli_epi32(
+      _mm_add_epi32(_mm_cvttps_epi32(n), _mm_set1_epi32(127)), 23);
+  return _mm_mul_ps(poly, _mm_castsi128_ps(scale));
+}
+
+// mask ? b : a (SSE2 has no blendv)
+inline __m128 Select(__m128 mask, __m128 a, __m128 b) {
+  return _mm_or_ps(_mm_and_ps(mask, b), _mm_andnot_ps(mask, a));
+}
+
+void MultiplyAdd(float* dest, const float* src, float multiplier,
+                 size_t count) {
+  const size_t simd_count = count & ~size_t{3};
+  const __m128 mult_vec = _mm_set1_ps(multiplier);
+
+  for (size_t i = 0; i < simd_count; i += 4) {
+    const __m128 product = _mm_mul_ps(_mm_loadu_ps(&src[i]), mult_vec);
+    _mm_storeu_ps(&dest[i], _mm_add_ps(_mm_loadu_ps(&dest[i]), product));
+  }
+  scalar::MultiplyAdd(dest + simd_count, src + simd_count, multiplier,
+                      count - simd_count);
+}
+
+void Multiply(float* dest, const float* src, float multiplier, size_t count) {
+  const size_t simd_count = count & ~size_t{3};
+  const __m128 mult_vec = _mm_set1_ps(multiplier);
+
+  for (size_t i = 0; i < simd_count; i += 4) {
+    _mm_storeu_ps(&dest[i], _mm_mul_ps(_mm_loadu_ps(&src[i]), mult_vec));
+  }
+  scalar::Multiply(dest + simd_count, src + simd_count, multiplier,
+                   count - simd_count);
+}
+
+void ApplyGain(float* buffer, float gain, size_t count) {
+  const size_t simd_count = count & ~size_t{3};
+  const __m128 gain_vec = _mm_set1_ps(gain);
+
+  for (size_t i = 0; i < simd_count; i += 4) {
+    _mm_storeu_ps(&buffer[i], _mm_mul_ps(_mm_loadu_ps(&buffer[i]), gain_vec));
+  }
+  scalar::ApplyGain(buffer + simd_count, gain, count - simd_count);
+}
+
+void ConvertToDb(float* dest, const float* src, size_t count) {
+  const size_t simd_count = count & ~size_t{3};
+  const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+  const __m128 min_vec = _mm_set1_ps(internal::kMinLinear);
+  const __m128 scale_vec = _mm_set1_ps(internal::kDbPerLog2);
+
+  for (size_t i = 0; i < simd_count; i += 4) {
+    __m128 vec = _mm_and_ps(_mm_loadu_ps(&src[i]), abs_mask);
+    vec = Log2Sse(_mm_max_ps(vec, min_vec));
+    _mm_storeu_ps(&dest[i], _mm_mul_ps(vec, scale_vec));
+  }
+  scalar::ConvertToDb(dest + simd_count, src + simd_count,
+                      count - simd_count);
+}
+
+void LinearToDb(float* dest, const float* src, size_t count) {
+  const size_t simd_count = count & ~size_t{3};
+  const __m128 min_vec = _mm_set1_ps(internal::kMinLinear);
+  const __m128 scale_vec = _mm_set1_ps(internal::kDbPerLog2);
+
+  for (size_t i = 0; i < simd_count; i += 4) {
+    __m128 vec = Log2Sse(_mm_max_ps(_mm_loadu_ps(&src[i]), min_vec));
+    _mm_storeu_ps(&dest[i], _mm_mul_ps(vec, scale_vec));
+  }
+  scalar::LinearToDb(dest + simd_count, src + simd_count, count - simd_count);
+}
+
+void DbToLinear(float* dest, const float* src, size_t count) {
+  const size_t simd_count = count & ~size_t{3};
+  const __m128 scale_vec = _mm_set1_ps(internal::kLog2PerDb);
+
+  for (size_t i = 0; i < simd_count; i += 4) {
+    __m128 vec = _mm_mul_ps(_mm_loadu_ps(&src[i]), scale_vec);
+    _mm_storeu_ps(&dest[i], Exp2Sse(vec));
+  }
+  scalar::DbToLinear(dest + simd_count, src + simd_count, count - simd_count);
+}
+
+void Max(float* dest, const float* src1, const float* src2, size_t count) {
+  const size_t simd_count = count & ~size_t{3};
+
+  for (size_t i = 0; i < simd_count; i += 4) {
+    _mm_storeu_ps(&dest[i],
+                  _mm_max_ps(_mm_loadu_ps(&src1[i]), _mm_loadu_ps(&src2[i])));
+  }
+  scalar::Max(dest + simd_count, src1 + simd_count, src2 + simd_count,
+              count - simd_count);
+}
+
+void Min(float* dest, const float* src1, const float* src2, size_t count) {
+  const size_t simd_count = count & ~size_t{3};
+
+  for (size_t i = 0; i < simd_count; i += 4) {
+    _mm_storeu_ps(&dest[i],
+                  _mm_min_ps(_mm_loadu_ps(&src1[i]), _mm_loadu_ps(&src2[i])));
+  }
+  scalar::Min(dest + simd_count, src1 + simd_count, src2 + simd_count,
+              count - simd_count);
+}
+
+void MaxAbs(float* dest, const float* src1, const float* src2, size_t count) {
+  const size_t simd_count = count & ~size_t{3};
+  const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+  for (size_t i = 0; i < simd_count; i += 4) {
+    const __m128 vec1 = _mm_and_ps(_mm_loadu_ps(&src1[i]), abs_mask);
+    const __m128 vec2 = _mm_and_ps(_mm_loadu_ps(&src2[i]), abs_mask);
+    _mm_storeu_ps(&dest[i], _mm_max_ps(vec1, vec2));
+  }
+  scalar::MaxAbs(dest + simd_count, src1 + simd_count, src2 + simd_count,
+                 count - simd_count);
+}
+
+float PeakAbs(const float* src, size_t count) {
+  const size_t simd_count = count & ~size_t{3};
+  const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+  __m128 peak = _mm_setzero_ps();
+
+  for (size_t i = 0; i < simd_count; i += 4) {
+    peak = _mm_max_ps(peak, _mm_and_ps(_mm_loadu_ps(&src[i]), abs_mask));
+  }
+  peak = _mm_max_ps(peak, _mm_set1_ps(scalar::PeakAbs(
+                               src + simd_count, count - simd_count)));
+  peak = _mm_max_ps(peak, _mm_movehl_ps(peak, peak));
+  peak = _mm_max_ss(peak, _mm_shuffle_ps(peak, peak, 1));
+  return _mm_cvtss_f32(peak);
+}
+
+void ComputeGainReductionDb(float* dest, const float* level_db,
+                            float threshold_db, float slope, float knee_db,
+                            size_t count) {
+  const size_t simd_count = count & ~size_t{3};
+  const bool has_knee = knee_db > 0.0f;
+  const __m128 threshold_vec = _mm_set1_ps(threshold_db);
+  const __m128 slope_vec = _mm_set1_ps(slope);
+  const __m128 low_vec = _mm_set1_ps(threshold_db - knee_db / 2.0f);
+  const __m128 high_vec = _mm_set1_ps(threshold_db + knee_db / 2.0f);
+  const __m128 inv_knee_vec = _mm_set1_ps(has_knee ? 1.0f / knee_db : 0.0f);
+
+  for (size_t i = 0; i < simd_count; i += 4) {
+    const __m128 level = _mm_loadu_ps(&level_db[i]);
+    const __m128 hard =
+        _mm_mul_ps(_mm_sub_ps(level, threshold_vec), slope_vec);
+
+    // Hard knee: gain change only above threshold
+    __m128 result = _mm_and_ps(_mm_cmpgt_ps(level, threshold_vec), hard);
+
+    if (has_knee) {
+      // Soft knee region overrides the hard curve inside the knee
+      const __m128 in_knee = _mm_and_ps(_mm_cmpgt_ps(level, low_vec),
+                                        _mm_cmplt_ps(level, high_vec));
+      const __m128 knee_factor =
+          _mm_mul_ps(_mm_sub_ps(level, low_vec), inv_knee_vec);
+      result = Select(in_knee, result, _mm_mul_ps(hard, knee_factor));
+    }
+    _mm_storeu_ps(&dest[i], result);
+  }
+  scalar::ComputeGainReductionDb(dest + simd_count, level_db + simd_count,
+                                 threshold_db, slope, knee_db,
+                                 count - simd_count);
+}
+
+void Fir(float* dest, const float* src, const float* taps, size_t num_taps,
+         size_t count) {
+  // Four independent sums per step keep the adds from waiting on each other
+  const size_t unrolled_count = count & ~size_t{15};
+  const size_t simd_count = count & ~size_t{3};
+  size_t i = 0;
+
+  for (; i < unrolled_count; i += 16) {
+    __m128 sum0 = _mm_setzero_ps();
+    __m128 sum1 = _mm_setzero_ps();
+    __m128 sum2 = _mm_setzero_ps();
+    __m128 sum3 = _mm_setzero_ps();
+    for (size_t t = 0; t < num_taps; ++t) {
+      const __m128 tap = _mm_set1_ps(taps[t]);
+      const float* x = src + i - t;
+      sum0 = _mm_add_ps(sum0, _mm_mul_ps(tap, _mm_loadu_ps(x)));
+      sum1 = _mm_add_ps(sum1, _mm_mul_ps(tap, _mm_loadu_ps(x + 4)));
+      sum2 = _mm_add_ps(sum2, _mm_mul_ps(tap, _mm_loadu_ps(x + 8)));
+      sum3 = _mm_add_ps(sum3, _mm_mul_ps(tap, _mm_loadu_ps(x + 12)));
+    }
+    _mm_storeu_ps(&dest[i], sum0);
+    _mm_storeu_ps(&dest[i + 4], sum1);
+    _mm_storeu_ps(&dest[i + 8], sum2);
+    _mm_storeu_ps(&dest[i + 12], sum3);
+  }
+  for (; i < simd_count; i += 4) {
+    __m128 sum = _mm_setzero_ps();
+    for (size_t t = 0; t < num_taps; ++t) {
+      sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(taps[t]),
+                                       _mm_loadu_ps(src + i - t)));
+    }
+    _mm_storeu_ps(&dest[i], sum);
+  }
+  scalar::Fir(dest + i, src + i, taps, num_taps, count - i);
+}
+
+}  // namespace
+}  // namespace sse2
+
+const KernelTable kSse2Kernels = {
+    sse2::MultiplyAdd, sse2::Multiply,   sse2::ApplyGain,
+    sse2::ConvertToDb, sse2::LinearToDb, sse2::DbToLinear,
+    sse2::Max,         sse2::Min,        sse2::MaxAbs,
+    sse2::PeakAbs,     sse2::ComputeGainReductionDb, sse2::Fir,
+};
+
+}  // namespace simd
+}  // namespace stinky_dsp
@@ -0,0 +1,230 @@
+// Copyright 2025
+// Stinky DSP - SIMD Utilities Implementation (runtime kernel dispatch)
+
+#include "simd_utils.h"
+
+#include <atomic>
+#include <mutex>
+
+#include "simd_kernels.h"
+
+#ifdef USE_SIMD
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+namespace stinky_dsp {
+namespace simd {
+
+namespace {
+
+#ifdef USE_SIMD
+// SSE2 is part of x86-64, so it is safe before Initialize() runs
+constexpr Isa kBaselineIsa = Isa::kSse2;
+#else
+constexpr Isa kBaselineIsa = Isa::kScalar;
+#endif
+
+constexpr const KernelTable* TableFor(Isa isa) {
+  switch (isa) {
+#ifdef USE_SIMD
+    case Isa::kAvx512:
+      return &kAvx512Kernels;
+    case Isa::kAvx2:
+      return &kAvx2Kernels;
+    case Isa::kSse2:
+      return &kSse2Kernels;
+#endif
+    default:
+      return &kScalarKernels;
+  }
+}
+
+// Constant-initialized, so kernels called during static init are safe. The
+// tables are immutable, so a relaxed load is all a kernel call needs: one
+// plain load and an indirect call, no capability branch.
+constinit std::atomic<const KernelTable*> g_kernels{TableFor(kBaselineIsa)};
+constinit std::atomic<Isa> g_active_isa{kBaselineIsa};
+
+std::once_flag g_init_once;
+
+inline const KernelTable& Kernels() {
+  return *g_kernels.load(std::memory_order_relaxed);
+}
+
+#ifdef USE_SIMD
+// AVX state must also be enabled by the OS (XCR0), not just the CPU
+Isa DetectCpuIsa() {
+#if defined(_MSC_VER)
+  int cpu_info[4];
+  __cpuid(cpu_info, 0);
+  const int num_ids = cpu_info[0];
+
+  __cpuid(cpu_info, 1);
+  const bool has_fma = (cpu_info[2] & (1 << 12)) != 0;
+  const bool has_osxsave = (cpu_info[2] & (1 << 27)) != 0;
+  if (num_ids < 7 || !has_osxsave) return Isa::kSse2;
+
+  const unsigned long long xcr0 = _xgetbv(0);
+  const bool ymm_enabled = (xcr0 & 0x6) == 0x6;
+  const bool zmm_enabled = (xcr0 & 0xE6) == 0xE6;
+
+  __cpuidex(cpu_info, 7, 0);
+  // EBX bit 5: AVX2, bit 16: AVX-512F
+  const bool has_avx2 = (cpu_info[1] & (1 << 5)) != 0;
+  const bool has_avx512f = (cpu_info[1] & (1 << 16)) != 0;
+
+  if (has_avx512f && has_fma && zmm_enabled) return Isa::kAvx512;
+  if (has_avx2 && has_fma && ymm_enabled) return Isa::kAvx2;
+  return Isa::kSse2;
+#else
+  // The builtins check OS support for the extended register state
+  __builtin_cpu_init();
+  const bool has_fma = __builtin_cpu_supports("fma");
+  if (__builtin_cpu_supports("avx512f") && has_fma) return Isa::kAvx512;
+  if (__builtin_cpu_supports("avx2") && has_fma) return Isa::kAvx2;
+  return Isa::kSse2;
+#endif
+}
+#endif
+
+}  // namespace
+
+void Initialize() {
+  // Plugin instances may load from several threads; detect and select once
+  std::call_once(g_init_once, [] { SetIsa(DetectIsa()); });
+}
+
+Isa DetectIsa() {
+#ifdef USE_SIMD
+  static const Isa detected = DetectCpuIsa();
+  return detected;
+#else
+  return Isa::kScalar;
+#endif
+}
+
+Isa ActiveIsa() {
+  return g_active_isa.load(std::memory_order_relaxed);
+}
+
+bool SetIsa(Isa isa) {
+  if (isa > DetectIsa()) return false;
+
+  g_kernels.store(TableFor(isa), std::memory_order_relaxed);
+  g_active_isa.store(isa, std::memory_order_relaxed);
+  return true;
+}
+
+const char* IsaName(Isa isa) {
+  switch (isa) {
+    case Isa::kScalar:
+      return "scalar";
+    case Isa::kSse2:
+      return "sse2";
+    case Isa::kAvx2:
+      return "avx2";
+    case Isa::kAvx512:
+      return "avx512";
+  }
+  return "unknown";
+}
+
+bool IsSimdAvailable() {
+  return DetectIsa() != Isa::kScalar;
+}
+
+void MultiplyAdd(float* dest, const float* src, float multiplier,
+                 size_t count) {
+  Kernels().multiply_add(dest, src, multiplier, count);
+}
+
+void Multiply(float* dest, const float* src, float multiplier, size_t count) {
+  Kernels().multiply(dest, src, multiplier, count);
+}
+
+void ApplyGain(float* buffer, float gain, size_t count) {
+  Kernels().apply_gain(buffer, gain, count);
+}
+
+void ConvertToDb(float* dest, const float* src, size_t count) {
+  Kernels().convert_to_db(dest, src, count);
+}
+
+void LinearToDb(float* dest, const float* src, size_t count) {
+  Kernels().linear_to_db(dest, src, count);
+}
+
+void DbToLinear(float* dest, const float* src, size_t count) {
+  Kernels().db_to_linear(dest, src, count);
+}
+
+void Max(float* dest, const float* src1, const float* src2, size_t count) {
+  Kernels().max(dest, src1, src2, count);
+}
+
+void Min(float* dest, const float* src1, const float* src2, size_t count) {
+  Kernels().min(dest, src1, src2, count);
+}
+
+void MaxAbs(float* dest, const float* src1, const float* src2, size_t count) {
+  Kernels().max_abs(dest, src1, src2, count);
+}
+
+float PeakAbs(const float* src, size_t count) {
+  return Kernels().peak_abs(src, count);
+}
+
+void MaxAbs(float* dest, const float* const* channels, uint32_t num_channels,
+            size_t count) {
+  // dest is non-negative, so folding it back in keeps the running maximum
+  const KernelTable& kernels = Kernels();
+  kernels.max_abs(dest, channels[0], channels[num_channels > 1 ? 1 : 0],
+                  count);
+  for (uint32_t channel = 2; channel < num_channels; ++channel) {
+    kernels.max_abs(dest, dest, channels[channel], count);
+  }
+}
+
+void MaxAbs(float* dest, const double* src1, const double* src2,
+            size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    dest[i] = static_cast<float>(
+        std::max(std::abs(src1[i]), std::abs(src2[i])));
+  }
+}
+
+void MaxAbs(float* dest, const double* const* channels,
+            uint32_t num_channels, size_t count) {
+  MaxAbs(dest, channels[0], channels[num_channels > 1 ? 1 : 0], count);
+  for (uint32_t channel = 2; channel < num_channels; ++channel) {
+    const double* src = channels[channel];
+    for (size_t i = 0; i < count; ++i) {
+      dest[i] = std::max(dest[i], static_cast<float>(std::abs(src[i])));
+    }
+  }
+}
+
+double PeakAbs(const double* src, size_t count) {
+  double peak = 0.0;
+  for (size_t i = 0; i < count; ++i) {
+    peak = std::max(peak, std::abs(src[i]));
+  }
+  return peak;
+}
+
+void ComputeGainReductionDb(float* dest, const float* level_db,
+                            float threshold_db, float slope, float knee_db,
+                            size_t count) {
+  Kernels().compute_gain_reduction_db(dest, level_db, threshold_db, slope,
+                                       knee_db, count);
+}
+
+void Fir(float* dest, const float* src, const float* taps, size_t num_taps,
+         size_t count) {
+  Kernels().fir(dest, src, taps, num_taps, count);
+}
+
+}  // namespace simd
+}  // namespace stinky_dsp
@@ -0,0 +1,48 @@
+// Copyright 2025
+// Stinky DSP - Running maximum and mean implementation
+
+#include "sliding_window.h"
+
+#include <algorithm>
+
+namespace stinky_dsp {
+
+SlidingMax::SlidingMax(size_t max_window)
+    : values_(std::max<size_t>(max_window, 1)),
+      expiry_(values_.size()),
+      window_(1),
+      front_(0),
+      size_(0),
+      count_(0) {}
+
+void SlidingMax::SetWindow(size_t window) {
+  window_ = std::clamp<size_t>(window, 1, values_.size());
+  Reset();
+}
+
+void SlidingMax::Reset() {
+  front_ = 0;
+  size_ = 0;
+  count_ = 0;
+}
+
+MovingAverage::MovingAverage(size_t max_window)
+    : history_(std::max<size_t>(max_window, 1)),
+      sum_(0.0),
+      inv_window_(1.0),
+      window_(1),
+      pos_(0) {}
+
+void MovingAverage::SetWindow(size_t window, float value) {
+  window_ = std::clamp<size_t>(window, 1, history_.size());
+  inv_window_ = 1.0 / static_cast<double>(window_);
+  Reset(value);
+}
+
+void MovingAverage::Reset(float value) {
+  std::fill(history_.begin(), history_.begin() + window_, value);
+  sum_ = static_cast<double>(value) * static_cast<double>(window_);
+  pos_ = 0;
+}
+
+}  // namespace stinky_dsp
@@ -0,0 +1,85 @@
+// Copyright 2025
+// Stinky DSP - Parameter smoothing implementation
+
+#include "smoother.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace stinky_dsp {
+
+namespace {
+
+// One-pole ramps are within -60 dB of the step when they snap to the target
+constexpr double kOnePoleResidual = 1e-3;
+
+}  // namespace
+
+Smoother::Smoother()
+    : type_(SmoothingType::kLinear),
+      ramp_samples_(0),
+      remaining_(0),
+      current_(0.0f),
+      target_(0.0f),
+      step_(0.0f),
+      pole_(0.0f) {}
+
+void Smoother::Configure(SmoothingType type, double sample_rate,
+                         double ramp_ms) {
+  type_ = type;
+  ramp_samples_ = static_cast<uint32_t>(
+      std::lround(std::max(0.0, ramp_ms) * 0.001 * sample_rate));
+  pole_ = ramp_samples_ > 0
+              ? static_cast<float>(std::exp(std::log(kOnePoleResidual) /
+                                            ramp_samples_))
+              : 0.0f;
+  Reset(target_);
+}
+
+void Smoother::Reset(float value) {
+  current_ = value;
+  target_ = value;
+  remaining_ = 0;
+}
+
+void Smoother::SetTarget(float target) {
+  if (target == target_) return;
+
+  target_ = target;
+  if (ramp_samples_ == 0 || current_ == target) {
+    current_ = target;
+    remaining_ = 0;
+    return;
+  }
+  remaining_ = ramp_samples_;
+  step_ = (target_ - current_) / static_cast<float>(ramp_samples_);
+}
+
+float Smoother::Advance(size_t num_frames) {
+  if (remaining_ == 0) return current_;
+
+  if (num_frames >= remaining_) {
+    current_ = target_;
+    remaining_ = 0;
+    return current_;
+  }
+
+  remaining_ -= static_cast<uint32_t>(num_frames);
+  if (type_ == SmoothingType::kLinear) {
+    current_ += step_ * static_cast<float>(num_frames);
+  } else {
+    current_ = target_ + (current_ - target_) *
+                             std::pow(pole_, static_cast<float>(num_frames));
+  }
+  return current_;
+}
+
+void Smoother::Process(float* dest, size_t num_frames) {
+  size_t i = 0;
+  for (; i < num_frames && remaining_ != 0; ++i) {
+    dest[i] = Next();
+  }
+  std::fill(dest + i, dest + num_frames, current_);
+}
+
+}  // namespace stinky_dsp
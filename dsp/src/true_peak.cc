@@ -0,0 +1,69 @@
+// Copyright 2025
+// Stinky DSP - Oversampled true-peak level implementation
+
+#include "true_peak.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "simd_utils.h"
+
+namespace stinky_dsp {
+
+namespace {
+
+// ITU-R BS.1770-4 Annex 2 interpolation filter, one row per phase. Phase p
+// lands (p + 0.5) / 4 of a frame past frame n - kDelay.
+constexpr float kCoefficients[TruePeakDetector::kOversampling]
+                             [TruePeakDetector::kTaps] = {
+    {0.0017089843750f, 0.0109863281250f, -0.0196533203125f, 0.0332031250000f,
+     -0.0594482421875f, 0.1373291015625f, 0.9721679687500f, -0.1022949218750f,
+     0.0476074218750f, -0.0266113281250f, 0.0148925781250f, -0.0083007812500f},
+    {-0.0291748046875f, 0.0292968750000f, -0.0517578125000f, 0.0891113281250f,
+     -0.1665039062500f, 0.4650878906250f, 0.7797851562500f, -0.2003173828125f,
+     0.1015625000000f, -0.0582275390625f, 0.0330810546875f, -0.0189208984375f},
+    {-0.0189208984375f, 0.0330810546875f, -0.0582275390625f, 0.1015625000000f,
+     -0.2003173828125f, 0.7797851562500f, 0.4650878906250f, -0.1665039062500f,
+     0.0891113281250f, -0.0517578125000f, 0.0292968750000f, -0.0291748046875f},
+    {-0.0083007812500f, 0.0148925781250f, -0.0266113281250f, 0.0476074218750f,
+     -0.1022949218750f, 0.9721679687500f, 0.1373291015625f, -0.0594482421875f,
+     0.0332031250000f, -0.0196533203125f, 0.0109863281250f, 0.0017089843750f},
+};
+
+}  // namespace
+
+TruePeakDetector::TruePeakDetector() { Reset(); }
+
+void TruePeakDetector::Reset() {
+  for (float* history : history_) {
+    std::fill(history, history + kTaps - 1, 0.0f);
+  }
+}
+
+template <typename T>
+void TruePeakDetector::Process(float* dest, const T* const* channels,
+                               uint32_t num_channels, size_t num_frames) {
+  std::fill(dest, dest + num_frames, 0.0f);
+  for (uint32_t channel = 0; channel < num_channels; ++channel) {
+    float* history = history_[channel];
+    float* frames = history + kTaps - 1;  // frames[i - tap] is x[i - tap]
+    std::copy(channels[channel], channels[channel] + num_frames, frames);
+
+    // dest is non-negative, so folding it back in keeps the running maximum
+    simd::MaxAbs(dest, dest, frames - kDelay, num_frames);
+    for (uint32_t phase = 0; phase < kOversampling; ++phase) {
+      simd::Fir(phase_, frames, kCoefficients[phase], kTaps, num_frames);
+      simd::MaxAbs(dest, dest, phase_, num_frames);
+    }
+
+    // Keep the newest kTaps - 1 frames for the next block
+    std::memmove(history, history + num_frames, (kTaps - 1) * sizeof(float));
+  }
+}
+
+template void TruePeakDetector::Process(float*, const float* const*, uint32_t,
+                                        size_t);
+template void TruePeakDetector::Process(float*, const double* const*,
+                                        uint32_t, size_t);
+
+}  // namespace stinky_dsp
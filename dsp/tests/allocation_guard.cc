@@ -0,0 +1,136 @@
+// Copyright 2025
+// Counting replacements for the global operator new and delete
+
+#include "allocation_guard.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace stinky_dsp {
+
+namespace {
+
+// Plain thread_locals, so the operators never trigger dynamic initialization
+thread_local int t_active_guards = 0;
+thread_local uint64_t t_allocations = 0;
+thread_local uint64_t t_frees = 0;
+
+void* Allocate(size_t size) noexcept {
+  if (t_active_guards > 0) ++t_allocations;
+  return std::malloc(size > 0 ? size : 1);
+}
+
+void* AllocateAligned(size_t size, std::align_val_t alignment) noexcept {
+  if (t_active_guards > 0) ++t_allocations;
+  const size_t align =
+      std::max(static_cast<size_t>(alignment), alignof(std::max_align_t));
+#ifdef _WIN32
+  return _aligned_malloc(size > 0 ? size : 1, align);
+#else
+  // aligned_alloc wants a multiple of the alignment
+  return std::aligned_alloc(align, (size + align - 1) / align * align);
+#endif
+}
+
+void Free(void* ptr) noexcept {
+  if (ptr == nullptr) return;
+  if (t_active_guards > 0) ++t_frees;
+  std::free(ptr);
+}
+
+void FreeAligned(void* ptr) noexcept {
+  if (ptr == nullptr) return;
+  if (t_active_guards > 0) ++t_frees;
+#ifdef _WIN32
+  _aligned_free(ptr);
+#else
+  std::free(ptr);
+#endif
+}
+
+void* AllocateOrThrow(size_t size) {
+  if (void* ptr = Allocate(size)) return ptr;
+  throw std::bad_alloc();
+}
+
+void* AllocateAlignedOrThrow(size_t size, std::align_val_t alignment) {
+  if (void* ptr = AllocateAligned(size, alignment)) return ptr;
+  throw std::bad_alloc();
+}
+
+}  // namespace
+
+AllocationGuard::AllocationGuard()
+    : allocations_at_start_(t_allocations), frees_at_start_(t_frees) {
+  ++t_active_guards;
+}
+
+AllocationGuard::~AllocationGuard() { --t_active_guards; }
+
+uint64_t AllocationGuard::Allocations() const {
+  return t_allocations - allocations_at_start_;
+}
+
+uint64_t AllocationGuard::Frees() const { return t_frees - frees_at_start_; }
+
+}  // namespace stinky_dsp
+
+// Replaceable global allocation functions, [new.delete]
+
+void* operator new(std::size_t size) { return stinky_dsp::AllocateOrThrow(size); }
+void* operator new[](std::size_t size) {
+  return stinky_dsp::AllocateOrThrow(size);
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return stinky_dsp::Allocate(size);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return stinky_dsp::Allocate(size);
+}
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  return stinky_dsp::AllocateAlignedOrThrow(size, alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  return stinky_dsp::AllocateAlignedOrThrow(size, alignment);
+}
+void* operator new(std::size_t size, std::align_val_t alignment,
+                   const std::nothrow_t&) noexcept {
+  return stinky_dsp::AllocateAligned(size, alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept {
+  return stinky_dsp::AllocateAligned(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept { stinky_dsp::Free(ptr); }
+void operator delete[](void* ptr) noexcept { stinky_dsp::Free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { stinky_dsp::Free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { stinky_dsp::Free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+  stinky_dsp::Free(ptr);
+}
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+  stinky_dsp::Free(ptr);
+}
+void operator delete(void* ptr, std::align_val_t) noexcept {
+  stinky_dsp::FreeAligned(ptr);
+}
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+  stinky_dsp::FreeAligned(ptr);
+}
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+  stinky_dsp::FreeAligned(ptr);
+}
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+  stinky_dsp::FreeAligned(ptr);
+}
+void operator delete(void* ptr, std::align_val_t,
+                     const std::nothrow_t&) noexcept {
+  stinky_dsp::FreeAligned(ptr);
+}
+void operator delete[](void* ptr, std::align_val_t,
+                       const std::nothrow_t&) noexcept {
+  stinky_dsp::FreeAligned(ptr);
+}
@@ -0,0 +1,34 @@
+// Copyright 2025
+// Heap allocation counting for realtime-safety tests
+
+#ifndef ALLOCATION_GUARD_H_
+#define ALLOCATION_GUARD_H_
+
+#include <cstdint>
+
+namespace stinky_dsp {
+
+// Counts the heap allocations and frees the constructing thread makes while
+// the guard is alive. Linking allocation_guard.cc replaces the global
+// operator new and delete with counting versions; everything else still
+// allocates normally. Guards may nest.
+class AllocationGuard {
+ public:
+  AllocationGuard();
+  ~AllocationGuard();
+
+  AllocationGuard(const AllocationGuard&) = delete;
+  AllocationGuard& operator=(const AllocationGuard&) = delete;
+
+  // Counts since construction
+  uint64_t Allocations() const;
+  uint64_t Frees() const;
+
+ private:
+  uint64_t allocations_at_start_;
+  uint64_t frees_at_start_;
+};
+
+}  // namespace stinky_dsp
+
+#endif  // ALLOCATION_GUARD_H_
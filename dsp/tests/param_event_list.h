@@ -0,0 +1,53 @@
+// Copyright 2025
+// Parameter value event lists for plugin tests
+
+#ifndef PARAM_EVENT_LIST_H_
+#define PARAM_EVENT_LIST_H_
+
+#include <clap/clap.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace stinky_dsp {
+
+// Sorted list of parameter value events, exposed as clap_input_events_t
+class ParamEventList {
+ public:
+  void Add(uint32_t time, clap_id param_id, double value) {
+    clap_event_param_value_t event = {};
+    event.header.size = sizeof(event);
+    event.header.time = time;
+    event.header.space_id = CLAP_CORE_EVENT_SPACE_ID;
+    event.header.type = CLAP_EVENT_PARAM_VALUE;
+    event.param_id = param_id;
+    event.note_id = -1;
+    event.port_index = -1;
+    event.channel = -1;
+    event.key = -1;
+    event.value = value;
+    events_.push_back(event);
+  }
+
+  const clap_input_events_t* Events() {
+    input_.ctx = this;
+    input_.size = [](const clap_input_events_t* list) -> uint32_t {
+      auto* self = static_cast<const ParamEventList*>(list->ctx);
+      return static_cast<uint32_t>(self->events_.size());
+    };
+    input_.get = [](const clap_input_events_t* list,
+                    uint32_t index) -> const clap_event_header_t* {
+      auto* self = static_cast<const ParamEventList*>(list->ctx);
+      return &self->events_[index].header;
+    };
+    return &input_;
+  }
+
+ private:
+  std::vector<clap_event_param_value_t> events_;
+  clap_input_events_t input_;
+};
+
+}  // namespace stinky_dsp
+
+#endif  // PARAM_EVENT_LIST_H_
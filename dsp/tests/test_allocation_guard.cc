@@ -0,0 +1,60 @@
+// Copyright 2025
+// Unit tests for AllocationGuard
+
+#include "allocation_guard.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace stinky_dsp {
+namespace {
+
+TEST(AllocationGuardTest, CountsEveryKindOfAllocation) {
+  AllocationGuard guard;
+  EXPECT_EQ(guard.Allocations(), 0u);
+
+  auto value = std::make_unique<int>(1);
+  auto values = std::make_unique<float[]>(16);
+  std::vector<double> vector(100);
+  struct alignas(64) CacheLine {
+    float values[16];
+  };
+  auto line = std::make_unique<CacheLine>();
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(line.get()) % 64, 0u);
+  EXPECT_EQ(guard.Allocations(), 4u);
+  EXPECT_EQ(guard.Frees(), 0u);
+
+  value.reset();
+  values.reset();
+  line.reset();
+  vector = std::vector<double>();
+  EXPECT_EQ(guard.Frees(), 4u);
+}
+
+TEST(AllocationGuardTest, OnlyCountsItsOwnThreadWhileAlive) {
+  auto before = std::make_unique<int>(1);
+  AllocationGuard guard;
+
+  // Another thread's allocations are not this one's
+  std::thread([] { auto other = std::make_unique<int>(2); }).join();
+  const uint64_t after_thread = guard.Allocations();
+
+  {
+    AllocationGuard inner;
+    auto value = std::make_unique<int>(3);
+    EXPECT_EQ(inner.Allocations(), 1u);
+  }
+  EXPECT_EQ(guard.Allocations(), after_thread + 1);
+
+  // Freeing what was allocated before the guard still counts
+  const uint64_t frees = guard.Frees();
+  before.reset();
+  EXPECT_EQ(guard.Frees(), frees + 1);
+}
+
+}  // namespace
+}  // namespace stinky_dsp
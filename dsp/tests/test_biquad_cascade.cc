@@ -0,0 +1,432 @@
+// Copyright 2025
+// Unit tests for BiquadCascade
+
+#include "biquad_cascade.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+namespace stinky_dsp {
+namespace {
+
+constexpr float kEpsilon = 1e-5f;
+constexpr float kFloatEpsilon = 1e-4f;
+
+// Direct form I reference for a single channel
+class ReferenceBiquad {
+ public:
+  explicit ReferenceBiquad(const BiquadCoefficients& c) : c_(c) {}
+
+  float Process(float input) {
+    const double output =
+        c_.b0 * input + c_.b1 * x1_ + c_.b2 * x2_ - c_.a1 * y1_ - c_.a2 * y2_;
+    x2_ = x1_;
+    x1_ = input;
+    y2_ = y1_;
+    y1_ = output;
+    return static_cast<float>(output);
+  }
+
+ private:
+  BiquadCoefficients c_;
+  double x1_ = 0.0, x2_ = 0.0, y1_ = 0.0, y2_ = 0.0;
+};
+
+// RBJ peaking filter
+BiquadCoefficients Bell(double frequency, double gain_db, double q) {
+  constexpr double kSampleRate = 48000.0;
+  const double a = std::pow(10.0, gain_db / 40.0);
+  const double omega = 2.0 * std::numbers::pi * frequency / kSampleRate;
+  const double alpha = std::sin(omega) / (2.0 * q);
+  const double a0 = 1.0 + alpha / a;
+
+  BiquadCoefficients c;
+  c.b0 = (1.0 + alpha * a) / a0;
+  c.b1 = -2.0 * std::cos(omega) / a0;
+  c.b2 = (1.0 - alpha * a) / a0;
+  c.a1 = c.b1;
+  c.a2 = (1.0 - alpha / a) / a0;
+  return c;
+}
+
+std::vector<float> Signal(size_t count, float step) {
+  std::vector<float> signal(count);
+  for (size_t i = 0; i < count; ++i) {
+    signal[i] = 0.5f * std::sin(step * static_cast<float>(i));
+  }
+  return signal;
+}
+
+TEST(BiquadCascadeTest, NoEnabledStagesAppliesOnlyGain) {
+  BiquadCascade cascade;
+  cascade.SetStage(0, Bell(1000.0, 12.0, 1.0));
+
+  std::vector<float> left = Signal(64, 0.1f);
+  std::vector<float> right = Signal(64, 0.2f);
+  const std::vector<float> input_left = left;
+  const std::vector<float> input_right = right;
+  cascade.Process(left.data(), right.data(), left.size(), 0.5f);
+
+  for (size_t i = 0; i < left.size(); ++i) {
+    EXPECT_FLOAT_EQ(left[i], input_left[i] * 0.5f);
+    EXPECT_FLOAT_EQ(right[i], input_right[i] * 0.5f);
+  }
+}
+
+TEST(BiquadCascadeTest, MatchesSerialReferenceFilters) {
+  const BiquadCoefficients first = Bell(200.0, 6.0, 0.7);
+  const BiquadCoefficients second = Bell(2500.0, -9.0, 3.0);
+
+  BiquadCascade cascade;
+  cascade.SetStage(0, first);
+  cascade.SetStage(2, second);
+  cascade.SetStageEnabled(0, true);
+  cascade.SetStageEnabled(2, true);
+
+  ReferenceBiquad left_first(first), left_second(second);
+  ReferenceBiquad right_first(first), right_second(second);
+
+  std::vector<float> left = Signal(777, 0.05f);
+  std::vector<float> right = Signal(777, 0.31f);
+  std::vector<float> expected_left(left.size());
+  std::vector<float> expected_right(right.size());
+  for (size_t i = 0; i < left.size(); ++i) {
+    expected_left[i] = left_second.Process(left_first.Process(left[i]));
+    expected_right[i] = right_second.Process(right_first.Process(right[i]));
+  }
+
+  // Uneven block sizes check that state carries across calls
+  for (size_t offset = 0; offset < left.size(); offset += 100) {
+    const size_t frames = std::min<size_t>(100, left.size() - offset);
+    cascade.Process(left.data() + offset, right.data() + offset, frames, 1.0f);
+  }
+
+  for (size_t i = 0; i < left.size(); ++i) {
+    EXPECT_NEAR(left[i], expected_left[i], kEpsilon);
+    EXPECT_NEAR(right[i], expected_right[i], kEpsilon);
+  }
+}
+
+TEST(BiquadCascadeTest, InterleavedMatchesSplit) {
+  BiquadCascade split;
+  BiquadCascade interleaved;
+  for (auto* cascade : {&split, &interleaved}) {
+    cascade->SetStage(1, Bell(800.0, 10.0, 2.0));
+    cascade->SetStageEnabled(1, true);
+  }
+
+  std::vector<float> left = Signal(256, 0.07f);
+  std::vector<float> right = Signal(256, 0.4f);
+  std::vector<float> buffer(512);
+  for (size_t i = 0; i < left.size(); ++i) {
+    buffer[2 * i] = left[i];
+    buffer[2 * i + 1] = right[i];
+  }
+
+  split.Process(left.data(), right.data(), left.size(), 0.8f);
+  interleaved.ProcessInterleaved(buffer.data(), left.size(), 0.8f);
+
+  for (size_t i = 0; i < left.size(); ++i) {
+    EXPECT_FLOAT_EQ(buffer[2 * i], left[i]);
+    EXPECT_FLOAT_EQ(buffer[2 * i + 1], right[i]);
+  }
+}
+
+TEST(BiquadCascadeTest, OutOfPlaceMatchesInPlace) {
+  // No stages, double only, float pairs only, and both kinds
+  for (int layout = 0; layout < 4; ++layout) {
+    BiquadCascade in_place;
+    BiquadCascade out_of_place;
+    for (auto* cascade : {&in_place, &out_of_place}) {
+      if (layout & 1) {
+        cascade->SetStage(0, Bell(60.0, 6.0, 4.0), BiquadPrecision::kDouble);
+        cascade->SetStageEnabled(0, true);
+      }
+      if (layout & 2) {
+        cascade->SetStage(1, Bell(900.0, -4.0, 1.0), BiquadPrecision::kFloat);
+        cascade->SetStage(2, Bell(5000.0, 3.0, 0.7), BiquadPrecision::kFloat);
+        cascade->SetStageEnabled(1, true);
+        cascade->SetStageEnabled(2, true);
+      }
+    }
+
+    const std::vector<float> input_left = Signal(200, 0.05f);
+    const std::vector<float> input_right = Signal(200, 0.3f);
+    std::vector<float> left = input_left;
+    std::vector<float> right = input_right;
+    std::vector<float> out_left(200, 0.0f);
+    std::vector<float> out_right(200, 0.0f);
+
+    in_place.Process(left.data(), right.data(), left.size(), 0.7f);
+    out_of_place.Process(input_left.data(), input_right.data(),
+                         out_left.data(), out_right.data(), left.size(), 0.7f);
+
+    EXPECT_EQ(out_left, left) << "layout " << layout;
+    EXPECT_EQ(out_right, right) << "layout " << layout;
+  }
+}
+
+TEST(BiquadCascadeTest, DoubleBuffersMatchFloat) {
+  // No stages, double only, float pairs only, and both kinds
+  for (int layout = 0; layout < 4; ++layout) {
+    BiquadCascade single;
+    BiquadCascade wide;
+    for (auto* cascade : {&single, &wide}) {
+      if (layout & 1) {
+        cascade->SetStage(0, Bell(60.0, 6.0, 4.0), BiquadPrecision::kDouble);
+        cascade->SetStageEnabled(0, true);
+      }
+      if (layout & 2) {
+        cascade->SetStage(1, Bell(900.0, -4.0, 1.0), BiquadPrecision::kFloat);
+        cascade->SetStage(2, Bell(5000.0, 3.0, 0.7), BiquadPrecision::kFloat);
+        cascade->SetStageEnabled(1, true);
+        cascade->SetStageEnabled(2, true);
+      }
+    }
+
+    std::vector<float> left = Signal(200, 0.05f);
+    std::vector<float> right = Signal(200, 0.3f);
+    std::vector<double> wide_left(left.begin(), left.end());
+    std::vector<double> wide_right(right.begin(), right.end());
+
+    single.Process(left.data(), right.data(), left.size(), 0.7f);
+    wide.Process(wide_left.data(), wide_right.data(), wide_left.data(),
+                 wide_right.data(), wide_left.size(), 0.7f);
+
+    for (size_t i = 0; i < left.size(); ++i) {
+      EXPECT_NEAR(wide_left[i], left[i], kEpsilon) << "layout " << layout;
+      EXPECT_NEAR(wide_right[i], right[i], kEpsilon) << "layout " << layout;
+    }
+  }
+}
+
+TEST(BiquadCascadeTest, DoubleStagesKeepDoubleBuffersInDouble) {
+  BiquadCascade cascade;
+  std::vector<double> left(64, 1.0 + 1e-12);
+  std::vector<double> right(64, -0.25 - 1e-13);
+  std::vector<double> out_left(64, 0.0);
+  std::vector<double> out_right(64, 0.0);
+
+  // Detail below float resolution passes straight through
+  cascade.Process(left.data(), right.data(), out_left.data(),
+                  out_right.data(), left.size(), 1.0f);
+  EXPECT_EQ(out_left, left);
+  EXPECT_EQ(out_right, right);
+
+  // And through a double stage it matches a double reference closely
+  const BiquadCoefficients c = Bell(60.0, 6.0, 4.0);
+  cascade.SetStage(0, c, BiquadPrecision::kDouble);
+  cascade.SetStageEnabled(0, true);
+  for (size_t i = 0; i < left.size(); ++i) {
+    left[i] = 0.5 * std::sin(0.05 * static_cast<double>(i)) + 1e-10;
+  }
+  cascade.Process(left.data(), left.data(), out_left.data(),
+                  out_right.data(), left.size(), 1.0f);
+
+  double x1 = 0.0, x2 = 0.0, y1 = 0.0, y2 = 0.0;
+  for (size_t i = 0; i < left.size(); ++i) {
+    const double y =
+        c.b0 * left[i] + c.b1 * x1 + c.b2 * x2 - c.a1 * y1 - c.a2 * y2;
+    x2 = x1;
+    x1 = left[i];
+    y2 = y1;
+    y1 = y;
+    EXPECT_NEAR(out_left[i], y, 1e-12) << "frame " << i;
+  }
+}
+
+TEST(BiquadCascadeTest, MonoAliasedChannelsMatchStereo) {
+  BiquadCascade mono;
+  BiquadCascade stereo;
+  for (auto* cascade : {&mono, &stereo}) {
+    cascade->SetStage(0, Bell(500.0, 6.0, 1.0));
+    cascade->SetStageEnabled(0, true);
+  }
+
+  std::vector<float> mono_buffer = Signal(128, 0.09f);
+  std::vector<float> left = mono_buffer;
+  std::vector<float> right = mono_buffer;
+
+  mono.Process(mono_buffer.data(), mono_buffer.data(), mono_buffer.size(),
+               1.0f);
+  stereo.Process(left.data(), right.data(), left.size(), 1.0f);
+
+  for (size_t i = 0; i < mono_buffer.size(); ++i) {
+    EXPECT_FLOAT_EQ(mono_buffer[i], left[i]);
+  }
+}
+
+TEST(BiquadCascadeTest, MixedPrecisionMatchesSerialReferenceFilters) {
+  // Three float stages (odd, so one runs paired with the identity) and one
+  // double stage between them
+  const BiquadCoefficients stages[] = {
+      Bell(1000.0, 6.0, 1.0), Bell(60.0, 9.0, 4.0), Bell(3000.0, -6.0, 2.0),
+      Bell(8000.0, 4.0, 0.7)};
+  const BiquadPrecision precisions[] = {
+      BiquadPrecision::kFloat, BiquadPrecision::kDouble,
+      BiquadPrecision::kFloat, BiquadPrecision::kFloat};
+
+  BiquadCascade cascade;
+  std::vector<ReferenceBiquad> reference_left;
+  std::vector<ReferenceBiquad> reference_right;
+  for (size_t stage = 0; stage < 4; ++stage) {
+    cascade.SetStage(stage, stages[stage], precisions[stage]);
+    cascade.SetStageEnabled(stage, true);
+    reference_left.emplace_back(stages[stage]);
+    reference_right.emplace_back(stages[stage]);
+  }
+  EXPECT_EQ(cascade.StagePrecision(1), BiquadPrecision::kDouble);
+  EXPECT_EQ(cascade.StagePrecision(2), BiquadPrecision::kFloat);
+
+  std::vector<float> left = Signal(1000, 0.05f);
+  std::vector<float> right = Signal(1000, 0.31f);
+  std::vector<float> expected_left(left.size());
+  std::vector<float> expected_right(right.size());
+  for (size_t i = 0; i < left.size(); ++i) {
+    expected_left[i] = left[i];
+    expected_right[i] = right[i];
+    for (size_t stage = 0; stage < 4; ++stage) {
+      expected_left[i] = reference_left[stage].Process(expected_left[i]);
+      expected_right[i] = reference_right[stage].Process(expected_right[i]);
+    }
+    expected_left[i] *= 0.5f;
+    expected_right[i] *= 0.5f;
+  }
+
+  // Includes single-frame blocks, where the float pipeline is all
+  // prologue and epilogue
+  size_t offset = 0;
+  for (size_t frames : {1, 1, 2, 3, 100, 1, 257}) {
+    cascade.Process(left.data() + offset, right.data() + offset, frames, 0.5f);
+    offset += frames;
+  }
+  cascade.Process(left.data() + offset, right.data() + offset,
+                  left.size() - offset, 0.5f);
+
+  for (size_t i = 0; i < left.size(); ++i) {
+    EXPECT_NEAR(left[i], expected_left[i], kFloatEpsilon);
+    EXPECT_NEAR(right[i], expected_right[i], kFloatEpsilon);
+  }
+}
+
+TEST(BiquadCascadeTest, FloatStagesInterleavedAndMonoMatchSplit) {
+  BiquadCascade split;
+  BiquadCascade interleaved;
+  BiquadCascade mono;
+  for (auto* cascade : {&split, &interleaved, &mono}) {
+    cascade->SetStage(0, Bell(800.0, 10.0, 2.0), BiquadPrecision::kFloat);
+    cascade->SetStage(3, Bell(5000.0, -4.0, 1.0), BiquadPrecision::kFloat);
+    cascade->SetStageEnabled(0, true);
+    cascade->SetStageEnabled(3, true);
+  }
+
+  std::vector<float> left = Signal(256, 0.07f);
+  std::vector<float> right = Signal(256, 0.4f);
+  std::vector<float> mono_buffer = left;
+  std::vector<float> buffer(512);
+  for (size_t i = 0; i < left.size(); ++i) {
+    buffer[2 * i] = left[i];
+    buffer[2 * i + 1] = right[i];
+  }
+
+  split.Process(left.data(), right.data(), left.size(), 0.8f);
+  interleaved.ProcessInterleaved(buffer.data(), left.size(), 0.8f);
+  mono.Process(mono_buffer.data(), mono_buffer.data(), mono_buffer.size(),
+               0.8f);
+
+  for (size_t i = 0; i < left.size(); ++i) {
+    EXPECT_FLOAT_EQ(buffer[2 * i], left[i]);
+    EXPECT_FLOAT_EQ(buffer[2 * i + 1], right[i]);
+    EXPECT_FLOAT_EQ(mono_buffer[i], left[i]);
+  }
+}
+
+TEST(BiquadCascadeTest, PrecisionSwitchKeepsState) {
+  const BiquadCoefficients coefficients = Bell(1500.0, 8.0, 1.5);
+  BiquadCascade cascade;
+  cascade.SetStage(0, coefficients);
+  cascade.SetStageEnabled(0, true);
+  ReferenceBiquad reference_left(coefficients);
+  ReferenceBiquad reference_right(coefficients);
+
+  std::vector<float> left = Signal(600, 0.11f);
+  std::vector<float> right = Signal(600, 0.23f);
+  std::vector<float> expected_left(left.size());
+  std::vector<float> expected_right(right.size());
+  for (size_t i = 0; i < left.size(); ++i) {
+    expected_left[i] = reference_left.Process(left[i]);
+    expected_right[i] = reference_right.Process(right[i]);
+  }
+
+  const BiquadPrecision order[] = {BiquadPrecision::kDouble,
+                                   BiquadPrecision::kFloat,
+                                   BiquadPrecision::kDouble};
+  for (size_t block = 0; block < 3; ++block) {
+    cascade.SetStage(0, coefficients, order[block]);
+    cascade.Process(left.data() + block * 200, right.data() + block * 200,
+                    200, 1.0f);
+  }
+
+  for (size_t i = 0; i < left.size(); ++i) {
+    EXPECT_NEAR(left[i], expected_left[i], kFloatEpsilon);
+    EXPECT_NEAR(right[i], expected_right[i], kFloatEpsilon);
+  }
+}
+
+TEST(BiquadCascadeTest, ResetClearsState) {
+  BiquadCascade cascade;
+  cascade.SetStage(0, Bell(1000.0, 12.0, 1.0));
+  cascade.SetStageEnabled(0, true);
+
+  std::vector<float> left(256, 0.5f);
+  std::vector<float> right(256, 0.5f);
+  cascade.Process(left.data(), right.data(), left.size(), 1.0f);
+  cascade.Reset();
+
+  std::fill(left.begin(), left.end(), 0.0f);
+  std::fill(right.begin(), right.end(), 0.0f);
+  cascade.Process(left.data(), right.data(), left.size(), 1.0f);
+
+  for (size_t i = 0; i < left.size(); ++i) {
+    EXPECT_EQ(left[i], 0.0f);
+    EXPECT_EQ(right[i], 0.0f);
+  }
+}
+
+TEST(BiquadCascadeTest, DecayFramesBoundTheImpulseResponse) {
+  for (const BiquadCoefficients& c :
+       {Bell(60.0, 12.0, 8.0), Bell(1000.0, -6.0, 0.7),
+        Bell(12000.0, 3.0, 2.0)}) {
+    const uint32_t decay = BiquadDecayFrames(c, 1e-6);
+    ASSERT_LT(decay, 48000u * 10);
+
+    ReferenceBiquad filter(c);
+    float peak = std::abs(filter.Process(1.0f));
+    for (uint32_t i = 1; i < decay; ++i) {
+      peak = std::max(peak, std::abs(filter.Process(0.0f)));
+    }
+    // Past the decay the response stays 120 dB under its peak
+    for (uint32_t i = 0; i < decay; ++i) {
+      ASSERT_LT(std::abs(filter.Process(0.0f)), peak * 1e-6f) << i;
+    }
+  }
+
+  // Narrow low bells ring longer
+  EXPECT_GT(BiquadDecayFrames(Bell(60.0, 12.0, 8.0), 1e-6),
+            BiquadDecayFrames(Bell(1000.0, 12.0, 8.0), 1e-6));
+
+  BiquadCoefficients fir;
+  fir.b1 = 0.5;
+  EXPECT_EQ(BiquadDecayFrames(fir, 1e-6), 2u);
+
+  BiquadCoefficients unstable;
+  unstable.a2 = 1.0;
+  EXPECT_EQ(BiquadDecayFrames(unstable, 1e-6), UINT32_MAX);
+}
+
+}  // namespace
+}  // namespace stinky_dsp
@@ -0,0 +1,86 @@
+// Copyright 2025
+// Unit tests for ConstantDetector
+
+#include "constant_detector.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace stinky_dsp {
+namespace {
+
+TEST(ConstantDetectorTest, ChannelMaskCoversTheFirstChannels) {
+  EXPECT_EQ(ConstantDetector::ChannelMask(0), 0u);
+  EXPECT_EQ(ConstantDetector::ChannelMask(2), 0b11u);
+  EXPECT_EQ(ConstantDetector::ChannelMask(64), ~uint64_t{0});
+}
+
+TEST(ConstantDetectorTest, SettlesAfterTheSameConstantOutlastsTheSettleTime) {
+  std::vector<float> left(128, 0.5f);
+  std::vector<float> right(128, -0.25f);
+  const float* channels[] = {left.data(), right.data()};
+  ConstantDetector detector;
+
+  // 128 + 128 + 128 frames: the settle time ends inside the third block
+  EXPECT_FALSE(detector.Update(channels, 2, 0b11, 128, 300));
+  EXPECT_FALSE(detector.Update(channels, 2, 0b11, 128, 300));
+  EXPECT_FALSE(detector.Update(channels, 2, 0b11, 128, 300));
+  EXPECT_TRUE(detector.Update(channels, 2, 0b11, 128, 300));
+
+  // A new value starts a new run
+  right.assign(128, 0.25f);
+  EXPECT_FALSE(detector.Update(channels, 2, 0b11, 128, 100));
+  EXPECT_TRUE(detector.Update(channels, 2, 0b11, 128, 100));
+
+  // So does any channel the host did not flag
+  EXPECT_FALSE(detector.Update(channels, 2, 0b01, 128, 100));
+  EXPECT_FALSE(detector.Update(channels, 2, 0b11, 128, 100));
+  EXPECT_TRUE(detector.Update(channels, 2, 0b11, 128, 100));
+
+  detector.Reset();
+  EXPECT_FALSE(detector.Update(channels, 2, 0b11, 128, 100));
+}
+
+TEST(ConstantDetectorTest, InfiniteSettleTimeNeverSettles) {
+  std::vector<float> mono(4096, 1.0f);
+  const float* channels[] = {mono.data()};
+  ConstantDetector detector;
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_FALSE(detector.Update(channels, 1, 0b1, 4096, UINT32_MAX));
+  }
+}
+
+TEST(ConstantDetectorTest, MatchesOnlyAnExactRepeatOfTheLastOutput) {
+  std::vector<float> left = {0.1f, 0.2f, 0.3f};
+  std::vector<float> right = {0.4f, 0.5f, 0.6f};
+  float* channels[] = {left.data(), right.data()};
+  ConstantDetector detector;
+
+  EXPECT_FALSE(detector.MatchesLastOutput(channels, 2));
+  detector.SetLastOutput(channels, 2, 3);
+
+  left[0] = 0.3f;
+  right[0] = 0.6f;
+  EXPECT_TRUE(detector.MatchesLastOutput(channels, 2));
+  EXPECT_FALSE(detector.MatchesLastOutput(channels, 1));
+
+  right[0] = 0.6000001f;
+  EXPECT_FALSE(detector.MatchesLastOutput(channels, 2));
+
+  detector.Reset();
+  right[0] = 0.6f;
+  EXPECT_FALSE(detector.MatchesLastOutput(channels, 2));
+}
+
+TEST(ConstantDetectorTest, FillRepeatsTheFirstFrame) {
+  std::vector<float> left = {1.0f, 0.0f, 2.0f, 3.0f};
+  std::vector<float> right = {-1.0f, 5.0f, 6.0f, 7.0f};
+  float* channels[] = {left.data(), right.data()};
+  ConstantDetector::Fill(channels, 2, 4);
+  EXPECT_EQ(left, std::vector<float>(4, 1.0f));
+  EXPECT_EQ(right, std::vector<float>(4, -1.0f));
+}
+
+}  // namespace
+}  // namespace stinky_dsp
@@ -0,0 +1,108 @@
+// Copyright 2025
+// Unit tests for ApplyDueEvents
+
+#include "param_events.h"
+#include "param_event_list.h"
+
+#include <gtest/gtest.h>
+
+#include <utility>
+#include <vector>
+
+namespace stinky_dsp {
+namespace {
+
+// Splits a block the way the plugins do, returning each sub-block as
+// {start, end} and the ids of the events applied before it
+struct SubBlock {
+  uint32_t start;
+  uint32_t end;
+  std::vector<clap_id> applied;
+};
+
+std::vector<SubBlock> Split(const clap_input_events_t* events,
+                            uint32_t frame_count) {
+  std::vector<SubBlock> blocks;
+  uint32_t next_event = 0;
+  for (uint32_t frame = 0; frame < frame_count;) {
+    SubBlock block{frame, 0, {}};
+    block.end = ApplyDueEvents(
+        events, &next_event, frame, frame_count,
+        [&](const clap_event_header_t* header) {
+          block.applied.push_back(
+              reinterpret_cast<const clap_event_param_value_t*>(header)
+                  ->param_id);
+        });
+    frame = block.end;
+    blocks.push_back(std::move(block));
+  }
+  return blocks;
+}
+
+TEST(ParamEventsTest, NoEventsProcessTheWholeBlock) {
+  const auto blocks = Split(nullptr, 256);
+  ASSERT_EQ(blocks.size(), 1u);
+  EXPECT_EQ(blocks[0].end, 256u);
+
+  ParamEventList empty;
+  const auto empty_blocks = Split(empty.Events(), 256);
+  ASSERT_EQ(empty_blocks.size(), 1u);
+  EXPECT_EQ(empty_blocks[0].end, 256u);
+  EXPECT_TRUE(empty_blocks[0].applied.empty());
+}
+
+TEST(ParamEventsTest, SplitsAtEventTimestamps) {
+  ParamEventList events;
+  events.Add(0, 1, 0.0);
+  events.Add(100, 2, 0.0);
+  events.Add(200, 3, 0.0);
+
+  const auto blocks = Split(events.Events(), 256);
+  ASSERT_EQ(blocks.size(), 3u);
+  EXPECT_EQ(blocks[0].end, 100u);
+  EXPECT_EQ(blocks[1].end, 200u);
+  EXPECT_EQ(blocks[2].end, 256u);
+  EXPECT_EQ(blocks[0].applied, std::vector<clap_id>{1});
+  EXPECT_EQ(blocks[1].applied, std::vector<clap_id>{2});
+  EXPECT_EQ(blocks[2].applied, std::vector<clap_id>{3});
+}
+
+TEST(ParamEventsTest, MergesEventsCloserThanTheMinimumSubBlock) {
+  ParamEventList events;
+  events.Add(100, 1, 0.0);
+  events.Add(100 + kMinSubBlockFrames - 1, 2, 0.0);
+  events.Add(100 + kMinSubBlockFrames + 4, 3, 0.0);
+
+  const auto blocks = Split(events.Events(), 256);
+  ASSERT_EQ(blocks.size(), 3u);
+  EXPECT_EQ(blocks[0].end, 100u);
+  EXPECT_TRUE(blocks[0].applied.empty());
+  // The second event is too close, so it lands with the first
+  EXPECT_EQ(blocks[1].end, 100 + kMinSubBlockFrames + 4);
+  EXPECT_EQ(blocks[1].applied, (std::vector<clap_id>{1, 2}));
+  EXPECT_EQ(blocks[2].applied, std::vector<clap_id>{3});
+}
+
+TEST(ParamEventsTest, EventsInTheFirstFramesApplyAtTheBlockStart) {
+  ParamEventList events;
+  events.Add(kMinSubBlockFrames - 1, 1, 0.0);
+
+  const auto blocks = Split(events.Events(), 256);
+  ASSERT_EQ(blocks.size(), 1u);
+  EXPECT_EQ(blocks[0].applied, std::vector<clap_id>{1});
+}
+
+TEST(ParamEventsTest, EventsPastTheBlockApplyInTheLastSubBlock) {
+  ParamEventList events;
+  events.Add(64, 1, 0.0);
+  events.Add(300, 2, 0.0);
+
+  const auto blocks = Split(events.Events(), 128);
+  ASSERT_EQ(blocks.size(), 2u);
+  EXPECT_EQ(blocks[0].end, 64u);
+  EXPECT_EQ(blocks[1].end, 128u);
+  EXPECT_EQ(blocks[1].applied, (std::vector<clap_id>{1, 2}));
+}
+
+}  // namespace
+}  // namespace stinky_dsp
@@ -0,0 +1,213 @@
+// Copyright 2025
+// Unit tests for ProcessBlock
+
+#include "process_block.h"
+#include "param_event_list.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace stinky_dsp {
+namespace {
+
+constexpr uint32_t kFrames = 256;
+
+// A gain stage standing in for a plugin: parameter events set the gain, and
+// every DSP run is recorded as {frame, frames}
+class GainPlugin {
+ public:
+  clap_process_status Process(const clap_process_t* process,
+                              const BlockOptions& options = {}) {
+    const clap_audio_buffer_t& input = process->audio_inputs[0];
+    const clap_audio_buffer_t& output = process->audio_outputs[0];
+    return ProcessBlock(
+        process, input.data32, output.data32, options, silence, constant,
+        [this](const clap_event_header_t* header) {
+          pending_gain_ = static_cast<float>(
+              reinterpret_cast<const clap_event_param_value_t*>(header)
+                  ->value);
+          return true;
+        },
+        [this] { gain = pending_gain_; },
+        [this](const float* const* in, float* const* out,
+               uint32_t num_channels, uint32_t frame, uint32_t frames) {
+          runs.emplace_back(frame, frames);
+          for (uint32_t channel = 0; channel < num_channels; ++channel) {
+            for (uint32_t i = 0; i < frames; ++i) {
+              out[channel][i] = in[channel][i] * gain;
+            }
+          }
+        });
+  }
+
+  SilenceDetector silence;
+  ConstantDetector constant;
+  float gain = 1.0f;
+  std::vector<std::pair<uint32_t, uint32_t>> runs;
+
+ private:
+  float pending_gain_ = 1.0f;
+};
+
+// Main ports of one block, with separate input and output buffers
+class Block {
+ public:
+  Block(uint32_t in_channels, uint32_t out_channels, float value)
+      : in_(in_channels, std::vector<float>(kFrames, value)),
+        out_(out_channels, std::vector<float>(kFrames, -1.0f)) {
+    for (uint32_t channel = 0; channel < in_channels; ++channel) {
+      in_ptrs_[channel] = in_[channel].data();
+    }
+    for (uint32_t channel = 0; channel < out_channels; ++channel) {
+      out_ptrs_[channel] = out_[channel].data();
+    }
+    input_ = {in_ptrs_, nullptr, in_channels, 0, 0};
+    output_ = {out_ptrs_, nullptr, out_channels, 0, 0};
+    process_.frames_count = kFrames;
+    process_.audio_inputs = &input_;
+    process_.audio_inputs_count = 1;
+    process_.audio_outputs = &output_;
+    process_.audio_outputs_count = 1;
+  }
+
+  clap_process_t* Process() { return &process_; }
+  clap_audio_buffer_t& Input() { return input_; }
+  clap_audio_buffer_t& Output() { return output_; }
+  std::vector<float>& In(uint32_t channel) { return in_[channel]; }
+  std::vector<float>& Out(uint32_t channel) { return out_[channel]; }
+
+ private:
+  std::vector<std::vector<float>> in_;
+  std::vector<std::vector<float>> out_;
+  float* in_ptrs_[kMaxChannels];
+  float* out_ptrs_[kMaxChannels];
+  clap_audio_buffer_t input_;
+  clap_audio_buffer_t output_;
+  clap_process_t process_ = {};
+};
+
+TEST(ProcessBlockTest, SplitsTheDspAtParameterEvents) {
+  GainPlugin plugin;
+  plugin.silence.SetTail(kFrames);
+  Block block(2, 2, 0.5f);
+  ParamEventList events;
+  events.Add(100, 0, 2.0);
+  events.Add(200, 0, 4.0);
+  block.Process()->in_events = events.Events();
+
+  EXPECT_EQ(plugin.Process(block.Process()), CLAP_PROCESS_CONTINUE);
+  const std::vector<std::pair<uint32_t, uint32_t>> runs = {
+      {0, 100}, {100, 100}, {200, 56}};
+  EXPECT_EQ(plugin.runs, runs);
+  for (uint32_t channel = 0; channel < 2; ++channel) {
+    EXPECT_EQ(block.Out(channel)[99], 0.5f);
+    EXPECT_EQ(block.Out(channel)[100], 1.0f);
+    EXPECT_EQ(block.Out(channel)[255], 2.0f);
+  }
+  EXPECT_EQ(block.Output().constant_mask, 0u);
+}
+
+TEST(ProcessBlockTest, MissingInputChannelsRepeatTheFirst) {
+  GainPlugin plugin;
+  plugin.silence.SetTail(kFrames);
+  Block block(1, 4, 0.5f);
+  BlockOptions options;
+  options.layout_channels = 4;
+
+  plugin.Process(block.Process(), options);
+  for (uint32_t channel = 0; channel < 4; ++channel) {
+    EXPECT_EQ(block.Out(channel), block.In(0)) << "channel " << channel;
+  }
+}
+
+TEST(ProcessBlockTest, OutputChannelsPastTheLayoutAreSilent) {
+  GainPlugin plugin;
+  plugin.silence.SetTail(kFrames);
+  Block block(4, 4, 0.5f);
+  block.Input().constant_mask = 0b1111;
+  BlockOptions options;
+  options.layout_channels = 2;
+
+  // Every path: the DSP, then the steady-state shortcut once settled
+  for (int i = 0; i < 8; ++i) {
+    for (uint32_t channel = 0; channel < 4; ++channel) {
+      std::fill(block.Out(channel).begin(), block.Out(channel).end(), -1.0f);
+    }
+    plugin.Process(block.Process(), options);
+    EXPECT_EQ(block.Out(1), std::vector<float>(kFrames, 0.5f));
+    EXPECT_EQ(block.Out(2), std::vector<float>(kFrames, 0.0f));
+    EXPECT_EQ(block.Out(3), std::vector<float>(kFrames, 0.0f));
+  }
+  EXPECT_EQ(block.Output().constant_mask, 0b1111u);
+}
+
+TEST(ProcessBlockTest, NoInputChannelsFeedTheDspSilence) {
+  GainPlugin plugin;
+  plugin.silence.SetTail(4 * kFrames);
+  Block block(0, 2, 0.0f);
+
+  EXPECT_EQ(plugin.Process(block.Process()), CLAP_PROCESS_CONTINUE);
+  const std::vector<std::pair<uint32_t, uint32_t>> runs = {{0, kFrames}};
+  EXPECT_EQ(plugin.runs, runs);
+  EXPECT_EQ(block.Out(0), std::vector<float>(kFrames, 0.0f));
+  EXPECT_EQ(block.Out(1), std::vector<float>(kFrames, 0.0f));
+}
+
+TEST(ProcessBlockTest, SilenceOutlastingTheTailSkipsTheDsp) {
+  GainPlugin plugin;
+  plugin.silence.SetTail(kFrames);
+  Block block(2, 2, 0.0f);
+
+  // The first silent block still covers the tail
+  EXPECT_EQ(plugin.Process(block.Process()), CLAP_PROCESS_SLEEP);
+  ASSERT_EQ(plugin.runs.size(), 1u);
+
+  // Events in skipped blocks still apply
+  ParamEventList events;
+  events.Add(10, 0, 3.0);
+  block.Process()->in_events = events.Events();
+  EXPECT_EQ(plugin.Process(block.Process()), CLAP_PROCESS_SLEEP);
+  EXPECT_EQ(plugin.runs.size(), 1u);
+  EXPECT_EQ(plugin.gain, 3.0f);
+  EXPECT_EQ(block.Output().constant_mask, 0b11u);
+  EXPECT_EQ(block.Out(0), std::vector<float>(kFrames, 0.0f));
+
+  // A sounding sidechain keeps the DSP running
+  BlockOptions options;
+  options.other_inputs_silent = false;
+  block.Process()->in_events = nullptr;
+  EXPECT_EQ(plugin.Process(block.Process(), options), CLAP_PROCESS_CONTINUE);
+  EXPECT_EQ(plugin.runs.size(), 2u);
+}
+
+TEST(ProcessBlockTest, SettledConstantInputIsProbedWithOneFrame) {
+  GainPlugin plugin;
+  plugin.silence.SetTail(kFrames);
+  Block block(2, 2, 0.25f);
+  block.Input().constant_mask = 0b11;
+
+  // Runs the DSP until the constant has outlasted the tail
+  for (int i = 0; i < 8 && block.Output().constant_mask == 0; ++i) {
+    plugin.runs.clear();
+    plugin.Process(block.Process());
+  }
+  ASSERT_EQ(block.Output().constant_mask, 0b11u);
+  const std::vector<std::pair<uint32_t, uint32_t>> probe = {{0, 1}};
+  EXPECT_EQ(plugin.runs, probe);
+  EXPECT_EQ(block.Out(1), std::vector<float>(kFrames, 0.25f));
+
+  // A ramping parameter rules the shortcut out
+  BlockOptions options;
+  options.may_settle = false;
+  plugin.runs.clear();
+  plugin.Process(block.Process(), options);
+  const std::vector<std::pair<uint32_t, uint32_t>> full = {{0, kFrames}};
+  EXPECT_EQ(plugin.runs, full);
+  EXPECT_EQ(block.Output().constant_mask, 0u);
+}
+
+}  // namespace
+}  // namespace stinky_dsp
@@ -0,0 +1,124 @@
+// Copyright 2025
+// Unit tests for ProcessStats
+
+#include "process_stats.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace stinky_dsp {
+namespace {
+
+constexpr double kSampleRate = 48000.0;
+constexpr uint32_t kFrames = 480;  // 10 ms, so 1 ms of work is 10% load
+
+class ProcessStatsTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    stats_.SetSampleRate(kSampleRate);
+    stats_.SetEnabled(true);
+  }
+
+  ProcessStats stats_;
+};
+
+TEST_F(ProcessStatsTest, ScopeRecordsOnlyWhenEnabled) {
+  stats_.SetEnabled(false);
+  { ProcessStats::Scope scope(stats_, kFrames); }
+  EXPECT_EQ(stats_.GetSummary().blocks, 0u);
+
+  stats_.SetEnabled(true);
+  { ProcessStats::Scope scope(stats_, kFrames); }
+  const ProcessStats::Summary summary = stats_.GetSummary();
+  EXPECT_EQ(summary.blocks, 1u);
+  EXPECT_EQ(summary.frames, kFrames);
+}
+
+TEST_F(ProcessStatsTest, TracksTotalsWorstCaseAndLoadHistogram) {
+  stats_.Record(kFrames, 1000, 1'000'000);   // 10% load
+  stats_.Record(kFrames, 3000, 5'000'000);   // 50%
+  stats_.Record(kFrames, 2000, 12'000'000);  // 120%, over the deadline
+
+  const ProcessStats::Summary summary = stats_.GetSummary();
+  EXPECT_EQ(summary.blocks, 3u);
+  EXPECT_EQ(summary.frames, 3u * kFrames);
+  EXPECT_EQ(summary.total_cycles, 6000u);
+  EXPECT_EQ(summary.total_nanoseconds, 18'000'000u);
+  EXPECT_EQ(summary.max_block_cycles, 3000u);
+  EXPECT_EQ(summary.max_block_nanoseconds, 12'000'000u);
+  EXPECT_NEAR(summary.max_load, 1.2, 1e-9);
+
+  EXPECT_EQ(summary.load_histogram[2], 1u);
+  EXPECT_EQ(summary.load_histogram[10], 1u);
+  EXPECT_EQ(summary.load_histogram[ProcessStats::kHistogramBuckets - 1], 1u);
+}
+
+TEST_F(ProcessStatsTest, RingDropsWhenFullAndReadsInOrder) {
+  const size_t total = ProcessStats::kRingSize + 10;
+  for (size_t i = 0; i < total; ++i) {
+    stats_.Record(static_cast<uint32_t>(i + 1), 0, 1000);
+  }
+  EXPECT_EQ(stats_.GetSummary().blocks, total);
+  EXPECT_EQ(stats_.GetSummary().dropped_records, 10u);
+
+  std::vector<ProcessStats::Block> blocks(total);
+  ASSERT_EQ(stats_.ReadBlocks(blocks.data(), total), ProcessStats::kRingSize);
+  for (size_t i = 0; i < ProcessStats::kRingSize; ++i) {
+    EXPECT_EQ(blocks[i].frames, i + 1);
+  }
+  EXPECT_EQ(stats_.ReadBlocks(blocks.data(), total), 0u);
+}
+
+TEST_F(ProcessStatsTest, ResetClearsRingAndTotalsBeforeNextBlock) {
+  stats_.Record(kFrames, 100, 1000);
+  stats_.Record(kFrames, 100, 1000);
+  stats_.Reset();
+
+  EXPECT_EQ(stats_.GetSummary().blocks, 0u);
+  ProcessStats::Block block;
+  EXPECT_EQ(stats_.ReadBlocks(&block, 1), 0u);
+
+  stats_.Record(kFrames, 100, 2000);
+  const ProcessStats::Summary summary = stats_.GetSummary();
+  EXPECT_EQ(summary.blocks, 1u);
+  EXPECT_EQ(summary.total_nanoseconds, 2000u);
+  EXPECT_EQ(stats_.ReadBlocks(&block, 1), 1u);
+}
+
+TEST_F(ProcessStatsTest, ConcurrentReaderSeesEveryRecordInOrder) {
+  constexpr uint32_t kBlocks = 100000;
+  std::atomic<bool> done{false};
+
+  std::thread audio([&] {
+    for (uint32_t i = 1; i <= kBlocks; ++i) {
+      stats_.Record(i, i, i);
+    }
+    done.store(true, std::memory_order_release);
+  });
+
+  uint64_t received = 0;
+  uint32_t last = 0;
+  bool ordered = true;
+  std::vector<ProcessStats::Block> blocks(64);
+  while (true) {
+    const bool finished = done.load(std::memory_order_acquire);
+    const size_t count = stats_.ReadBlocks(blocks.data(), blocks.size());
+    for (size_t i = 0; i < count; ++i) {
+      ordered &= blocks[i].frames > last;
+      ordered &= blocks[i].cycles == blocks[i].frames;
+      last = blocks[i].frames;
+    }
+    received += count;
+    if (finished && count == 0) break;
+  }
+  audio.join();
+
+  EXPECT_TRUE(ordered);
+  EXPECT_EQ(received + stats_.GetSummary().dropped_records, kBlocks);
+}
+
+}  // namespace
+}  // namespace stinky_dsp
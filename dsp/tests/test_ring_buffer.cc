@@ -0,0 +1,86 @@
+// Copyright 2025
+// Unit tests for RingBuffer
+
+#include "ring_buffer.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace stinky_dsp {
+namespace {
+
+TEST(RingBufferTest, CapacityIsRoundedUpToAPowerOfTwo) {
+  EXPECT_EQ(RingBuffer<float>(1).Capacity(), 1u);
+  EXPECT_EQ(RingBuffer<float>(64).Capacity(), 64u);
+  EXPECT_EQ(RingBuffer<float>(65).Capacity(), 128u);
+  EXPECT_EQ(RingBuffer<double>(48000).Capacity(), 65536u);
+}
+
+TEST(RingBufferTest, BlockReadsMatchASampleDelayAcrossTheWrap) {
+  // Uneven blocks so reads and writes straddle the end of the ring
+  constexpr size_t kBlocks[] = {5, 13, 1, 16, 7, 11, 3};
+  for (size_t delay : {0, 1, 4, 9, 16}) {
+    RingBuffer<double> ring(32);
+    std::vector<float> out;
+    float next = 1.0f;
+    for (int pass = 0; pass < 10; ++pass) {
+      for (size_t frames : kBlocks) {
+        std::vector<float> in(frames);
+        for (float& value : in) value = next++;
+        out.resize(frames);
+        ring.Write(in.data(), frames);
+        ring.Read(out.data(), delay, frames);
+        for (size_t i = 0; i < frames; ++i) {
+          // Values count up from 1, and the ring starts out zeroed
+          const float expected = in[i] > static_cast<float>(delay)
+                                     ? in[i] - static_cast<float>(delay)
+                                     : 0.0f;
+          ASSERT_EQ(out[i], expected) << "delay " << delay << ", pass "
+                                      << pass << ", frame " << i;
+        }
+      }
+    }
+  }
+}
+
+TEST(RingBufferTest, PushAndDelayedMatchBlockAccess) {
+  RingBuffer<float> ring(8);
+  for (int i = 1; i <= 20; ++i) {
+    ring.Push(static_cast<float>(i));
+    EXPECT_EQ(ring.Delayed(0), static_cast<float>(i));
+    EXPECT_EQ(ring.Delayed(3), i > 3 ? static_cast<float>(i - 3) : 0.0f);
+  }
+
+  float block[2];
+  ring.Read(block, 1, 2);
+  EXPECT_EQ(block[0], 18.0f);
+  EXPECT_EQ(block[1], 19.0f);
+
+  ring.Clear();
+  EXPECT_EQ(ring.Delayed(0), 0.0f);
+  EXPECT_EQ(ring.Delayed(7), 0.0f);
+}
+
+TEST(RingBufferTest, PartialClearZeroesOnlyTheReadableValues) {
+  RingBuffer<float> ring(8);
+  for (int i = 1; i <= 11; ++i) {
+    ring.Push(static_cast<float>(i));
+  }
+
+  // The last three values are gone, older ones are left alone
+  ring.Clear(3);
+  for (size_t delay = 0; delay < 3; ++delay) {
+    EXPECT_EQ(ring.Delayed(delay), 0.0f);
+  }
+  EXPECT_EQ(ring.Delayed(3), 8.0f);
+  EXPECT_EQ(ring.Delayed(7), 4.0f);
+
+  // Writing carries on from the same position
+  ring.Push(12.0f);
+  EXPECT_EQ(ring.Delayed(0), 12.0f);
+  EXPECT_EQ(ring.Delayed(1), 0.0f);
+}
+
+}  // namespace
+}  // namespace stinky_dsp
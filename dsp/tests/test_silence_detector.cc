@@ -0,0 +1,98 @@
+// Copyright 2025
+// Unit tests for SilenceDetector
+
+#include "silence_detector.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace stinky_dsp {
+namespace {
+
+TEST(SilenceDetectorTest, IsSilentChecksEveryChannel) {
+  std::vector<float> left(100, 0.0f);
+  std::vector<float> right(100, 0.0f);
+  const float* channels[] = {left.data(), right.data()};
+
+  EXPECT_TRUE(SilenceDetector::IsSilent(channels, 2, 100));
+
+  // Below -120 dBFS still counts as silence
+  right[99] = -0.5e-6f;
+  EXPECT_TRUE(SilenceDetector::IsSilent(channels, 2, 100));
+
+  right[99] = -1e-3f;
+  EXPECT_FALSE(SilenceDetector::IsSilent(channels, 2, 100));
+  EXPECT_TRUE(SilenceDetector::IsSilent(channels, 1, 100));
+  EXPECT_TRUE(SilenceDetector::IsSilent(channels, 2, 99));
+}
+
+TEST(SilenceDetectorTest, ConstantChannelsOnlyCheckTheFirstSample) {
+  std::vector<float> left(100, 0.0f);
+  std::vector<float> right(100, 0.0f);
+  const float* channels[] = {left.data(), right.data()};
+
+  // A host-flagged constant channel is trusted, not scanned
+  right[50] = 1.0f;
+  EXPECT_FALSE(SilenceDetector::IsSilent(channels, 2, 100));
+  EXPECT_TRUE(SilenceDetector::IsSilent(channels, 2, 100, 0b10));
+
+  right[0] = 1.0f;
+  EXPECT_FALSE(SilenceDetector::IsSilent(channels, 2, 100, 0b11));
+}
+
+TEST(SilenceDetectorTest, SkipsOnlyAfterTheTailHasPlayedOut) {
+  SilenceDetector detector;
+  detector.SetTail(300);
+
+  EXPECT_FALSE(detector.Update(false, 128));
+  EXPECT_FALSE(detector.IsDecayed());
+
+  // 128 + 128 + 128 silent frames: the tail ends inside the third block
+  EXPECT_FALSE(detector.Update(true, 128));
+  EXPECT_FALSE(detector.Update(true, 128));
+  EXPECT_FALSE(detector.IsDecayed());
+  EXPECT_FALSE(detector.Update(true, 128));
+  EXPECT_TRUE(detector.IsDecayed());
+
+  EXPECT_TRUE(detector.Update(true, 128));
+  EXPECT_TRUE(detector.IsDecayed());
+
+  // Input wakes everything up again
+  EXPECT_FALSE(detector.Update(false, 128));
+  EXPECT_FALSE(detector.IsDecayed());
+}
+
+TEST(SilenceDetectorTest, ZeroTailSkipsTheFirstSilentBlock) {
+  SilenceDetector detector;
+  EXPECT_EQ(detector.Tail(), 0u);
+  EXPECT_TRUE(detector.Update(true, 64));
+  EXPECT_TRUE(detector.IsDecayed());
+}
+
+TEST(SilenceDetectorTest, InfiniteTailNeverDecays) {
+  SilenceDetector detector;
+  detector.SetTail(SilenceDetector::kInfiniteTail);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_FALSE(detector.Update(true, 4096));
+  }
+  EXPECT_FALSE(detector.IsDecayed());
+}
+
+TEST(SilenceDetectorTest, ResetAndLongerTailRestartTheCount) {
+  SilenceDetector detector;
+  detector.SetTail(100);
+  detector.Update(true, 128);
+  EXPECT_TRUE(detector.IsDecayed());
+
+  detector.SetTail(200);
+  EXPECT_FALSE(detector.IsDecayed());
+  EXPECT_FALSE(detector.Update(true, 128));
+  EXPECT_TRUE(detector.IsDecayed());
+
+  detector.Reset();
+  EXPECT_FALSE(detector.IsDecayed());
+}
+
+}  // namespace
+}  // namespace stinky_dsp
@@ -0,0 +1,665 @@
+// Copyright 2025
+// Unit tests for SIMD utilities
+
+#include "simd_utils.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace stinky_dsp {
+namespace simd {
+namespace {
+
+constexpr float kEpsilon = 1e-5f;
+constexpr size_t kBufferSize = 1024;
+
+class SimdUtilsTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    src1_.resize(kBufferSize);
+    src2_.resize(kBufferSize);
+    dest_.resize(kBufferSize);
+    
+    // Fill with test data
+    for (size_t i = 0; i < kBufferSize; ++i) {
+      src1_[i] = static_cast<float>(i) / 100.0f;
+      src2_[i] = static_cast<float>(i + 1) / 200.0f;
+      dest_[i] = 0.0f;
+    }
+  }
+
+  std::vector<float> src1_;
+  std::vector<float> src2_;
+  std::vector<float> dest_;
+};
+
+TEST_F(SimdUtilsTest, IsSimdAvailableReturnsConsistently) {
+  bool result1 = IsSimdAvailable();
+  bool result2 = IsSimdAvailable();
+  EXPECT_EQ(result1, result2);
+}
+
+TEST_F(SimdUtilsTest, MultiplyAddCorrectResults) {
+  const float multiplier = 2.5f;
+  
+  // Set initial dest values
+  for (size_t i = 0; i < kBufferSize; ++i) {
+    dest_[i] = 1.0f;
+  }
+
+  MultiplyAdd(dest_.data(), src1_.data(), multiplier, kBufferSize);
+
+  // Verify: dest[i] = dest[i] + src1[i] * multiplier
+  for (size_t i = 0; i < kBufferSize; ++i) {
+    float expected = 1.0f + src1_[i] * multiplier;
+    EXPECT_NEAR(dest_[i], expected, kEpsilon);
+  }
+}
+
+TEST_F(SimdUtilsTest, MultiplyCorrectResults) {
+  const float multiplier = 3.0f;
+
+  Multiply(dest_.data(), src1_.data(), multiplier, kBufferSize);
+
+  // Verify: dest[i] = src1[i] * multiplier
+  for (size_t i = 0; i < kBufferSize; ++i) {
+    float expected = src1_[i] * multiplier;
+    EXPECT_NEAR(dest_[i], expected, kEpsilon);
+  }
+}
+
+TEST_F(SimdUtilsTest, ApplyGainCorrectResults) {
+  const float gain = 0.5f;
+  std::vector<float> buffer = src1_;
+
+  ApplyGain(buffer.data(), gain, kBufferSize);
+
+  // Verify: buffer[i] *= gain
+  for (size_t i = 0; i < kBufferSize; ++i) {
+    float expected = src1_[i] * gain;
+    EXPECT_NEAR(buffer[i], expected, kEpsilon);
+  }
+}
+
+TEST_F(SimdUtilsTest, MaxCorrectResults) {
+  Max(dest_.data(), src1_.data(), src2_.data(), kBufferSize);
+
+  // Verify: dest[i] = max(src1[i], src2[i])
+  for (size_t i = 0; i < kBufferSize; ++i) {
+    float expected = std::max(src1_[i], src2_[i]);
+    EXPECT_NEAR(dest_[i], expected, kEpsilon);
+  }
+}
+
+TEST_F(SimdUtilsTest, MinCorrectResults) {
+  Min(dest_.data(), src1_.data(), src2_.data(), kBufferSize);
+
+  // Verify: dest[i] = min(src1[i], src2[i])
+  for (size_t i = 0; i < kBufferSize; ++i) {
+    float expected = std::min(src1_[i], src2_[i]);
+    EXPECT_NEAR(dest_[i], expected, kEpsilon);
+  }
+}
+
+TEST_F(SimdUtilsTest, MaxAbsCorrectResults) {
+  for (size_t i = 0; i < kBufferSize; ++i) {
+    src1_[i] = (i % 3 == 0) ? -src1_[i] : src1_[i];
+    src2_[i] = (i % 2 == 0) ? -src2_[i] : src2_[i];
+  }
+
+  MaxAbs(dest_.data(), src1_.data(), src2_.data(), kBufferSize);
+
+  for (size_t i = 0; i < kBufferSize; ++i) {
+    float expected = std::max(std::abs(src1_[i]), std::abs(src2_[i]));
+    EXPECT_FLOAT_EQ(dest_[i], expected);
+  }
+}
+
+TEST_F(SimdUtilsTest, PeakAbsFindsLargestMagnitude) {
+  EXPECT_EQ(PeakAbs(src1_.data(), 0), 0.0f);
+
+  std::vector<float> silence(kBufferSize, 0.0f);
+  EXPECT_EQ(PeakAbs(silence.data(), kBufferSize), 0.0f);
+
+  // Negative peak in the loop tail
+  silence[kBufferSize - 1] = -0.25f;
+  silence[5] = 0.125f;
+  EXPECT_EQ(PeakAbs(silence.data(), kBufferSize), 0.25f);
+}
+
+TEST_F(SimdUtilsTest, DoubleInputPeaksMatchFloat) {
+  std::vector<double> left(kBufferSize);
+  std::vector<double> right(kBufferSize);
+  for (size_t i = 0; i < kBufferSize; ++i) {
+    left[i] = (i % 3 == 0) ? -src1_[i] : src1_[i];
+    right[i] = (i % 2 == 0) ? -src2_[i] : src2_[i];
+  }
+
+  MaxAbs(dest_.data(), left.data(), right.data(), kBufferSize);
+  for (size_t i = 0; i < kBufferSize; ++i) {
+    EXPECT_FLOAT_EQ(dest_[i],
+                    std::max(std::abs(src1_[i]), std::abs(src2_[i])));
+  }
+
+  EXPECT_EQ(PeakAbs(left.data(), 0), 0.0);
+  left[7] = -1e6;
+  EXPECT_EQ(PeakAbs(left.data(), kBufferSize), 1e6);
+}
+
+TEST_F(SimdUtilsTest, ChannelMaxAbsLinksEveryChannel) {
+  // Five channels, each holding the peak at a different frame
+  std::vector<std::vector<float>> channels(5,
+                                           std::vector<float>(kBufferSize));
+  std::vector<std::vector<double>> wide(5, std::vector<double>(kBufferSize));
+  const float* pointers[5];
+  const double* wide_pointers[5];
+  for (size_t c = 0; c < channels.size(); ++c) {
+    for (size_t i = 0; i < kBufferSize; ++i) {
+      const float sign = (i + c) % 2 == 0 ? -1.0f : 1.0f;
+      channels[c][i] = sign * ((i % 5 == c) ? 2.0f : 0.1f * c);
+      wide[c][i] = channels[c][i];
+    }
+    pointers[c] = channels[c].data();
+    wide_pointers[c] = wide[c].data();
+  }
+
+  MaxAbs(dest_.data(), pointers, 5, kBufferSize);
+  for (size_t i = 0; i < kBufferSize; ++i) {
+    EXPECT_EQ(dest_[i], 2.0f) << i;
+  }
+  MaxAbs(dest_.data(), wide_pointers, 5, kBufferSize);
+  for (size_t i = 0; i < kBufferSize; ++i) {
+    EXPECT_EQ(dest_[i], 2.0f) << i;
+  }
+
+  // One channel is its own peak
+  MaxAbs(dest_.data(), pointers + 3, 1, kBufferSize);
+  for (size_t i = 0; i < kBufferSize; ++i) {
+    EXPECT_EQ(dest_[i], std::abs(channels[3][i])) << i;
+  }
+}
+
+TEST_F(SimdUtilsTest, ComputeGainReductionDbMatchesScalarCurve) {
+  constexpr float kThreshold = -20.0f;
+  constexpr float kSlope = 1.0f / 4.0f - 1.0f;
+
+  // Sweep -40..+10 dB, covering below, inside and above the knee
+  std::vector<float> levels(kBufferSize);
+  for (size_t i = 0; i < kBufferSize; ++i) {
+    levels[i] = -40.0f + 50.0f * static_cast<float>(i) / kBufferSize;
+  }
+
+  for (float knee : {0.0f, 6.0f}) {
+    ComputeGainReductionDb(dest_.data(), levels.data(), kThreshold, kSlope,
+                           knee, kBufferSize);
+
+    for (size_t i = 0; i < kBufferSize; ++i) {
+      const float level = levels[i];
+      const float overshoot = level - kThreshold;
+      float expected = 0.0f;
+      if (knee > 0.0f && level > kThreshold - knee / 2.0f &&
+          level < kThreshold + knee / 2.0f) {
+        expected = overshoot * kSlope *
+                   ((level - kThreshold + knee / 2.0f) / knee);
+      } else if (level > kThreshold) {
+        expected = overshoot * kSlope;
+      }
+      EXPECT_NEAR(dest_[i], expected, 1e-4f) << "level " << level;
+    }
+  }
+}
+
+TEST_F(SimdUtilsTest, ConvertToDbHandlesZero) {
+  std::vector<float> zeros(kBufferSize, 0.0f);
+  ConvertToDb(dest_.data(), zeros.data(), kBufferSize);
+
+  // Should not crash and should produce valid (very negative) dB values
+  for (size_t i = 0; i < kBufferSize; ++i) {
+    EXPECT_LT(dest_[i], -80.0f);  // Very quiet
+    EXPECT_TRUE(std::isfinite(dest_[i]));
+  }
+}
+
+TEST_F(SimdUtilsTest, ConvertToDbCorrectResults) {
+  std::vector<float> signal = {0.5f, 1.0f, 0.1f, 0.01f};
+  std::vector<float> result(signal.size());
+
+  ConvertToDb(result.data(), signal.data(), signal.size());
+
+  // Verify dB conversion: 20 * log10(abs(x))
+  EXPECT_NEAR(result[0], 20.0f * ::log10f(0.5f), 0.1f);
+  EXPECT_NEAR(result[1], 20.0f * ::log10f(1.0f), 0.1f);
+  EXPECT_NEAR(result[2], 20.0f * ::log10f(0.1f), 0.1f);
+  EXPECT_NEAR(result[3], 20.0f * ::log10f(0.01f), 0.1f);
+}
+
+// Documented bounds of the dB conversions in simd_utils.h
+constexpr double kLinearToDbMaxErrorDb = 2e-4;
+constexpr double kDbToLinearMaxErrorDb = 5e-5;
+
+// Dense dB sweep from -200 to +40 dB, an odd count so every tail runs
+std::vector<double> DbSweep() {
+  constexpr size_t kCount = 2000001;
+  std::vector<double> db(kCount);
+  for (size_t i = 0; i < kCount; ++i) {
+    db[i] = -200.0 + 240.0 * static_cast<double>(i) / (kCount - 1);
+  }
+  return db;
+}
+
+constexpr Isa kAllIsas[] = {Isa::kScalar, Isa::kSse2, Isa::kAvx2,
+                            Isa::kAvx512};
+
+TEST_F(SimdUtilsTest, LinearToDbMaxErrorBelowTolerance) {
+  const std::vector<double> db = DbSweep();
+  std::vector<float> linear(db.size());
+  for (size_t i = 0; i < db.size(); ++i) {
+    linear[i] = static_cast<float>(std::pow(10.0, db[i] / 20.0));
+  }
+
+  // The scalar helper is not dispatched
+  double helper_error = 0.0;
+  for (float value : linear) {
+    const double expected =
+        20.0 * std::log10(std::max(static_cast<double>(value), 1e-8));
+    helper_error =
+        std::max(helper_error, std::abs(LinearToDb(value) - expected));
+  }
+  EXPECT_LT(helper_error, kLinearToDbMaxErrorDb);
+
+  std::vector<float> result(linear.size());
+  for (Isa isa : kAllIsas) {
+    if (!SetIsa(isa)) continue;
+    LinearToDb(result.data(), linear.data(), linear.size());
+
+    double max_error = 0.0;
+    float worst = 0.0f;
+    for (size_t i = 0; i < linear.size(); ++i) {
+      const double expected =
+          20.0 * std::log10(std::max(static_cast<double>(linear[i]), 1e-8));
+      const double error = std::abs(result[i] - expected);
+      if (error > max_error) {
+        max_error = error;
+        worst = linear[i];
+      }
+    }
+    EXPECT_LT(max_error, kLinearToDbMaxErrorDb)
+        << IsaName(isa) << ", worst at linear " << worst;
+  }
+  SetIsa(DetectIsa());
+}
+
+TEST_F(SimdUtilsTest, DbToLinearMaxErrorBelowTolerance) {
+  const std::vector<double> sweep = DbSweep();
+  std::vector<float> db(sweep.begin(), sweep.end());
+
+  // Compared in dB, so the tolerance is uniform across the range
+  auto error_db = [](float actual, float db_value) {
+    const double expected = std::pow(10.0, db_value / 20.0);
+    return std::abs(20.0 * std::log10(actual / expected));
+  };
+
+  double helper_error = 0.0;
+  for (float value : db) {
+    helper_error = std::max(helper_error, error_db(DbToLinear(value), value));
+  }
+  EXPECT_LT(helper_error, kDbToLinearMaxErrorDb);
+
+  std::vector<float> result(db.size());
+  for (Isa isa : kAllIsas) {
+    if (!SetIsa(isa)) continue;
+    DbToLinear(result.data(), db.data(), db.size());
+
+    double max_error = 0.0;
+    float worst = 0.0f;
+    for (size_t i = 0; i < db.size(); ++i) {
+      const double error = error_db(result[i], db[i]);
+      if (error > max_error) {
+        max_error = error;
+        worst = db[i];
+      }
+    }
+    EXPECT_LT(max_error, kDbToLinearMaxErrorDb)
+        << IsaName(isa) << ", worst at " << worst << " dB";
+  }
+  SetIsa(DetectIsa());
+}
+
+TEST_F(SimdUtilsTest, DbConversionsMapUnityExactly) {
+  std::vector<float> ones(kBufferSize, 1.0f);
+  std::vector<float> zeros(kBufferSize, 0.0f);
+
+  LinearToDb(dest_.data(), ones.data(), kBufferSize);
+  for (size_t i = 0; i < kBufferSize; ++i) {
+    EXPECT_EQ(dest_[i], 0.0f);
+  }
+
+  DbToLinear(dest_.data(), zeros.data(), kBufferSize);
+  for (size_t i = 0; i < kBufferSize; ++i) {
+    EXPECT_EQ(dest_[i], 1.0f);
+  }
+}
+
+TEST_F(SimdUtilsTest, OperationsHandleNonMultipleOf8) {
+  // Test with sizes that aren't multiples of 8 (SIMD width)
+  std::vector<size_t> test_sizes = {1, 7, 15, 17, 63, 127};
+
+  for (size_t size : test_sizes) {
+    std::vector<float> a(size, 2.0f);
+    std::vector<float> b(size, 3.0f);
+    std::vector<float> result(size, 0.0f);
+
+    // Test each operation
+    Multiply(result.data(), a.data(), 2.0f, size);
+    for (size_t i = 0; i < size; ++i) {
+      EXPECT_NEAR(result[i], 4.0f, kEpsilon);
+    }
+
+    Max(result.data(), a.data(), b.data(), size);
+    for (size_t i = 0; i < size; ++i) {
+      EXPECT_NEAR(result[i], 3.0f, kEpsilon);
+    }
+
+    Min(result.data(), a.data(), b.data(), size);
+    for (size_t i = 0; i < size; ++i) {
+      EXPECT_NEAR(result[i], 2.0f, kEpsilon);
+    }
+  }
+}
+
+TEST_F(SimdUtilsTest, ApplyGainHandlesZeroGain) {
+  std::vector<float> buffer = src1_;
+  ApplyGain(buffer.data(), 0.0f, kBufferSize);
+
+  for (size_t i = 0; i < kBufferSize; ++i) {
+    EXPECT_FLOAT_EQ(buffer[i], 0.0f);
+  }
+}
+
+TEST_F(SimdUtilsTest, ApplyGainHandlesNegativeGain) {
+  std::vector<float> buffer = src1_;
+  const float gain = -2.0f;
+  
+  ApplyGain(buffer.data(), gain, kBufferSize);
+
+  for (size_t i = 0; i < kBufferSize; ++i) {
+    float expected = src1_[i] * gain;
+    EXPECT_NEAR(buffer[i], expected, kEpsilon);
+  }
+}
+
+TEST_F(SimdUtilsTest, MultiplyAddHandlesZeroMultiplier) {
+  for (size_t i = 0; i < kBufferSize; ++i) {
+    dest_[i] = 5.0f;
+  }
+
+  MultiplyAdd(dest_.data(), src1_.data(), 0.0f, kBufferSize);
+
+  // dest should remain unchanged
+  for (size_t i = 0; i < kBufferSize; ++i) {
+    EXPECT_FLOAT_EQ(dest_[i], 5.0f);
+  }
+}
+
+TEST_F(SimdUtilsTest, MaxWithNegativeValues) {
+  for (size_t i = 0; i < kBufferSize; ++i) {
+    src1_[i] = -static_cast<float>(i) / 100.0f;
+    src2_[i] = -static_cast<float>(i + 10) / 100.0f;
+  }
+
+  Max(dest_.data(), src1_.data(), src2_.data(), kBufferSize);
+
+  for (size_t i = 0; i < kBufferSize; ++i) {
+    float expected = std::max(src1_[i], src2_[i]);
+    EXPECT_NEAR(dest_[i], expected, kEpsilon);
+  }
+}
+
+TEST_F(SimdUtilsTest, SimdVsScalarConsistency) {
+  // This test verifies SIMD and scalar paths produce same results
+  // by running operations on different sizes
+  
+  const float multiplier = 1.5f;
+  std::vector<float> src(100);
+  for (size_t i = 0; i < src.size(); ++i) {
+    src[i] = static_cast<float>(i) * 0.01f;
+  }
+
+  // Test small size (likely scalar)
+  std::vector<float> dest_small(5, 1.0f);
+  MultiplyAdd(dest_small.data(), src.data(), multiplier, 5);
+
+  // Test large size (likely SIMD)
+  std::vector<float> dest_large(5, 1.0f);
+  std::vector<float> src_large(src.begin(), src.begin() + 5);
+  MultiplyAdd(dest_large.data(), src_large.data(), multiplier, 5);
+
+  // Results should match
+  for (size_t i = 0; i < 5; ++i) {
+    EXPECT_NEAR(dest_small[i], dest_large[i], kEpsilon);
+  }
+}
+
+TEST_F(SimdUtilsTest, LargeBufferPerformance) {
+  // Test with realistic audio buffer size
+  constexpr size_t audio_buffer_size = 8192;
+  std::vector<float> large_src(audio_buffer_size, 0.5f);
+  std::vector<float> large_dest(audio_buffer_size, 1.0f);
+
+  MultiplyAdd(large_dest.data(), large_src.data(), 2.0f, audio_buffer_size);
+
+  // Verify correctness on large buffer
+  for (size_t i = 0; i < audio_buffer_size; ++i) {
+    EXPECT_NEAR(large_dest[i], 2.0f, kEpsilon);
+  }
+}
+
+TEST(SimdDispatchTest, DetectedIsaCanBeActivated) {
+  const Isa detected = DetectIsa();
+  EXPECT_TRUE(SetIsa(Isa::kScalar));
+  EXPECT_EQ(ActiveIsa(), Isa::kScalar);
+  EXPECT_TRUE(SetIsa(detected));
+  EXPECT_EQ(ActiveIsa(), detected);
+}
+
+TEST(SimdDispatchTest, ConcurrentInitializeSelectsDetectedIsa) {
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; ++i) {
+    threads.emplace_back([] { Initialize(); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(ActiveIsa(), DetectIsa());
+}
+
+TEST(SimdDispatchTest, UnsupportedIsaIsRejected) {
+  SetIsa(DetectIsa());
+  if (DetectIsa() == Isa::kAvx512) {
+    GTEST_SKIP() << "every kernel set is supported here";
+  }
+  EXPECT_FALSE(SetIsa(Isa::kAvx512));
+  EXPECT_EQ(ActiveIsa(), DetectIsa());
+}
+
+// Runs every kernel through one forced kernel set and compares against the
+// scalar set, over sizes that exercise the vector bodies and every tail.
+class SimdIsaTest : public ::testing::TestWithParam<Isa> {
+ protected:
+  void SetUp() override {
+    if (!SetIsa(GetParam())) {
+      GTEST_SKIP() << IsaName(GetParam()) << " not supported on this CPU";
+    }
+  }
+
+  void TearDown() override { SetIsa(DetectIsa()); }
+
+  // Runs `op` with the scalar set and then the tested set, returning both
+  template <typename Op>
+  static void RunBoth(Op op, std::vector<float>* expected,
+                      std::vector<float>* actual) {
+    SetIsa(Isa::kScalar);
+    op(expected);
+    SetIsa(GetParam());
+    op(actual);
+  }
+
+  static std::vector<float> Signal(size_t count, float scale, float offset) {
+    std::vector<float> signal(count);
+    for (size_t i = 0; i < count; ++i) {
+      signal[i] = offset + scale * std::sin(0.37f * static_cast<float>(i));
+    }
+    return signal;
+  }
+
+  static constexpr size_t kSizes[] = {0, 1, 3, 4, 7, 8, 15, 16, 17, 33, 100};
+};
+
+TEST_P(SimdIsaTest, ArithmeticMatchesScalar) {
+  for (size_t count : kSizes) {
+    const std::vector<float> a = Signal(count, 1.5f, 0.0f);
+    const std::vector<float> b = Signal(count + 5, 0.8f, -0.2f);
+    std::vector<float> expected;
+    std::vector<float> actual;
+
+    RunBoth([&](std::vector<float>* out) {
+      *out = b;
+      MultiplyAdd(out->data(), a.data(), 0.75f, count);
+    }, &expected, &actual);
+    // Fused multiply-add rounds once, the scalar form twice
+    for (size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_NEAR(actual[i], expected[i], kEpsilon) << "MultiplyAdd " << i;
+    }
+
+    RunBoth([&](std::vector<float>* out) {
+      *out = b;
+      Multiply(out->data(), a.data(), -2.0f, count);
+    }, &expected, &actual);
+    EXPECT_EQ(expected, actual) << "Multiply, count " << count;
+
+    RunBoth([&](std::vector<float>* out) {
+      *out = b;
+      ApplyGain(out->data(), 0.5f, count);
+    }, &expected, &actual);
+    EXPECT_EQ(expected, actual) << "ApplyGain, count " << count;
+
+    RunBoth([&](std::vector<float>* out) {
+      *out = b;
+      Max(out->data(), a.data(), b.data(), count);
+    }, &expected, &actual);
+    EXPECT_EQ(expected, actual) << "Max, count " << count;
+
+    RunBoth([&](std::vector<float>* out) {
+      *out = b;
+      Min(out->data(), a.data(), b.data(), count);
+    }, &expected, &actual);
+    EXPECT_EQ(expected, actual) << "Min, count " << count;
+
+    RunBoth([&](std::vector<float>* out) {
+      *out = b;
+      MaxAbs(out->data(), a.data(), b.data(), count);
+    }, &expected, &actual);
+    EXPECT_EQ(expected, actual) << "MaxAbs, count " << count;
+
+    RunBoth([&](std::vector<float>* out) {
+      out->assign(1, PeakAbs(a.data(), count));
+    }, &expected, &actual);
+    EXPECT_EQ(expected, actual) << "PeakAbs, count " << count;
+  }
+}
+
+TEST_P(SimdIsaTest, DbConversionsMatchScalar) {
+  // FMA rounding differs from the scalar polynomial in the last bits
+  constexpr float kDbTolerance = 1e-4f;
+  constexpr float kRelTolerance = 1e-5f;
+
+  for (size_t count : kSizes) {
+    const std::vector<float> linear = Signal(count, 2.0f, 0.0f);
+    const std::vector<float> db = Signal(count, 60.0f, -20.0f);
+    std::vector<float> expected;
+    std::vector<float> actual;
+
+    RunBoth([&](std::vector<float>* out) {
+      out->assign(count, 0.0f);
+      ConvertToDb(out->data(), linear.data(), count);
+    }, &expected, &actual);
+    for (size_t i = 0; i < count; ++i) {
+      EXPECT_NEAR(actual[i], expected[i], kDbTolerance) << "ConvertToDb " << i;
+    }
+
+    RunBoth([&](std::vector<float>* out) {
+      out->assign(count, 0.0f);
+      LinearToDb(out->data(), linear.data(), count);
+    }, &expected, &actual);
+    for (size_t i = 0; i < count; ++i) {
+      EXPECT_NEAR(actual[i], expected[i], kDbTolerance) << "LinearToDb " << i;
+    }
+
+    RunBoth([&](std::vector<float>* out) {
+      out->assign(count, 0.0f);
+      DbToLinear(out->data(), db.data(), count);
+    }, &expected, &actual);
+    for (size_t i = 0; i < count; ++i) {
+      EXPECT_NEAR(actual[i], expected[i], kRelTolerance * expected[i])
+          << "DbToLinear " << i;
+    }
+  }
+}
+
+TEST_P(SimdIsaTest, GainReductionMatchesScalar) {
+  constexpr float kDbTolerance = 1e-5f;
+
+  for (size_t count : kSizes) {
+    const std::vector<float> level = Signal(count, 30.0f, -20.0f);
+    for (float knee : {0.0f, 6.0f}) {
+      std::vector<float> expected;
+      std::vector<float> actual;
+      RunBoth([&](std::vector<float>* out) {
+        out->assign(count, 0.0f);
+        ComputeGainReductionDb(out->data(), level.data(), -18.0f, -0.75f,
+                               knee, count);
+      }, &expected, &actual);
+      for (size_t i = 0; i < count; ++i) {
+        EXPECT_NEAR(actual[i], expected[i], kDbTolerance)
+            << "knee " << knee << ", index " << i;
+      }
+    }
+  }
+}
+
+TEST_P(SimdIsaTest, FirMatchesScalar) {
+  constexpr float kTaps[] = {0.1f, -0.3f, 0.9f, 0.25f, -0.05f};
+  constexpr size_t kNumTaps = std::size(kTaps);
+
+  for (size_t count : kSizes) {
+    // The filter reads kNumTaps - 1 frames of history before the block
+    const std::vector<float> signal = Signal(count + kNumTaps - 1, 1.0f, 0.1f);
+    const float* src = signal.data() + kNumTaps - 1;
+    std::vector<float> expected;
+    std::vector<float> actual;
+    RunBoth([&](std::vector<float>* out) {
+      out->assign(count, 0.0f);
+      Fir(out->data(), src, kTaps, kNumTaps, count);
+    }, &expected, &actual);
+    for (size_t i = 0; i < count; ++i) {
+      EXPECT_NEAR(actual[i], expected[i], kEpsilon) << "index " << i;
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    AllIsas, SimdIsaTest,
+    ::testing::Values(Isa::kScalar, Isa::kSse2, Isa::kAvx2, Isa::kAvx512),
+    [](const ::testing::TestParamInfo<Isa>& info) {
+      return std::string(IsaName(info.param));
+    });
+
+}  // namespace
+}  // namespace simd
+}  // namespace stinky_dsp
@@ -0,0 +1,101 @@
+// Copyright 2025
+// Unit tests for SlidingMax and MovingAverage
+
+#include "sliding_window.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace stinky_dsp {
+namespace {
+
+// Deterministic values in [0, 1), with runs and repeats
+std::vector<float> TestValues(size_t count) {
+  std::vector<float> values(count);
+  uint32_t state = 12345;
+  for (size_t i = 0; i < count; ++i) {
+    state = state * 1664525u + 1013904223u;
+    values[i] = static_cast<float>(state >> 8) / 16777216.0f;
+    if (i % 7 == 3) values[i] = values[i - 1];
+  }
+  return values;
+}
+
+TEST(SlidingMaxTest, MatchesBruteForceForEveryWindow) {
+  const std::vector<float> values = TestValues(1000);
+  SlidingMax running(64);
+
+  for (size_t window : {1, 2, 3, 17, 64}) {
+    running.SetWindow(window);
+    EXPECT_EQ(running.Window(), window);
+    for (size_t i = 0; i < values.size(); ++i) {
+      const size_t first = i + 1 >= window ? i + 1 - window : 0;
+      const float expected = *std::max_element(values.begin() + first,
+                                               values.begin() + i + 1);
+      ASSERT_EQ(running.Push(values[i]), expected)
+          << "window " << window << ", value " << i;
+    }
+  }
+}
+
+TEST(SlidingMaxTest, PeakIsHeldForTheWindowThenDropped) {
+  SlidingMax running(8);
+  running.SetWindow(4);
+
+  EXPECT_EQ(running.Push(1.0f), 1.0f);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(running.Push(0.0f), 1.0f);
+  }
+  EXPECT_EQ(running.Push(0.0f), 0.0f);
+
+  // Reset forgets the peak at once
+  running.Push(1.0f);
+  running.Reset();
+  EXPECT_EQ(running.Push(0.5f), 0.5f);
+}
+
+TEST(SlidingMaxTest, WindowIsClampedToTheAllocation) {
+  SlidingMax running(8);
+  running.SetWindow(100);
+  EXPECT_EQ(running.Window(), 8u);
+  running.SetWindow(0);
+  EXPECT_EQ(running.Window(), 1u);
+}
+
+TEST(MovingAverageTest, MatchesBruteForceForEveryWindow) {
+  const std::vector<float> values = TestValues(1000);
+  MovingAverage average(64);
+
+  for (size_t window : {1, 2, 17, 64}) {
+    average.SetWindow(window, 0.0f);
+    for (size_t i = 0; i < values.size(); ++i) {
+      double sum = 0.0;
+      for (size_t j = 0; j < window && j <= i; ++j) {
+        sum += values[i - j];
+      }
+      ASSERT_NEAR(average.Push(values[i]), sum / static_cast<double>(window),
+                  1e-6)
+          << "window " << window << ", value " << i;
+    }
+  }
+}
+
+TEST(MovingAverageTest, StepBecomesLinearRampOverTheWindow) {
+  MovingAverage average(16);
+  average.SetWindow(4, 1.0f);
+
+  // From 1 to 0 in four equal steps, reaching 0 with the fourth value
+  EXPECT_FLOAT_EQ(average.Push(0.0f), 0.75f);
+  EXPECT_FLOAT_EQ(average.Push(0.0f), 0.5f);
+  EXPECT_FLOAT_EQ(average.Push(0.0f), 0.25f);
+  EXPECT_FLOAT_EQ(average.Push(0.0f), 0.0f);
+
+  average.Reset(0.5f);
+  EXPECT_FLOAT_EQ(average.Push(0.5f), 0.5f);
+}
+
+}  // namespace
+}  // namespace stinky_dsp
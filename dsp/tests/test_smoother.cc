@@ -0,0 +1,132 @@
+// Copyright 2025
+// Unit tests for Smoother
+
+#include "smoother.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+namespace stinky_dsp {
+namespace {
+
+constexpr double kSampleRate = 48000.0;
+constexpr double kRampMs = 1.0;  // 48 samples
+constexpr size_t kRampSamples = 48;
+
+TEST(SmootherTest, ResetJumpsWithoutRamp) {
+  Smoother smoother;
+  smoother.Configure(SmoothingType::kLinear, kSampleRate, kRampMs);
+  smoother.Reset(0.5f);
+
+  EXPECT_FALSE(smoother.IsSmoothing());
+  EXPECT_EQ(smoother.Current(), 0.5f);
+  EXPECT_EQ(smoother.Next(), 0.5f);
+}
+
+TEST(SmootherTest, LinearRampReachesTargetExactly) {
+  Smoother smoother;
+  smoother.Configure(SmoothingType::kLinear, kSampleRate, kRampMs);
+  smoother.Reset(0.0f);
+  smoother.SetTarget(1.0f);
+
+  float previous = 0.0f;
+  for (size_t i = 1; i < kRampSamples; ++i) {
+    const float value = smoother.Next();
+    EXPECT_NEAR(value, static_cast<float>(i) / kRampSamples, 1e-5f);
+    EXPECT_GT(value, previous);
+    previous = value;
+  }
+  EXPECT_TRUE(smoother.IsSmoothing());
+  EXPECT_EQ(smoother.Next(), 1.0f);
+  EXPECT_FALSE(smoother.IsSmoothing());
+}
+
+TEST(SmootherTest, OnePoleApproachesThenSnaps) {
+  Smoother smoother;
+  smoother.Configure(SmoothingType::kOnePole, kSampleRate, kRampMs);
+  smoother.Reset(0.0f);
+  smoother.SetTarget(1.0f);
+
+  // Exponential: the first step is the largest
+  const float first = smoother.Next();
+  const float second = smoother.Next();
+  EXPECT_GT(first, second - first);
+
+  float value = second;
+  for (size_t i = 2; i < kRampSamples - 1; ++i) {
+    value = smoother.Next();
+  }
+  EXPECT_LT(value, 1.0f);
+  EXPECT_GT(value, 0.998f);
+  EXPECT_EQ(smoother.Next(), 1.0f);
+  EXPECT_FALSE(smoother.IsSmoothing());
+}
+
+TEST(SmootherTest, AdvanceMatchesPerSampleSteps) {
+  for (SmoothingType type : {SmoothingType::kLinear, SmoothingType::kOnePole}) {
+    Smoother per_sample;
+    Smoother per_block;
+    for (Smoother* smoother : {&per_sample, &per_block}) {
+      smoother->Configure(type, kSampleRate, kRampMs);
+      smoother->Reset(-20.0f);
+      smoother->SetTarget(-6.0f);
+    }
+
+    for (size_t block = 0; block < 4; ++block) {
+      float expected = 0.0f;
+      for (size_t i = 0; i < 16; ++i) {
+        expected = per_sample.Next();
+      }
+      EXPECT_NEAR(per_block.Advance(16), expected, 1e-4f);
+    }
+    EXPECT_FALSE(per_block.IsSmoothing());
+    EXPECT_EQ(per_block.Current(), -6.0f);
+  }
+}
+
+TEST(SmootherTest, ProcessFillsRampThenTarget) {
+  Smoother smoother;
+  smoother.Configure(SmoothingType::kLinear, kSampleRate, kRampMs);
+  smoother.Reset(1.0f);
+  smoother.SetTarget(0.0f);
+
+  std::vector<float> values(100);
+  smoother.Process(values.data(), values.size());
+
+  EXPECT_NEAR(values[0], 1.0f - 1.0f / kRampSamples, 1e-5f);
+  for (size_t i = kRampSamples - 1; i < values.size(); ++i) {
+    EXPECT_EQ(values[i], 0.0f);
+  }
+}
+
+TEST(SmootherTest, RetargetingContinuesFromCurrentValue) {
+  Smoother smoother;
+  smoother.Configure(SmoothingType::kLinear, kSampleRate, kRampMs);
+  smoother.Reset(0.0f);
+  smoother.SetTarget(1.0f);
+  const float midway = smoother.Advance(kRampSamples / 2);
+
+  // Same target again does not restart the ramp
+  smoother.SetTarget(1.0f);
+  EXPECT_NEAR(smoother.Advance(kRampSamples / 2), 1.0f, 1e-6f);
+
+  smoother.Reset(midway);
+  smoother.SetTarget(0.0f);
+  EXPECT_LT(smoother.Next(), midway);
+  EXPECT_GT(smoother.Current(), 0.0f);
+}
+
+TEST(SmootherTest, ZeroRampTimeJumps) {
+  Smoother smoother;
+  smoother.Configure(SmoothingType::kOnePole, kSampleRate, 0.0);
+  smoother.Reset(0.0f);
+  smoother.SetTarget(2.0f);
+
+  EXPECT_FALSE(smoother.IsSmoothing());
+  EXPECT_EQ(smoother.Next(), 2.0f);
+}
+
+}  // namespace
+}  // namespace stinky_dsp
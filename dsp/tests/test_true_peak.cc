@@ -0,0 +1,98 @@
+// Copyright 2025
+// Unit tests for TruePeakDetector
+
+#include "true_peak.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+namespace stinky_dsp {
+namespace {
+
+constexpr size_t kFrames = TruePeakDetector::kMaxBlockSize;
+
+// Level of a mono signal, skipping the filter's start-up
+float SettledLevel(const std::vector<float>& signal) {
+  TruePeakDetector detector;
+  std::vector<float> level(kFrames);
+  const float* channels[] = {signal.data()};
+  detector.Process(level.data(), channels, 1, kFrames);
+  return *std::max_element(level.begin() + 32, level.end());
+}
+
+TEST(TruePeakDetectorTest, FindsInterSamplePeakAtQuarterSampleRate) {
+  // Samples land 45 degrees off the crests: sample peak 0.707, true peak 1
+  std::vector<float> signal(kFrames);
+  for (size_t i = 0; i < kFrames; ++i) {
+    signal[i] = std::sin(std::numbers::pi_v<float> / 2.0f *
+                             static_cast<float>(i) +
+                         std::numbers::pi_v<float> / 4.0f);
+  }
+  const float level = SettledLevel(signal);
+  EXPECT_GT(level, 0.97f);
+  EXPECT_LT(level, 1.01f);
+}
+
+TEST(TruePeakDetectorTest, LowFrequencyLevelIsTheSamplePeak) {
+  std::vector<float> signal(kFrames);
+  for (size_t i = 0; i < kFrames; ++i) {
+    signal[i] = 0.5f * std::sin(0.05f * static_cast<float>(i));
+  }
+  EXPECT_NEAR(SettledLevel(signal), 0.5f, 0.005f);
+}
+
+TEST(TruePeakDetectorTest, LevelTrailsInputByTheDelay) {
+  std::vector<float> signal(kFrames, 0.0f);
+  signal[10] = 1.0f;
+
+  TruePeakDetector detector;
+  std::vector<float> level(kFrames);
+  const float* channels[] = {signal.data()};
+  detector.Process(level.data(), channels, 1, kFrames);
+
+  const auto peak = std::max_element(level.begin(), level.end());
+  EXPECT_EQ(peak - level.begin(), 10 + TruePeakDetector::kDelay);
+  EXPECT_FLOAT_EQ(*peak, 1.0f);
+}
+
+TEST(TruePeakDetectorTest, IsLinkedAcrossChannelsAndBlockSizeInvariant) {
+  std::vector<float> left(kFrames);
+  std::vector<double> right(kFrames);
+  for (size_t i = 0; i < kFrames; ++i) {
+    left[i] = 0.3f * std::sin(1.3f * static_cast<float>(i));
+    right[i] = 0.6 * std::sin(2.9 * static_cast<double>(i));
+  }
+
+  // Each channel on its own, then both at once in uneven blocks
+  TruePeakDetector left_only;
+  TruePeakDetector right_only;
+  std::vector<float> left_level(kFrames);
+  std::vector<float> right_level(kFrames);
+  const float* left_channel[] = {left.data()};
+  const double* right_channel[] = {right.data()};
+  left_only.Process(left_level.data(), left_channel, 1, kFrames);
+  right_only.Process(right_level.data(), right_channel, 1, kFrames);
+
+  std::vector<float> right_float(right.begin(), right.end());
+  TruePeakDetector linked;
+  std::vector<float> level(kFrames);
+  for (size_t offset = 0; offset < kFrames; offset += 7) {
+    const size_t frames = std::min<size_t>(7, kFrames - offset);
+    const float* channels[] = {left.data() + offset,
+                               right_float.data() + offset};
+    linked.Process(level.data() + offset, channels, 2, frames);
+  }
+
+  for (size_t i = 0; i < kFrames; ++i) {
+    // Vector bodies and scalar tails may round differently
+    ASSERT_NEAR(level[i], std::max(left_level[i], right_level[i]), 1e-6f)
+        << "frame " << i;
+  }
+}
+
+}  // namespace
+}  // namespace stinky_dsp
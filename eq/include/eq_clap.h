@@ -10,6 +10,10 @@
 #include <memory>
 
 #include "eq_processor.h"
+#include "channel_layouts.h"
+#include "constant_detector.h"
+#include "process_stats.h"
+#include "silence_detector.h"
 
 namespace fast_eq {
 
@@ -74,7 +78,7 @@ class EqClap {
   explicit EqClap(const clap_host_t* host);
   ~EqClap() = default;
 
-  // CLAP plugin interface
+  // CLAP plugin interface. Activate is the only call that allocates.
   bool Init() noexcept;
   bool Activate(double sample_rate, uint32_t min_frames,
                 uint32_t max_frames) noexcept;
@@ -110,10 +114,34 @@ class EqClap {
   bool AudioPortsGet(uint32_t index, bool is_input,
                      clap_audio_port_info_t* info) const noexcept;
 
+  // Audio ports config extension: the layouts in stinky_dsp::kChannelLayouts.
+  // The host selects one while the plugin is deactivated.
+  uint32_t AudioPortsConfigCount() const noexcept;
+  bool AudioPortsConfigGet(uint32_t index,
+                           clap_audio_ports_config_t* config) const noexcept;
+  bool AudioPortsConfigSelect(clap_id config_id) noexcept;
+
   const clap_plugin_t* ClapPlugin() noexcept { return &plugin_; }
 
+  // Tail extension: frames of output after the input goes silent
+  uint32_t TailGet() const noexcept { return silence_.Tail(); }
+
+  // Per-block cost instrumentation (STINKY_EXT_PROCESS_STATS)
+  stinky_dsp::ProcessStats& GetProcessStats() noexcept {
+    return process_stats_;
+  }
+
  private:
   void ProcessParameterChanges(const clap_input_events_t* events) noexcept;
+  // Applies one event; returns true if it changed a parameter
+  bool ApplyEvent(const clap_event_header_t* header) noexcept;
+  // Process() for 32- or 64-bit buffers
+  template <typename T>
+  clap_process_status ProcessAudio(const clap_process_t* process,
+                                   const T* const* inputs,
+                                   T* const* outputs) noexcept;
+
+  // Pushes the bands marked in dirty_ to the processor; no-op when clean
   void UpdateProcessorParams() noexcept;
   double ParamIdToValue(clap_id param_id) const noexcept;
   void SetParamValue(clap_id param_id, double value) noexcept;
@@ -122,9 +150,21 @@ class EqClap {
   const clap_host_t* host_;
   EqProcessor processor_;
   
+  // Shared with the audio thread, which must never wait on a lock
+  static_assert(std::atomic<double>::is_always_lock_free);
   std::atomic<double> param_values_[kParamIdCount];
   double sample_rate_;
   bool is_processing_;
+  uint32_t channel_layout_;  // Index into stinky_dsp::kChannelLayouts
+  stinky_dsp::ProcessStats process_stats_;
+  stinky_dsp::SilenceDetector silence_;
+  stinky_dsp::ConstantDetector constant_;
+
+  // Parameters changed since the last UpdateProcessorParams: bit n for
+  // band n, kDirtyGlobal for output gain and bypass
+  static constexpr uint32_t kDirtyGlobal = 1u << 4;
+  static constexpr uint32_t kDirtyAll = (1u << 5) - 1;
+  uint32_t dirty_;
 };
 
 }  // namespace fast_eq
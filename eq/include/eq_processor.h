@@ -8,6 +8,10 @@
 #include <cstdint>
 #include <array>
 
+#include "biquad_cascade.h"
+#include "channels.h"
+#include "smoother.h"
+
 namespace fast_eq {
 
 // Filter types for each band
@@ -26,6 +30,8 @@ struct BandParams {
   float gain_db = 0.0f;
   float q = 0.707f;  // Q factor (bandwidth)
   bool enabled = true;
+
+  bool operator==(const BandParams&) const = default;
 };
 
 // 4-band EQ parameters
@@ -35,7 +41,7 @@ struct EqParams {
   bool bypass = false;
 };
 
-// Biquad filter implementation
+// Biquad coefficient designer and scalar reference filter
 class BiquadFilter {
  public:
   BiquadFilter();
@@ -49,12 +55,15 @@ class BiquadFilter {
   void SetHighShelf(double frequency, double gain_db, double q, double sample_rate);
   void SetBell(double frequency, double gain_db, double q, double sample_rate);
   
+  const stinky_dsp::BiquadCoefficients& Coefficients() const {
+    return coefficients_;
+  }
+
   float Process(float input);
   void Reset();
   
  private:
-  double b0_, b1_, b2_;
-  double a1_, a2_;
+  stinky_dsp::BiquadCoefficients coefficients_;
   double x1_, x2_;  // Input delay line
   double y1_, y2_;  // Output delay line
 };
@@ -65,10 +74,11 @@ class EqProcessor {
   EqProcessor();
   ~EqProcessor() = default;
 
-  // Initialize with sample rate
+  // [main thread] Initialize with sample rate
   void Initialize(double sample_rate);
 
-  // Set EQ parameters
+  // [audio thread] Set EQ parameters. Only bands whose parameters changed
+  // are redesigned.
   void SetParams(const EqParams& params);
   
   // Get current parameters
@@ -80,18 +90,72 @@ class EqProcessor {
   // Process audio buffer (stereo separate channels)
   void ProcessStereo(float* left, float* right, size_t num_frames);
 
-  // Reset internal state
+  // Process from input to output buffers of float or double samples. The
+  // output may be the input buffer itself.
+  template <typename T>
+  void ProcessStereo(const T* in_left, const T* in_right, T* out_left,
+                     T* out_right, size_t num_frames);
+
+  // Process `num_channels` (1 to stinky_dsp::kMaxChannels) channels from
+  // input to output buffers, every channel through the same bands.
+  // ProcessStereo with the same buffer on both sides is mono.
+  template <typename T>
+  void ProcessChannels(const T* const* inputs, T* const* outputs,
+                       uint32_t num_channels, size_t num_frames);
+
+  // [audio thread] Reset internal state
   void Reset();
 
+  // Frames for the enabled bands' ringing to fall 120 dB after the input
+  // goes silent, from the current (possibly ramping) coefficients
+  uint32_t GetTailFrames() const;
+
+  // True while any band or the output gain is still ramping
+  bool IsRamping() const;
+
  private:
+  // While any band or the output gain ramps, the cascade runs in sub-blocks
+  // of this many frames and ramping bands are redesigned between them
+  static constexpr size_t kRampBlockSize = 32;
+
+  // Block-rate ramps of the continuous band parameters. Type and enable
+  // changes apply immediately.
+  struct BandRamp {
+    stinky_dsp::Smoother log2_frequency;
+    stinky_dsp::Smoother gain_db;
+    stinky_dsp::Smoother q;
+
+    bool IsSmoothing() const {
+      return log2_frequency.IsSmoothing() || gain_db.IsSmoothing() ||
+             q.IsSmoothing();
+    }
+  };
+
   void UpdateBandCoefficients(size_t band_index);
 
+  // Advances every ramp by `num_frames` and redesigns the bands that moved
+  void AdvanceRamps(size_t num_frames);
+
+  // Runs `num_frames` frames from `offset` of every channel through the
+  // cascades
+  template <typename T>
+  void RunCascades(const T* const* inputs, T* const* outputs,
+                   uint32_t num_channels, size_t offset, size_t num_frames);
+
   EqParams params_;
   double sample_rate_;
+
+  std::array<BandRamp, 4> ramps_;
+  stinky_dsp::Smoother output_gain_;  // Linear
   
-  // Filters for left and right channels
-  std::array<BiquadFilter, 4> filters_left_;
-  std::array<BiquadFilter, 4> filters_right_;
+  // Per-band coefficient design (shared by both channels)
+  std::array<BiquadFilter, 4> filters_;
+
+  // Filter chains, one stage per band. Each runs a pair of channels in its
+  // SIMD lanes: channels 0 and 1 in the first, 2 and 3 in the next, and so
+  // on. An odd last channel runs alone.
+  std::array<stinky_dsp::BiquadCascade, stinky_dsp::kMaxChannels / 2>
+      cascades_;
 };
 
 }  // namespace fast_eq
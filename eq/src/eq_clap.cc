@@ -8,6 +8,10 @@
 #include <cstdio>
 #include <cstring>
 
+#include "process_block.h"
+#include "process_stats_extension.h"
+#include "simd_utils.h"
+
 namespace fast_eq {
 
 namespace {
@@ -27,6 +31,19 @@ constexpr const char* kFeatures[] = {
     nullptr
 };
 
+// Every port takes 64-bit buffers; PREFER_64BIT_AUDIO builds also ask for them
+constexpr uint32_t kSampleSizeFlags =
+#ifdef STINKY_PREFER_64BIT_AUDIO
+    CLAP_AUDIO_PORT_SUPPORTS_64BITS | CLAP_AUDIO_PORT_PREFERS_64BITS;
+#else
+    CLAP_AUDIO_PORT_SUPPORTS_64BITS;
+#endif
+
+// Main input and output are processed at one sample size
+constexpr uint32_t kMainPortFlags = CLAP_AUDIO_PORT_IS_MAIN |
+                                    CLAP_AUDIO_PORT_REQUIRES_COMMON_SAMPLE_SIZE |
+                                    kSampleSizeFlags;
+
 // Conversion helper functions
 inline double NormalizedToFrequency(double norm) {
   // Logarithmic scaling for frequency
@@ -191,12 +208,48 @@ static const clap_plugin_audio_ports_t kAudioPortsExtension = {
     ClapAudioPortsGet,
 };
 
+// Audio ports config extension callbacks
+uint32_t ClapAudioPortsConfigCount(const clap_plugin_t* plugin) {
+  auto* eq = static_cast<EqClap*>(plugin->plugin_data);
+  return eq->AudioPortsConfigCount();
+}
+
+bool ClapAudioPortsConfigGet(const clap_plugin_t* plugin, uint32_t index,
+                             clap_audio_ports_config_t* config) {
+  auto* eq = static_cast<EqClap*>(plugin->plugin_data);
+  return eq->AudioPortsConfigGet(index, config);
+}
+
+bool ClapAudioPortsConfigSelect(const clap_plugin_t* plugin,
+                                clap_id config_id) {
+  auto* eq = static_cast<EqClap*>(plugin->plugin_data);
+  return eq->AudioPortsConfigSelect(config_id);
+}
+
+static const clap_plugin_audio_ports_config_t kAudioPortsConfigExtension = {
+    ClapAudioPortsConfigCount,
+    ClapAudioPortsConfigGet,
+    ClapAudioPortsConfigSelect,
+};
+
+// Tail extension callbacks
+uint32_t ClapTailGet(const clap_plugin_t* plugin) {
+  auto* eq = static_cast<EqClap*>(plugin->plugin_data);
+  return eq->TailGet();
+}
+
+static const clap_plugin_tail_t kTailExtension = {
+    ClapTailGet,
+};
+
 }  // namespace
 
 EqClap::EqClap(const clap_host_t* host)
     : host_(host),
       sample_rate_(44100.0),
-      is_processing_(false) {
+      is_processing_(false),
+      channel_layout_(stinky_dsp::kStereoLayout),
+      dirty_(kDirtyAll) {
   plugin_.desc = nullptr;  // Set by factory
   plugin_.plugin_data = this;
   plugin_.init = ClapInit;
@@ -252,8 +305,15 @@ bool EqClap::Init() noexcept {
 bool EqClap::Activate(double sample_rate, uint32_t /*min_frames*/,
                       uint32_t /*max_frames*/) noexcept {
   sample_rate_ = sample_rate;
-  processor_.Initialize(sample_rate);
+  // Sync stored parameter values first, so Initialize starts from them
+  // without a smoothing ramp
   UpdateProcessorParams();
+  processor_.Initialize(sample_rate);
+  silence_.SetTail(processor_.GetTailFrames());
+  silence_.Reset();
+  constant_.Reset();
+  process_stats_.SetSampleRate(sample_rate);
+  process_stats_.Reset();
   return true;
 }
 
@@ -272,56 +332,78 @@ void EqClap::StopProcessing() noexcept {
 
 void EqClap::Reset() noexcept {
   processor_.Reset();
+  silence_.Reset();
+  constant_.Reset();
+}
+
+template <typename T>
+clap_process_status EqClap::ProcessAudio(const clap_process_t* process,
+                                         const T* const* inputs,
+                                         T* const* outputs) noexcept {
+  // Ramping bands change the tail, so take it before every block
+  silence_.SetTail(processor_.GetTailFrames());
+
+  stinky_dsp::BlockOptions options;
+  options.layout_channels =
+      stinky_dsp::kChannelLayouts[channel_layout_].channel_count;
+  options.may_settle = !processor_.IsRamping();
+  return stinky_dsp::ProcessBlock(
+      process, inputs, outputs, options, silence_, constant_,
+      [this](const clap_event_header_t* header) {
+        return ApplyEvent(header);
+      },
+      [this] { UpdateProcessorParams(); },
+      [this](const T* const* in, T* const* out, uint32_t num_channels,
+             uint32_t /*frame*/, uint32_t frames) {
+        processor_.ProcessChannels<T>(in, out, num_channels, frames);
+      });
 }
 
 clap_process_status EqClap::Process(const clap_process_t* process) noexcept {
-  // Process parameter changes
-  if (process->in_events) {
-    ProcessParameterChanges(process->in_events);
-  }
-
+  stinky_dsp::ProcessStats::Scope stats_scope(process_stats_,
+                                              process->frames_count);
   const uint32_t frame_count = process->frames_count;
   const uint32_t input_count = process->audio_inputs_count;
   const uint32_t output_count = process->audio_outputs_count;
 
   if (input_count == 0 || output_count == 0 || frame_count == 0) {
+    if (process->in_events) {
+      ProcessParameterChanges(process->in_events);
+    }
     return CLAP_PROCESS_SLEEP;
   }
 
-  const uint32_t in_channels = process->audio_inputs[0].channel_count;
-  const uint32_t out_channels = process->audio_outputs[0].channel_count;
-  
-  float* in_left = process->audio_inputs[0].data32[0];
-  float* in_right = (in_channels > 1) ? process->audio_inputs[0].data32[1] : nullptr;
-  float* out_left = process->audio_outputs[0].data32[0];
-  float* out_right = (out_channels > 1) ? process->audio_outputs[0].data32[1] : nullptr;
-
-  // Copy input to output
-  std::memcpy(out_left, in_left, frame_count * sizeof(float));
-  if (in_right && out_right) {
-    std::memcpy(out_right, in_right, frame_count * sizeof(float));
+  // The ports take either sample size; the host picks one per block
+  const clap_audio_buffer_t& input = process->audio_inputs[0];
+  const clap_audio_buffer_t& output = process->audio_outputs[0];
+  if (input.data32 && output.data32) {
+    return ProcessAudio(process, input.data32, output.data32);
   }
-
-  // Process EQ
-  if (out_right) {
-    processor_.ProcessStereo(out_left, out_right, frame_count);
-  } else {
-    processor_.ProcessStereo(out_left, out_left, frame_count);
+  if (input.data64 && output.data64) {
+    return ProcessAudio(process, input.data64, output.data64);
   }
-
-  return CLAP_PROCESS_CONTINUE;
+  return CLAP_PROCESS_ERROR;
 }
 
 const void* EqClap::GetExtension(const char* id) noexcept {
   if (std::strcmp(id, CLAP_EXT_AUDIO_PORTS) == 0) {
     return &kAudioPortsExtension;
   }
+  if (std::strcmp(id, CLAP_EXT_AUDIO_PORTS_CONFIG) == 0) {
+    return &kAudioPortsConfigExtension;
+  }
   if (std::strcmp(id, CLAP_EXT_PARAMS) == 0) {
     return &kParamsExtension;
   }
   if (std::strcmp(id, CLAP_EXT_STATE) == 0) {
     return &kStateExtension;
   }
+  if (std::strcmp(id, CLAP_EXT_TAIL) == 0) {
+    return &kTailExtension;
+  }
+  if (std::strcmp(id, STINKY_EXT_PROCESS_STATS) == 0) {
+    return stinky_dsp::ProcessStatsExtension<EqClap>();
+  }
   return nullptr;
 }
 
@@ -538,32 +620,41 @@ bool EqClap::StateLoad(const clap_istream_t* stream) noexcept {
     param_values_[i].store(values[i]);
   }
 
+  dirty_ = kDirtyAll;
   UpdateProcessorParams();
   return true;
 }
 
-void EqClap::ProcessParameterChanges(const clap_input_events_t* events) noexcept {
+void EqClap::ProcessParameterChanges(
+    const clap_input_events_t* events) noexcept {
   const uint32_t event_count = events->size(events);
 
   for (uint32_t i = 0; i < event_count; ++i) {
-    const clap_event_header_t* header = events->get(events, i);
-
-    if (header->space_id != CLAP_CORE_EVENT_SPACE_ID) continue;
-
-    if (header->type == CLAP_EVENT_PARAM_VALUE) {
-      auto* param_event = reinterpret_cast<const clap_event_param_value_t*>(header);
-      SetParamValue(param_event->param_id, param_event->value);
-    }
+    ApplyEvent(events->get(events, i));
   }
 
   UpdateProcessorParams();
 }
 
+bool EqClap::ApplyEvent(const clap_event_header_t* header) noexcept {
+  if (header->space_id != CLAP_CORE_EVENT_SPACE_ID) return false;
+  if (header->type != CLAP_EVENT_PARAM_VALUE) return false;
+
+  auto* param_event = reinterpret_cast<const clap_event_param_value_t*>(header);
+  SetParamValue(param_event->param_id, param_event->value);
+  return true;
+}
+
 void EqClap::UpdateProcessorParams() noexcept {
-  EqParams params;
+  if (dirty_ == 0) return;
+
+  // Start from the processor's current parameters and rebuild only the
+  // bands that changed
+  EqParams params = processor_.GetParams();
   
-  // Update each band
   for (int i = 0; i < 4; ++i) {
+    if ((dirty_ & (1u << i)) == 0) continue;
+
     const int base_idx = i * 5;
     params.bands[i].type = static_cast<FilterType>(
         static_cast<int>(param_values_[base_idx + 0].load()));
@@ -573,15 +664,20 @@ void EqClap::UpdateProcessorParams() noexcept {
     params.bands[i].enabled = param_values_[base_idx + 4].load() > 0.5;
   }
   
-  params.output_gain_db = static_cast<float>(NormalizedToOutputGain(param_values_[kParamIdOutputGain].load()));
-  params.bypass = param_values_[kParamIdBypass].load() > 0.5;
+  if (dirty_ & kDirtyGlobal) {
+    params.output_gain_db = static_cast<float>(NormalizedToOutputGain(param_values_[kParamIdOutputGain].load()));
+    params.bypass = param_values_[kParamIdBypass].load() > 0.5;
+  }
   
+  dirty_ = 0;
   processor_.SetParams(params);
 }
 
 void EqClap::SetParamValue(clap_id param_id, double value) noexcept {
   if (param_id < kParamIdCount) {
     param_values_[param_id].store(value);
+    dirty_ |= param_id < kParamIdOutputGain ? 1u << (param_id / 5)
+                                            : kDirtyGlobal;
   }
 }
 
@@ -595,14 +691,31 @@ bool EqClap::AudioPortsGet(uint32_t index, bool is_input,
 
   info->id = 0;
   std::snprintf(info->name, sizeof(info->name), is_input ? "Audio Input" : "Audio Output");
-  info->channel_count = 2;
-  info->flags = CLAP_AUDIO_PORT_IS_MAIN;
-  info->port_type = CLAP_PORT_STEREO;
+  info->channel_count =
+      stinky_dsp::kChannelLayouts[channel_layout_].channel_count;
+  info->flags = kMainPortFlags;
+  info->port_type = stinky_dsp::kChannelLayouts[channel_layout_].port_type;
   info->in_place_pair = is_input ? 0 : 0;
 
   return true;
 }
 
+uint32_t EqClap::AudioPortsConfigCount() const noexcept {
+  return stinky_dsp::kChannelLayoutCount;
+}
+
+bool EqClap::AudioPortsConfigGet(
+    uint32_t index, clap_audio_ports_config_t* config) const noexcept {
+  return stinky_dsp::GetChannelLayoutConfig(index, AudioPortsCount(true),
+                                            config);
+}
+
+bool EqClap::AudioPortsConfigSelect(clap_id config_id) noexcept {
+  if (config_id >= stinky_dsp::kChannelLayoutCount) return false;
+  channel_layout_ = config_id;
+  return true;
+}
+
 }  // namespace fast_eq
 
 // CLAP plugin factory
@@ -661,7 +774,10 @@ static const void* ClapGetFactory(const char* factory_id) {
 
 CLAP_EXPORT const clap_plugin_entry_t clap_entry = {
     CLAP_VERSION,
-    [](const char* /*plugin_path*/) { return true; },
+    [](const char* /*plugin_path*/) {
+      stinky_dsp::simd::Initialize();
+      return true;
+    },
     []() {},
     ClapGetFactory,
 };
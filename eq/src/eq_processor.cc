@@ -5,36 +5,54 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <numbers>
 
+#include "simd_utils.h"
+
 namespace fast_eq {
 
+namespace simd = stinky_dsp::simd;
+
 namespace {
 
-constexpr float kEpsilon = 1e-8f;
 constexpr float kPi = std::numbers::pi_v<float>;
 
-inline float DbToLinear(float db) {
-  return std::pow(10.0f, db / 20.0f);
+// Parameter ramp length; long enough to remove zipper noise on sweeps
+constexpr double kSmoothingMs = 20.0;
+
+// The tail ends once the filters' ringing is 120 dB down
+constexpr double kTailAttenuation = 1e-6;
+
+// Float TDF-II error grows as the poles approach z = 1: low normalized
+// frequency and high Q. Above 200 Hz at 48 kHz (raised with Q) float stays
+// within about 1e-4 of the double reference.
+constexpr double kMinFloatNormalizedFrequency = 200.0 / 48000.0;
+
+stinky_dsp::BiquadPrecision ChoosePrecision(double frequency, double q,
+                                            double sample_rate) {
+  const double threshold =
+      kMinFloatNormalizedFrequency * std::max(1.0, q / 2.0);
+  return frequency / sample_rate >= threshold
+             ? stinky_dsp::BiquadPrecision::kFloat
+             : stinky_dsp::BiquadPrecision::kDouble;
 }
 
 }  // namespace
 
 // BiquadFilter implementation
 BiquadFilter::BiquadFilter()
-    : b0_(1.0), b1_(0.0), b2_(0.0),
-      a1_(0.0), a2_(0.0),
-      x1_(0.0), x2_(0.0),
+    : x1_(0.0), x2_(0.0),
       y1_(0.0), y2_(0.0) {}
 
 void BiquadFilter::SetCoefficients(double b0, double b1, double b2,
                                    double a0, double a1, double a2) {
   // Normalize coefficients by a0
-  b0_ = b0 / a0;
-  b1_ = b1 / a0;
-  b2_ = b2 / a0;
-  a1_ = a1 / a0;
-  a2_ = a2 / a0;
+  coefficients_.b0 = b0 / a0;
+  coefficients_.b1 = b1 / a0;
+  coefficients_.b2 = b2 / a0;
+  coefficients_.a1 = a1 / a0;
+  coefficients_.a2 = a2 / a0;
 }
 
 void BiquadFilter::SetHighCut(double frequency, double q, double sample_rate) {
@@ -125,8 +143,9 @@ void BiquadFilter::SetBell(double frequency, double gain_db, double q,
 }
 
 float BiquadFilter::Process(float input) {
-  const double output = b0_ * input + b1_ * x1_ + b2_ * x2_
-                        - a1_ * y1_ - a2_ * y2_;
+  const auto& c = coefficients_;
+  const double output = c.b0 * input + c.b1 * x1_ + c.b2 * x2_
+                        - c.a1 * y1_ - c.a2 * y2_;
   
   // Update delay lines
   x2_ = x1_;
@@ -170,6 +189,25 @@ EqProcessor::EqProcessor()
 void EqProcessor::Initialize(double sample_rate) {
   sample_rate_ = sample_rate;
   Reset();
+
+  // Start from the current parameters without a ramp
+  for (BandRamp& ramp : ramps_) {
+    ramp.log2_frequency.Configure(stinky_dsp::SmoothingType::kOnePole,
+                                  sample_rate, kSmoothingMs);
+    ramp.gain_db.Configure(stinky_dsp::SmoothingType::kOnePole, sample_rate,
+                           kSmoothingMs);
+    ramp.q.Configure(stinky_dsp::SmoothingType::kOnePole, sample_rate,
+                     kSmoothingMs);
+  }
+  output_gain_.Configure(stinky_dsp::SmoothingType::kLinear, sample_rate,
+                         kSmoothingMs);
+  for (size_t i = 0; i < 4; ++i) {
+    const BandParams& band = params_.bands[i];
+    ramps_[i].log2_frequency.Reset(std::log2(band.frequency_hz));
+    ramps_[i].gain_db.Reset(band.gain_db);
+    ramps_[i].q.Reset(band.q);
+  }
+  output_gain_.Reset(simd::DbToLinear(params_.output_gain_db));
   
   // Update all filter coefficients
   for (size_t i = 0; i < 4; ++i) {
@@ -178,108 +216,178 @@ void EqProcessor::Initialize(double sample_rate) {
 }
 
 void EqProcessor::SetParams(const EqParams& params) {
+  std::array<bool, 4> band_changed;
+  for (size_t i = 0; i < 4; ++i) {
+    band_changed[i] = params.bands[i] != params_.bands[i];
+  }
   params_ = params;
-  
-  // Update filter coefficients for all bands
+
+  // Frequency ramps in octaves, so sweeps move evenly across the spectrum
   for (size_t i = 0; i < 4; ++i) {
+    if (!band_changed[i]) continue;
+
+    const BandParams& band = params_.bands[i];
+    ramps_[i].log2_frequency.SetTarget(std::log2(band.frequency_hz));
+    ramps_[i].gain_db.SetTarget(band.gain_db);
+    ramps_[i].q.SetTarget(band.q);
     UpdateBandCoefficients(i);
   }
+  output_gain_.SetTarget(simd::DbToLinear(params_.output_gain_db));
+}
+
+bool EqProcessor::IsRamping() const {
+  return output_gain_.IsSmoothing() ||
+         std::any_of(ramps_.begin(), ramps_.end(),
+                     [](const BandRamp& ramp) { return ramp.IsSmoothing(); });
+}
+
+void EqProcessor::AdvanceRamps(size_t num_frames) {
+  for (size_t i = 0; i < 4; ++i) {
+    BandRamp& ramp = ramps_[i];
+    if (!ramp.IsSmoothing()) continue;
+
+    ramp.log2_frequency.Advance(num_frames);
+    ramp.gain_db.Advance(num_frames);
+    ramp.q.Advance(num_frames);
+    UpdateBandCoefficients(i);
+  }
+  output_gain_.Advance(num_frames);
 }
 
 void EqProcessor::UpdateBandCoefficients(size_t band_index) {
   const auto& band = params_.bands[band_index];
+  auto& filter = filters_[band_index];
+
+  // Design from the ramped values
+  const BandRamp& ramp = ramps_[band_index];
+  const double frequency = std::exp2(ramp.log2_frequency.Current());
+  const double gain_db = ramp.gain_db.Current();
+  const double q = ramp.q.Current();
   
   switch (band.type) {
     case FilterType::kHighCut:
-      filters_left_[band_index].SetHighCut(band.frequency_hz, band.q, sample_rate_);
-      filters_right_[band_index].SetHighCut(band.frequency_hz, band.q, sample_rate_);
+      filter.SetHighCut(frequency, q, sample_rate_);
       break;
       
     case FilterType::kLowCut:
-      filters_left_[band_index].SetLowCut(band.frequency_hz, band.q, sample_rate_);
-      filters_right_[band_index].SetLowCut(band.frequency_hz, band.q, sample_rate_);
+      filter.SetLowCut(frequency, q, sample_rate_);
       break;
       
     case FilterType::kLowShelf:
-      filters_left_[band_index].SetLowShelf(band.frequency_hz, band.gain_db, 
-                                            band.q, sample_rate_);
-      filters_right_[band_index].SetLowShelf(band.frequency_hz, band.gain_db,
-                                             band.q, sample_rate_);
+      filter.SetLowShelf(frequency, gain_db, q, sample_rate_);
       break;
       
     case FilterType::kHighShelf:
-      filters_left_[band_index].SetHighShelf(band.frequency_hz, band.gain_db,
-                                             band.q, sample_rate_);
-      filters_right_[band_index].SetHighShelf(band.frequency_hz, band.gain_db,
-                                              band.q, sample_rate_);
+      filter.SetHighShelf(frequency, gain_db, q, sample_rate_);
       break;
       
     case FilterType::kBell:
-      filters_left_[band_index].SetBell(band.frequency_hz, band.gain_db,
-                                        band.q, sample_rate_);
-      filters_right_[band_index].SetBell(band.frequency_hz, band.gain_db,
-                                         band.q, sample_rate_);
+      filter.SetBell(frequency, gain_db, q, sample_rate_);
       break;
   }
+
+  const stinky_dsp::BiquadPrecision precision =
+      ChoosePrecision(frequency, q, sample_rate_);
+  for (stinky_dsp::BiquadCascade& cascade : cascades_) {
+    cascade.SetStage(band_index, filter.Coefficients(), precision);
+    cascade.SetStageEnabled(band_index, band.enabled);
+  }
 }
 
 void EqProcessor::Reset() {
-  for (auto& filter : filters_left_) {
-    filter.Reset();
+  for (stinky_dsp::BiquadCascade& cascade : cascades_) {
+    cascade.Reset();
   }
-  for (auto& filter : filters_right_) {
-    filter.Reset();
+}
+
+uint32_t EqProcessor::GetTailFrames() const {
+  if (params_.bypass) return 0;
+
+  uint32_t tail = 0;
+  for (size_t i = 0; i < 4; ++i) {
+    if (!params_.bands[i].enabled) continue;
+    tail = std::max(tail, stinky_dsp::BiquadDecayFrames(
+                              filters_[i].Coefficients(), kTailAttenuation));
   }
+  return tail;
 }
 
 void EqProcessor::Process(float* buffer, size_t num_frames) {
   if (params_.bypass) {
     return;
   }
-  
-  const float output_gain = DbToLinear(params_.output_gain_db);
-  
-  for (size_t i = 0; i < num_frames * 2; i += 2) {
-    float left = buffer[i];
-    float right = buffer[i + 1];
-    
-    // Process each enabled band
-    for (size_t band = 0; band < 4; ++band) {
-      if (params_.bands[band].enabled) {
-        left = filters_left_[band].Process(left);
-        right = filters_right_[band].Process(right);
-      }
-    }
-    
-    // Apply output gain
-    buffer[i] = left * output_gain;
-    buffer[i + 1] = right * output_gain;
+
+  size_t offset = 0;
+  for (; offset < num_frames && IsRamping(); offset += kRampBlockSize) {
+    const size_t frames = std::min(kRampBlockSize, num_frames - offset);
+    AdvanceRamps(frames);
+    cascades_[0].ProcessInterleaved(buffer + 2 * offset, frames,
+                                    output_gain_.Current());
+  }
+  if (offset < num_frames) {
+    cascades_[0].ProcessInterleaved(buffer + 2 * offset, num_frames - offset,
+                                    output_gain_.Current());
   }
 }
 
 void EqProcessor::ProcessStereo(float* left, float* right, size_t num_frames) {
+  ProcessStereo(left, right, left, right, num_frames);
+}
+
+template <typename T>
+void EqProcessor::ProcessStereo(const T* in_left, const T* in_right,
+                                T* out_left, T* out_right, size_t num_frames) {
+  const T* inputs[] = {in_left, in_right};
+  T* outputs[] = {out_left, out_right};
+  ProcessChannels(inputs, outputs, out_left == out_right ? 1 : 2,
+                  num_frames);
+}
+
+template <typename T>
+void EqProcessor::ProcessChannels(const T* const* inputs, T* const* outputs,
+                                  uint32_t num_channels, size_t num_frames) {
   if (params_.bypass) {
-    return;
-  }
-  
-  const float output_gain = DbToLinear(params_.output_gain_db);
-  
-  for (size_t i = 0; i < num_frames; ++i) {
-    float l = left[i];
-    float r = right[i];
-    
-    // Process each enabled band
-    for (size_t band = 0; band < 4; ++band) {
-      if (params_.bands[band].enabled) {
-        l = filters_left_[band].Process(l);
-        r = filters_right_[band].Process(r);
+    for (uint32_t channel = 0; channel < num_channels; ++channel) {
+      if (outputs[channel] != inputs[channel]) {
+        std::memcpy(outputs[channel], inputs[channel],
+                    num_frames * sizeof(T));
       }
     }
-    
-    // Apply output gain
-    left[i] = l * output_gain;
-    right[i] = r * output_gain;
+    return;
+  }
+
+  size_t offset = 0;
+  for (; offset < num_frames && IsRamping(); offset += kRampBlockSize) {
+    const size_t frames = std::min(kRampBlockSize, num_frames - offset);
+    AdvanceRamps(frames);
+    RunCascades(inputs, outputs, num_channels, offset, frames);
+  }
+  if (offset < num_frames) {
+    RunCascades(inputs, outputs, num_channels, offset, num_frames - offset);
+  }
+}
+
+template <typename T>
+void EqProcessor::RunCascades(const T* const* inputs, T* const* outputs,
+                              uint32_t num_channels, size_t offset,
+                              size_t num_frames) {
+  for (uint32_t left = 0; left < num_channels; left += 2) {
+    // An odd last channel aliases both lanes, like mono
+    const uint32_t right = left + 1 < num_channels ? left + 1 : left;
+    cascades_[left / 2].Process(inputs[left] + offset, inputs[right] + offset,
+                                outputs[left] + offset,
+                                outputs[right] + offset, num_frames,
+                                output_gain_.Current());
   }
 }
 
+template void EqProcessor::ProcessStereo(const float*, const float*, float*,
+                                         float*, size_t);
+template void EqProcessor::ProcessStereo(const double*, const double*,
+                                         double*, double*, size_t);
+template void EqProcessor::ProcessChannels(const float* const*, float* const*,
+                                           uint32_t, size_t);
+template void EqProcessor::ProcessChannels(const double* const*,
+                                           double* const*, uint32_t, size_t);
+
 }  // namespace fast_eq
@@ -6,7 +6,9 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
 #include <vector>
 #include <numbers>
 
@@ -66,6 +68,7 @@ TEST_F(EqProcessorTest, DisabledBandsDoNotAffectSignal) {
     band.enabled = false;
   }
   processor_.SetParams(params);
+  processor_.Initialize(kSampleRate);  // Start without a smoothing ramp
 
   std::vector<float> left(512, 0.5f);
   std::vector<float> right(512, 0.5f);
@@ -87,6 +90,7 @@ TEST_F(EqProcessorTest, OutputGainAffectsLevel) {
     band.enabled = false;
   }
   processor_.SetParams(params);
+  processor_.Initialize(kSampleRate);  // Start without a smoothing ramp
 
   std::vector<float> left(512, 0.5f);
   std::vector<float> right(512, 0.5f);
@@ -264,5 +268,239 @@ TEST_F(EqProcessorTest, ResetClearsFilterState) {
   }
 }
 
+TEST_F(EqProcessorTest, CascadeMatchesPerBandReference) {
+  EqParams params = processor_.GetParams();
+  params.bands[0] = {FilterType::kLowCut, 40.0f, 0.0f, 0.707f, true};
+  params.bands[1] = {FilterType::kBell, 400.0f, -6.0f, 2.0f, true};
+  params.bands[2] = {FilterType::kBell, 3000.0f, 4.0f, 1.0f, false};
+  params.bands[3] = {FilterType::kHighShelf, 9000.0f, 3.0f, 0.707f, true};
+  params.output_gain_db = -3.0f;
+  processor_.SetParams(params);
+  processor_.Initialize(kSampleRate);  // Start without a smoothing ramp
+
+  // Scalar reference: one BiquadFilter per enabled band and channel
+  std::array<BiquadFilter, 4> reference_left;
+  std::array<BiquadFilter, 4> reference_right;
+  for (auto* filters : {&reference_left, &reference_right}) {
+    (*filters)[0].SetLowCut(40.0, 0.707, kSampleRate);
+    (*filters)[1].SetBell(400.0, -6.0, 2.0, kSampleRate);
+    (*filters)[3].SetHighShelf(9000.0, 3.0, 0.707, kSampleRate);
+  }
+  const float output_gain = std::pow(10.0f, -3.0f / 20.0f);
+
+  constexpr size_t kFrames = 1024;
+  std::vector<float> left(kFrames);
+  std::vector<float> right(kFrames);
+  std::vector<float> interleaved(kFrames * 2);
+  for (size_t i = 0; i < kFrames; ++i) {
+    left[i] = 0.5f * std::sin(0.031f * static_cast<float>(i));
+    right[i] = 0.4f * std::sin(0.17f * static_cast<float>(i));
+    interleaved[2 * i] = left[i];
+    interleaved[2 * i + 1] = right[i];
+  }
+  std::vector<float> expected_left = left;
+  std::vector<float> expected_right = right;
+  for (size_t i = 0; i < kFrames; ++i) {
+    for (size_t band : {0, 1, 3}) {
+      expected_left[i] = reference_left[band].Process(expected_left[i]);
+      expected_right[i] = reference_right[band].Process(expected_right[i]);
+    }
+    expected_left[i] *= output_gain;
+    expected_right[i] *= output_gain;
+  }
+
+  processor_.ProcessStereo(left.data(), right.data(), kFrames);
+  processor_.Reset();
+  processor_.Process(interleaved.data(), kFrames);
+
+  for (size_t i = 0; i < kFrames; ++i) {
+    EXPECT_NEAR(left[i], expected_left[i], kEpsilon);
+    EXPECT_NEAR(right[i], expected_right[i], kEpsilon);
+    EXPECT_NEAR(interleaved[2 * i], expected_left[i], kEpsilon);
+    EXPECT_NEAR(interleaved[2 * i + 1], expected_right[i], kEpsilon);
+  }
+}
+
+// Worst-case error of the automatically chosen stage precision against the
+// double BiquadFilter reference, one band at a time on full-scale noise
+TEST_F(EqProcessorTest, ChosenPrecisionMatchesDoubleReference) {
+  struct Case {
+    FilterType type;
+    float frequency_hz;
+    float gain_db;
+    float q;
+    double sample_rate;
+    float tolerance;
+  };
+  // Low shelves at 20 Hz must keep double accuracy; the rest may run in float
+  const Case cases[] = {
+      {FilterType::kLowShelf, 20.0f, 12.0f, 0.707f, 48000.0, 1e-5f},
+      {FilterType::kLowShelf, 20.0f, 12.0f, 4.0f, 192000.0, 1e-5f},
+      {FilterType::kLowCut, 30.0f, 0.0f, 10.0f, 96000.0, 1e-5f},
+      {FilterType::kBell, 120.0f, 12.0f, 8.0f, 44100.0, 1e-5f},
+      {FilterType::kBell, 250.0f, 12.0f, 1.0f, 48000.0, 1e-4f},
+      {FilterType::kBell, 1000.0f, -12.0f, 10.0f, 44100.0, 1e-4f},
+      {FilterType::kHighShelf, 8000.0f, 12.0f, 0.707f, 96000.0, 1e-4f},
+      {FilterType::kHighCut, 15000.0f, 0.0f, 2.0f, 44100.0, 1e-4f},
+  };
+
+  constexpr size_t kFrames = 8192;
+  std::vector<float> noise(kFrames);
+  uint32_t seed = 1;
+  for (float& sample : noise) {
+    seed = seed * 1664525u + 1013904223u;
+    sample = static_cast<float>(seed >> 8) / 8388608.0f - 1.0f;
+  }
+
+  for (const Case& c : cases) {
+    EqProcessor processor;
+    EqParams params = processor.GetParams();
+    for (auto& band : params.bands) {
+      band.enabled = false;
+    }
+    params.bands[0] = {c.type, c.frequency_hz, c.gain_db, c.q, true};
+    params.output_gain_db = 0.0f;
+    processor.SetParams(params);
+    processor.Initialize(c.sample_rate);
+
+    BiquadFilter reference;
+    switch (c.type) {
+      case FilterType::kLowShelf:
+        reference.SetLowShelf(c.frequency_hz, c.gain_db, c.q, c.sample_rate);
+        break;
+      case FilterType::kHighShelf:
+        reference.SetHighShelf(c.frequency_hz, c.gain_db, c.q, c.sample_rate);
+        break;
+      case FilterType::kBell:
+        reference.SetBell(c.frequency_hz, c.gain_db, c.q, c.sample_rate);
+        break;
+      case FilterType::kLowCut:
+        reference.SetLowCut(c.frequency_hz, c.q, c.sample_rate);
+        break;
+      case FilterType::kHighCut:
+        reference.SetHighCut(c.frequency_hz, c.q, c.sample_rate);
+        break;
+    }
+
+    std::vector<float> left = noise;
+    std::vector<float> right = noise;
+    processor.ProcessStereo(left.data(), right.data(), kFrames);
+
+    float max_error = 0.0f;
+    for (size_t i = 0; i < kFrames; ++i) {
+      const float expected = reference.Process(noise[i]);
+      max_error = std::max(max_error, std::abs(left[i] - expected));
+      max_error = std::max(max_error, std::abs(right[i] - expected));
+    }
+    EXPECT_LT(max_error, c.tolerance)
+        << "frequency " << c.frequency_hz << " Hz, Q " << c.q << ", "
+        << c.sample_rate << " Hz";
+  }
+}
+
+TEST_F(EqProcessorTest, OutputGainChangeRampsAtBlockRate) {
+  EqParams params = processor_.GetParams();
+  for (auto& band : params.bands) {
+    band.enabled = false;
+  }
+  processor_.SetParams(params);
+  processor_.Initialize(kSampleRate);
+
+  // Ramp the output gain down by 12 dB on a DC signal
+  std::vector<float> left(2048, 0.5f);
+  std::vector<float> right(2048, 0.5f);
+  params.output_gain_db = -12.0f;
+  processor_.SetParams(params);
+  processor_.ProcessStereo(left.data(), right.data(), left.size());
+
+  // Small steps all the way down, then the target (20 ms = 882 samples)
+  EXPECT_LT(left[0], 0.5f);
+  EXPECT_GT(left[0], 0.45f);
+  for (size_t i = 1; i < left.size(); ++i) {
+    EXPECT_LE(left[i], left[i - 1]);
+    EXPECT_LT(left[i - 1] - left[i], 0.05f);
+  }
+  const float settled = 0.5f * std::pow(10.0f, -12.0f / 20.0f);
+  EXPECT_NEAR(left.back(), settled, 1e-6f);
+  EXPECT_NEAR(right.back(), settled, 1e-6f);
+}
+
+TEST_F(EqProcessorTest, BandSweepSettlesOnTargetFilter) {
+  EqParams params = processor_.GetParams();
+  params.bands[1] = {FilterType::kBell, 300.0f, 0.0f, 1.0f, true};
+  processor_.SetParams(params);
+  processor_.Initialize(kSampleRate);
+
+  constexpr size_t kFrames = 4096;
+  std::vector<float> left(kFrames);
+  std::vector<float> right(kFrames);
+  const float omega =
+      2.0f * std::numbers::pi_v<float> * 2000.0f / static_cast<float>(kSampleRate);
+  for (size_t i = 0; i < kFrames; ++i) {
+    left[i] = 0.25f * std::sin(omega * static_cast<float>(i));
+    right[i] = left[i];
+  }
+  std::vector<float> expected_left = left;
+  std::vector<float> expected_right = right;
+
+  // Sweep frequency, gain and Q at once
+  params.bands[1] = {FilterType::kBell, 2000.0f, 9.0f, 2.0f, true};
+  processor_.SetParams(params);
+  processor_.ProcessStereo(left.data(), right.data(), kFrames);
+
+  EqProcessor reference;
+  reference.SetParams(params);
+  reference.Initialize(kSampleRate);
+  reference.ProcessStereo(expected_left.data(), expected_right.data(),
+                          kFrames);
+
+  // Once the ramp and the filter transient are over, both match
+  for (size_t i = kFrames / 2; i < kFrames; ++i) {
+    EXPECT_NEAR(left[i], expected_left[i], 1e-4f);
+    EXPECT_NEAR(right[i], expected_right[i], 1e-4f);
+  }
+}
+
+TEST_F(EqProcessorTest, ChannelsRunAsStereoPairs) {
+  EqParams params = processor_.GetParams();
+  params.bands[0] = {FilterType::kLowCut, 80.0f, 0.0f, 0.707f, true};
+  params.bands[1] = {FilterType::kBell, 1000.0f, 6.0f, 1.0f, true};
+  processor_.SetParams(params);
+  processor_.Initialize(kSampleRate);
+
+  // Channels 0-1 and 2-3 pair up; the odd channel 4 runs as mono
+  std::array<EqProcessor, 3> pairs;
+  for (EqProcessor& pair : pairs) {
+    pair.SetParams(params);
+    pair.Initialize(kSampleRate);
+  }
+
+  constexpr uint32_t kChannels = 5;
+  constexpr size_t kFrames = 1024;
+  std::vector<std::vector<float>> channels(kChannels,
+                                           std::vector<float>(kFrames));
+  std::vector<std::vector<float>> expected(kChannels,
+                                           std::vector<float>(kFrames));
+  float* pointers[kChannels];
+  for (uint32_t c = 0; c < kChannels; ++c) {
+    for (size_t i = 0; i < kFrames; ++i) {
+      channels[c][i] = 0.5f * std::sin(0.02f * static_cast<float>(c + 1) *
+                                       static_cast<float>(i));
+      expected[c][i] = channels[c][i];
+    }
+    pointers[c] = channels[c].data();
+  }
+
+  processor_.ProcessChannels<float>(pointers, pointers, kChannels, kFrames);
+  pairs[0].ProcessStereo(expected[0].data(), expected[1].data(), kFrames);
+  pairs[1].ProcessStereo(expected[2].data(), expected[3].data(), kFrames);
+  pairs[2].ProcessStereo(expected[4].data(), expected[4].data(),
+                         expected[4].data(), expected[4].data(), kFrames);
+
+  for (uint32_t c = 0; c < kChannels; ++c) {
+    EXPECT_EQ(channels[c], expected[c]) << "channel " << c;
+  }
+}
+
 }  // namespace
 }  // namespace fast_eq
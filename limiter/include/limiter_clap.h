@@ -10,6 +10,10 @@
 #include <memory>
 
 #include "limiter_processor.h"
+#include "channel_layouts.h"
+#include "constant_detector.h"
+#include "process_stats.h"
+#include "silence_detector.h"
 
 namespace fast_limiter {
 
@@ -27,11 +31,15 @@ constexpr double kThresholdMin = -60.0;
 constexpr double kThresholdMax = 0.0;
 constexpr double kOutputLevelMin = -60.0;
 constexpr double kOutputLevelMax = 0.0;
+constexpr double kLookaheadMin = 0.0;
+constexpr double kLookaheadMax = 10.0;
 
 // CLAP parameter IDs
 enum LimiterParamId {
   kParamIdThreshold = 0,    // @ts-param min=-60.0 max=0.0 default=-0.1 unit=dB label="Threshold"
   kParamIdOutputLevel,        // @ts-param min=-60.0 max=0.0 default=-0.1 unit=dB label="Output Level"
+  kParamIdLookahead,          // @ts-param min=0.0 max=10.0 default=5.0 unit=ms label="Lookahead"
+  kParamIdTruePeak,           // @ts-param default=0 label="True Peak" type=bool
   kParamIdCount
 };
 
@@ -40,7 +48,7 @@ class LimiterClap {
   explicit LimiterClap(const clap_host_t* host);
   ~LimiterClap() = default;
 
-  // CLAP plugin interface
+  // CLAP plugin interface. Activate is the only call that allocates.
   bool Init() noexcept;
   bool Activate(double sample_rate, uint32_t min_frames,
                 uint32_t max_frames) noexcept;
@@ -71,29 +79,71 @@ class LimiterClap {
   bool StateSave(const clap_ostream_t* stream) noexcept;
   bool StateLoad(const clap_istream_t* stream) noexcept;
 
+  // Latency extension: the lookahead delay, fixed while activated
+  uint32_t LatencyGet() const noexcept { return latency_; }
+
   // Audio ports extension
   uint32_t AudioPortsCount(bool is_input) const noexcept;
   bool AudioPortsGet(uint32_t index, bool is_input,
                      clap_audio_port_info_t* info) const noexcept;
 
+  // Audio ports config extension: the layouts in stinky_dsp::kChannelLayouts.
+  // The host selects one while the plugin is deactivated.
+  uint32_t AudioPortsConfigCount() const noexcept;
+  bool AudioPortsConfigGet(uint32_t index,
+                           clap_audio_ports_config_t* config) const noexcept;
+  bool AudioPortsConfigSelect(clap_id config_id) noexcept;
+
   const clap_plugin_t* ClapPlugin() noexcept { return &plugin_; }
 
+  // Tail extension: frames of output after the input goes silent
+  uint32_t TailGet() const noexcept { return silence_.Tail(); }
+
+  // Per-block cost instrumentation (STINKY_EXT_PROCESS_STATS)
+  stinky_dsp::ProcessStats& GetProcessStats() noexcept {
+    return process_stats_;
+  }
+
   // Get current gain reduction for metering
   float GetGainReduction() const noexcept { return processor_.GetGainReduction(); }
 
  private:
   void ProcessParameterChanges(const clap_input_events_t* events) noexcept;
+  // Applies one event; returns true if it changed a parameter
+  bool ApplyEvent(const clap_event_header_t* header) noexcept;
+  // Process() for 32- or 64-bit buffers
+  template <typename T>
+  clap_process_status ProcessAudio(const clap_process_t* process,
+                                   const T* const* inputs,
+                                   T* const* outputs) noexcept;
+
   void UpdateProcessorParams() noexcept;
   double ParamIdToValue(clap_id param_id) const noexcept;
   void SetParamValue(clap_id param_id, double value) noexcept;
 
   clap_plugin_t plugin_;
   const clap_host_t* host_;
+  const clap_host_latency_t* host_latency_;
   LimiterProcessor processor_;
   
+  // Shared with the audio thread, which must never wait on a lock
+  static_assert(std::atomic<double>::is_always_lock_free);
   std::atomic<double> param_values_[kParamIdCount];
   double sample_rate_;
+  bool is_active_;
   bool is_processing_;
+  uint32_t channel_layout_;  // Index into stinky_dsp::kChannelLayouts
+
+  // Lookahead and detector mode the processor runs with. They set the
+  // reported latency, so a change while activated waits for the restart it
+  // requests.
+  float active_lookahead_ms_;
+  bool active_true_peak_;
+  std::atomic<bool> restart_requested_;
+  uint32_t latency_;
+  stinky_dsp::ProcessStats process_stats_;
+  stinky_dsp::SilenceDetector silence_;
+  stinky_dsp::ConstantDetector constant_;
 };
 
 }  // namespace fast_limiter
@@ -6,6 +6,13 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <vector>
+
+#include "channels.h"
+#include "ring_buffer.h"
+#include "sliding_window.h"
+#include "smoother.h"
+#include "true_peak.h"
 
 namespace fast_limiter {
 
@@ -13,19 +20,26 @@ namespace fast_limiter {
 struct LimiterParams {
   float threshold_db = -0.1f;     // Ceiling/threshold in dB
   float output_level_db = -0.1f;  // Target output level in dB
+  float lookahead_ms = 5.0f;       // Detector lead, up to kMaxLookaheadMs
+  bool true_peak = false;          // Limit 4x oversampled (dBTP) peaks
 };
 
 // Fast audio limiter with lookahead and SIMD optimization
-// A limiter is essentially a compressor with infinite ratio and very fast attack
+// A limiter is essentially a compressor with infinite ratio and very fast
+// attack. The detector takes the peak over every sample still in the
+// lookahead line, and the gain ramps down linearly across the lookahead, so
+// it reaches each peak's gain by the time that peak leaves the line.
 class LimiterProcessor {
  public:
   LimiterProcessor();
-  ~LimiterProcessor();
 
-  // Initialize with sample rate
-  void Initialize(double sample_rate);
+  // [main thread] Initialize with sample rate, allocating lookahead lines
+  // for `num_channels` (1 to stinky_dsp::kMaxChannels) that hold
+  // kMaxLookaheadMs at this rate. The only call here that allocates.
+  void Initialize(double sample_rate, uint32_t num_channels = 2);
 
-  // Set limiter parameters
+  // [audio thread] Set limiter parameters. A lookahead or mode change
+  // clears only the samples the new delay can read.
   void SetParams(const LimiterParams& params);
   
   // Get current parameters
@@ -37,40 +51,95 @@ class LimiterProcessor {
   // Process audio buffer (stereo separate channels)
   void ProcessStereo(float* left, float* right, size_t num_frames);
 
+  // Process from input to output buffers of float or double samples. The
+  // output may be the input buffer itself. The detector runs in float;
+  // double samples keep their precision through the lookahead and gain.
+  template <typename T>
+  void ProcessStereo(const T* in_left, const T* in_right, T* out_left,
+                     T* out_right, size_t num_frames);
+
+  // Process `num_channels` channels, at most the count given to Initialize,
+  // from input to output buffers. One detector linked across the channels
+  // sets the gain of every channel. ProcessStereo with the same buffer on
+  // both sides is mono.
+  template <typename T>
+  void ProcessChannels(const T* const* inputs, T* const* outputs,
+                       uint32_t num_channels, size_t num_frames);
+
   // Get current gain reduction in dB
   float GetGainReduction() const { return gain_reduction_db_; }
 
-  // Reset internal state
+  // Delay the lookahead (and true-peak detector) adds to the signal, in
+  // samples
+  size_t GetLatencySamples() const { return delay_buffer_size_; }
+
+  // Frames after the input goes silent until the lookahead has flushed and
+  // the gain has recovered (peak hold and ramp, then one release time)
+  uint32_t GetTailFrames() const;
+
+  // True while a parameter change is still ramping in
+  bool IsRamping() const {
+    return threshold_db_.IsSmoothing() || output_gain_.IsSmoothing();
+  }
+
+  // [audio thread] Reset internal state
   void Reset();
 
- private:
-  // Calculate required gain reduction for a given input level
-  float CalculateGainReduction(float input_level_db) const;
+  // Detector stages run over chunks of at most this many frames
+  static constexpr size_t kMaxBlockSize = 256;
 
-  // Apply envelope follower with attack/release
-  float ApplyEnvelope(float target_gain, float current_gain);
-  
-  // Update delay buffer and get delayed sample
-  void UpdateDelayBuffer(float left_sample, float right_sample);
-  void GetDelayedSample(float& left_out, float& right_out);
+  // While the threshold ramps, chunks shrink to this size
+  static constexpr size_t kRampBlockSize = 32;
+
+  // Longest lookahead the lines are allocated for
+  static constexpr float kMaxLookaheadMs = 10.0f;
+
+ private:
+  // Process one chunk of at most kMaxBlockSize frames. The detector (peak,
+  // dB conversion, gain curve) runs as whole-chunk SIMD passes; the peak
+  // hold, envelope and lookahead delay are evaluated per sample.
+  template <typename T>
+  void ProcessBlock(const T* const* inputs, T* const* outputs,
+                    uint32_t num_channels, size_t num_frames,
+                    float threshold_db);
+
+  // Next gain for the target gain of the held peak: instant attack and
+  // release, then the lookahead ramp
+  float NextGain(float target_gain);
 
   LimiterParams params_;
   double sample_rate_;
-  float envelope_gain_;
+  float envelope_gain_;  // Released gain, before the ramp
+  float gain_;           // Ramped gain applied to the delayed samples
   float gain_reduction_db_;
-  float attack_coeff_;
   float release_coeff_;
+
+  // Oversampled detector for true-peak mode. Its level trails the input,
+  // so the delay line is longer than the lookahead by the same amount.
+  stinky_dsp::TruePeakDetector true_peak_;
+
+  // Peak over the lookahead window and the gain ramp across it, both one
+  // sample longer than the lookahead
+  stinky_dsp::SlidingMax peak_hold_;
+  stinky_dsp::MovingAverage gain_ramp_;
+
+  // Threshold ramps at block rate, output gain per sample
+  stinky_dsp::Smoother threshold_db_;
+  stinky_dsp::Smoother output_gain_;  // Linear, maps threshold to output level
   
-  // Lookahead delay buffer
-  float* delay_buffer_left_;
-  float* delay_buffer_right_;
+  // Lookahead delay lines, one per channel, double so either sample type
+  // passes unchanged. At least two channels, for Process.
+  std::vector<stinky_dsp::RingBuffer<double>> delay_lines_;
+  size_t max_lookahead_;  // Samples at the current rate
   size_t delay_buffer_size_;
-  size_t delay_write_pos_;
-  size_t delay_read_pos_;
   
   // Auto makeup gain state
   float avg_reduction_db_;
   float alpha_avg_;
+
+  // Per-chunk detector scratch (level in dB, target gain, then the gain
+  // applied to every channel)
+  alignas(32) float detector_[kMaxBlockSize];
 };
 
 }  // namespace fast_limiter
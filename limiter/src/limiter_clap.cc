@@ -8,6 +8,10 @@
 #include <cstdio>
 #include <cstring>
 
+#include "process_block.h"
+#include "process_stats_extension.h"
+#include "simd_utils.h"
+
 namespace fast_limiter {
 
 namespace {
@@ -27,6 +31,19 @@ constexpr const char* kFeatures[] = {
     nullptr
 };
 
+// Every port takes 64-bit buffers; PREFER_64BIT_AUDIO builds also ask for them
+constexpr uint32_t kSampleSizeFlags =
+#ifdef STINKY_PREFER_64BIT_AUDIO
+    CLAP_AUDIO_PORT_SUPPORTS_64BITS | CLAP_AUDIO_PORT_PREFERS_64BITS;
+#else
+    CLAP_AUDIO_PORT_SUPPORTS_64BITS;
+#endif
+
+// Main input and output are processed at one sample size
+constexpr uint32_t kMainPortFlags = CLAP_AUDIO_PORT_IS_MAIN |
+                                    CLAP_AUDIO_PORT_REQUIRES_COMMON_SAMPLE_SIZE |
+                                    kSampleSizeFlags;
+
 // Conversion helper functions
 inline double NormalizedToThreshold(double norm) {
   return kThresholdMin + norm * (kThresholdMax - kThresholdMin);
@@ -44,6 +61,17 @@ inline double OutputLevelToNormalized(double db) {
   return (db - kOutputLevelMin) / (kOutputLevelMax - kOutputLevelMin);
 }
 
+// The processor's lines are allocated for the longest lookahead
+static_assert(kLookaheadMax <= LimiterProcessor::kMaxLookaheadMs);
+
+inline double NormalizedToLookahead(double norm) {
+  return kLookaheadMin + norm * (kLookaheadMax - kLookaheadMin);
+}
+
+inline double LookaheadToNormalized(double ms) {
+  return (ms - kLookaheadMin) / (kLookaheadMax - kLookaheadMin);
+}
+
 // CLAP plugin callbacks
 bool ClapInit(const clap_plugin_t* plugin) {
   auto* limiter = static_cast<LimiterClap*>(plugin->plugin_data);
@@ -173,12 +201,63 @@ static const clap_plugin_audio_ports_t kAudioPortsExtension = {
     ClapAudioPortsGet,
 };
 
+// Audio ports config extension callbacks
+uint32_t ClapAudioPortsConfigCount(const clap_plugin_t* plugin) {
+  auto* limiter = static_cast<LimiterClap*>(plugin->plugin_data);
+  return limiter->AudioPortsConfigCount();
+}
+
+bool ClapAudioPortsConfigGet(const clap_plugin_t* plugin, uint32_t index,
+                             clap_audio_ports_config_t* config) {
+  auto* limiter = static_cast<LimiterClap*>(plugin->plugin_data);
+  return limiter->AudioPortsConfigGet(index, config);
+}
+
+bool ClapAudioPortsConfigSelect(const clap_plugin_t* plugin,
+                                clap_id config_id) {
+  auto* limiter = static_cast<LimiterClap*>(plugin->plugin_data);
+  return limiter->AudioPortsConfigSelect(config_id);
+}
+
+static const clap_plugin_audio_ports_config_t kAudioPortsConfigExtension = {
+    ClapAudioPortsConfigCount,
+    ClapAudioPortsConfigGet,
+    ClapAudioPortsConfigSelect,
+};
+
+// Tail extension callbacks
+uint32_t ClapTailGet(const clap_plugin_t* plugin) {
+  auto* limiter = static_cast<LimiterClap*>(plugin->plugin_data);
+  return limiter->TailGet();
+}
+
+static const clap_plugin_tail_t kTailExtension = {
+    ClapTailGet,
+};
+
+// Latency extension callbacks
+uint32_t ClapLatencyGet(const clap_plugin_t* plugin) {
+  auto* limiter = static_cast<LimiterClap*>(plugin->plugin_data);
+  return limiter->LatencyGet();
+}
+
+static const clap_plugin_latency_t kLatencyExtension = {
+    ClapLatencyGet,
+};
+
 }  // namespace
 
 LimiterClap::LimiterClap(const clap_host_t* host)
     : host_(host),
+      host_latency_(nullptr),
       sample_rate_(44100.0),
-      is_processing_(false) {
+      is_active_(false),
+      is_processing_(false),
+      channel_layout_(stinky_dsp::kStereoLayout),
+      active_lookahead_ms_(5.0f),
+      active_true_peak_(false),
+      restart_requested_(false),
+      latency_(0) {
   plugin_.desc = nullptr;  // Set by factory
   plugin_.plugin_data = this;
   plugin_.init = ClapInit;
@@ -195,9 +274,13 @@ LimiterClap::LimiterClap(const clap_host_t* host)
   // Initialize parameters to normalized defaults
   param_values_[kParamIdThreshold].store(ThresholdToNormalized(-0.1));
   param_values_[kParamIdOutputLevel].store(OutputLevelToNormalized(-0.1));
+  param_values_[kParamIdLookahead].store(LookaheadToNormalized(5.0));
+  param_values_[kParamIdTruePeak].store(0.0);
 }
 
 bool LimiterClap::Init() noexcept {
+  host_latency_ = static_cast<const clap_host_latency_t*>(
+      host_->get_extension(host_, CLAP_EXT_LATENCY));
   UpdateProcessorParams();
   return true;
 }
@@ -205,12 +288,36 @@ bool LimiterClap::Init() noexcept {
 bool LimiterClap::Activate(double sample_rate, uint32_t /*min_frames*/,
                             uint32_t /*max_frames*/) noexcept {
   sample_rate_ = sample_rate;
-  processor_.Initialize(sample_rate);
-  UpdateProcessorParams();  // Sync stored parameter values with processor
+  // Sync stored parameter values first, so Initialize starts from them
+  // without a smoothing ramp. Not yet active, so this latches the lookahead.
+  UpdateProcessorParams();
+  processor_.Initialize(
+      sample_rate,
+      stinky_dsp::kChannelLayouts[channel_layout_].channel_count);
+  silence_.SetTail(processor_.GetTailFrames());
+  silence_.Reset();
+  constant_.Reset();
+  restart_requested_.store(false);
+  is_active_ = true;
+
+  // The lookahead is a fixed time, so its length in samples follows the
+  // sample rate; the host may only be told about a change from here
+  const uint32_t latency =
+      static_cast<uint32_t>(processor_.GetLatencySamples());
+  if (latency != latency_) {
+    latency_ = latency;
+    if (host_latency_ && host_latency_->changed) {
+      host_latency_->changed(host_);
+    }
+  }
+
+  process_stats_.SetSampleRate(sample_rate);
+  process_stats_.Reset();
   return true;
 }
 
 void LimiterClap::Deactivate() noexcept {
+  is_active_ = false;
   is_processing_ = false;
 }
 
@@ -225,58 +332,79 @@ void LimiterClap::StopProcessing() noexcept {
 
 void LimiterClap::Reset() noexcept {
   processor_.Reset();
+  silence_.Reset();
+  constant_.Reset();
+}
+
+template <typename T>
+clap_process_status LimiterClap::ProcessAudio(const clap_process_t* process,
+                                              const T* const* inputs,
+                                              T* const* outputs) noexcept {
+  stinky_dsp::BlockOptions options;
+  options.layout_channels =
+      stinky_dsp::kChannelLayouts[channel_layout_].channel_count;
+  options.may_settle = !processor_.IsRamping();
+  return stinky_dsp::ProcessBlock(
+      process, inputs, outputs, options, silence_, constant_,
+      [this](const clap_event_header_t* header) {
+        return ApplyEvent(header);
+      },
+      [this] { UpdateProcessorParams(); },
+      [this](const T* const* in, T* const* out, uint32_t num_channels,
+             uint32_t /*frame*/, uint32_t frames) {
+        processor_.ProcessChannels<T>(in, out, num_channels, frames);
+      });
 }
 
 clap_process_status LimiterClap::Process(
     const clap_process_t* process) noexcept {
-  // Process parameter changes
-  if (process->in_events) {
-    ProcessParameterChanges(process->in_events);
-  }
-
+  stinky_dsp::ProcessStats::Scope stats_scope(process_stats_,
+                                              process->frames_count);
   const uint32_t frame_count = process->frames_count;
   const uint32_t input_count = process->audio_inputs_count;
   const uint32_t output_count = process->audio_outputs_count;
 
   if (input_count == 0 || output_count == 0 || frame_count == 0) {
+    if (process->in_events) {
+      ProcessParameterChanges(process->in_events);
+    }
     return CLAP_PROCESS_SLEEP;
   }
 
-  // Get input/output channels (handle both mono and stereo)
-  const uint32_t in_channels = process->audio_inputs[0].channel_count;
-  const uint32_t out_channels = process->audio_outputs[0].channel_count;
-  
-  float* in_left = process->audio_inputs[0].data32[0];
-  float* in_right = (in_channels > 1) ? process->audio_inputs[0].data32[1] : nullptr;
-  float* out_left = process->audio_outputs[0].data32[0];
-  float* out_right = (out_channels > 1) ? process->audio_outputs[0].data32[1] : nullptr;
-
-  // Copy input to output
-  std::memcpy(out_left, in_left, frame_count * sizeof(float));
-  if (in_right && out_right) {
-    std::memcpy(out_right, in_right, frame_count * sizeof(float));
+  // The ports take either sample size; the host picks one per block
+  const clap_audio_buffer_t& input = process->audio_inputs[0];
+  const clap_audio_buffer_t& output = process->audio_outputs[0];
+  if (input.data32 && output.data32) {
+    return ProcessAudio(process, input.data32, output.data32);
   }
-
-  // Process limiting
-  if (out_right) {
-    processor_.ProcessStereo(out_left, out_right, frame_count);
-  } else {
-    processor_.ProcessStereo(out_left, out_left, frame_count);
+  if (input.data64 && output.data64) {
+    return ProcessAudio(process, input.data64, output.data64);
   }
-
-  return CLAP_PROCESS_CONTINUE;
+  return CLAP_PROCESS_ERROR;
 }
 
 const void* LimiterClap::GetExtension(const char* id) noexcept {
   if (std::strcmp(id, CLAP_EXT_AUDIO_PORTS) == 0) {
     return &kAudioPortsExtension;
   }
+  if (std::strcmp(id, CLAP_EXT_AUDIO_PORTS_CONFIG) == 0) {
+    return &kAudioPortsConfigExtension;
+  }
   if (std::strcmp(id, CLAP_EXT_PARAMS) == 0) {
     return &kParamsExtension;
   }
   if (std::strcmp(id, CLAP_EXT_STATE) == 0) {
     return &kStateExtension;
   }
+  if (std::strcmp(id, CLAP_EXT_LATENCY) == 0) {
+    return &kLatencyExtension;
+  }
+  if (std::strcmp(id, CLAP_EXT_TAIL) == 0) {
+    return &kTailExtension;
+  }
+  if (std::strcmp(id, STINKY_EXT_PROCESS_STATS) == 0) {
+    return stinky_dsp::ProcessStatsExtension<LimiterClap>();
+  }
   return nullptr;
 }
 
@@ -307,6 +435,21 @@ bool LimiterClap::ParamsInfo(uint32_t param_index,
       info->max_value = 1.0;
       info->default_value = OutputLevelToNormalized(-0.1);
       break;
+    case kParamIdLookahead:
+      std::snprintf(info->name, sizeof(info->name), "Lookahead");
+      info->module[0] = '\0';
+      info->min_value = 0.0;
+      info->max_value = 1.0;
+      info->default_value = LookaheadToNormalized(5.0);
+      break;
+    case kParamIdTruePeak:
+      std::snprintf(info->name, sizeof(info->name), "True Peak");
+      info->module[0] = '\0';
+      info->min_value = 0.0;
+      info->max_value = 1.0;
+      info->default_value = 0.0;
+      info->flags = CLAP_PARAM_IS_AUTOMATABLE | CLAP_PARAM_IS_STEPPED;
+      break;
     default:
       return false;
   }
@@ -332,6 +475,12 @@ bool LimiterClap::ParamsValueToText(clap_id param_id, double value,
     case kParamIdOutputLevel:
       std::snprintf(display, size, "%.2f dB", NormalizedToOutputLevel(value));
       break;
+    case kParamIdLookahead:
+      std::snprintf(display, size, "%.2f ms", NormalizedToLookahead(value));
+      break;
+    case kParamIdTruePeak:
+      std::snprintf(display, size, "%s", value > 0.5 ? "On" : "Off");
+      break;
     default:
       return false;
   }
@@ -359,6 +508,13 @@ bool LimiterClap::ParamsTextToValue(clap_id param_id, const char* display,
     case kParamIdOutputLevel:
       *value = OutputLevelToNormalized(std::clamp(parsed_value, kOutputLevelMin, kOutputLevelMax));
       break;
+    case kParamIdLookahead:
+      *value = LookaheadToNormalized(
+          std::clamp(parsed_value, kLookaheadMin, kLookaheadMax));
+      break;
+    case kParamIdTruePeak:
+      *value = std::clamp(parsed_value, 0.0, 1.0);
+      break;
     default:
       return false;
   }
@@ -384,10 +540,17 @@ bool LimiterClap::StateSave(const clap_ostream_t* stream) noexcept {
 bool LimiterClap::StateLoad(const clap_istream_t* stream) noexcept {
   double values[kParamIdCount];
   int64_t read = stream->read(stream, values, sizeof(values));
-  
-  if (read != sizeof(values)) return false;
 
-  for (int i = 0; i < kParamIdCount; ++i) {
+  // States saved before the lookahead or true-peak parameters existed leave
+  // them unchanged
+  constexpr int64_t kOldestSize = kParamIdLookahead * sizeof(double);
+  if (read < kOldestSize || read > static_cast<int64_t>(sizeof(values)) ||
+      read % sizeof(double) != 0) {
+    return false;
+  }
+
+  const int count = static_cast<int>(read / sizeof(double));
+  for (int i = 0; i < count; ++i) {
     param_values_[i].store(values[i]);
   }
 
@@ -400,25 +563,44 @@ void LimiterClap::ProcessParameterChanges(
   const uint32_t event_count = events->size(events);
 
   for (uint32_t i = 0; i < event_count; ++i) {
-    const clap_event_header_t* header = events->get(events, i);
-
-    if (header->space_id != CLAP_CORE_EVENT_SPACE_ID) continue;
-
-    if (header->type == CLAP_EVENT_PARAM_VALUE) {
-      auto* param_event = reinterpret_cast<const clap_event_param_value_t*>(header);
-      SetParamValue(param_event->param_id, param_event->value);
-    }
+    ApplyEvent(events->get(events, i));
   }
 
   UpdateProcessorParams();
 }
 
+bool LimiterClap::ApplyEvent(const clap_event_header_t* header) noexcept {
+  if (header->space_id != CLAP_CORE_EVENT_SPACE_ID) return false;
+  if (header->type != CLAP_EVENT_PARAM_VALUE) return false;
+
+  auto* param_event = reinterpret_cast<const clap_event_param_value_t*>(header);
+  SetParamValue(param_event->param_id, param_event->value);
+  return true;
+}
+
 void LimiterClap::UpdateProcessorParams() noexcept {
   LimiterParams params;
   params.threshold_db = static_cast<float>(NormalizedToThreshold(param_values_[kParamIdThreshold].load()));
   params.output_level_db = static_cast<float>(NormalizedToOutputLevel(param_values_[kParamIdOutputLevel].load()));
+
+  // A new lookahead or detector mode changes the latency, which needs a
+  // restart when active
+  const float lookahead_ms = static_cast<float>(
+      NormalizedToLookahead(param_values_[kParamIdLookahead].load()));
+  const bool true_peak = param_values_[kParamIdTruePeak].load() > 0.5;
+  if (!is_active_) {
+    active_lookahead_ms_ = lookahead_ms;
+    active_true_peak_ = true_peak;
+  } else if ((lookahead_ms != active_lookahead_ms_ ||
+              true_peak != active_true_peak_) &&
+             !restart_requested_.exchange(true)) {
+    host_->request_restart(host_);
+  }
+  params.lookahead_ms = active_lookahead_ms_;
+  params.true_peak = active_true_peak_;
   
   processor_.SetParams(params);
+  silence_.SetTail(processor_.GetTailFrames());
 }
 
 void LimiterClap::SetParamValue(clap_id param_id, double value) noexcept {
@@ -437,14 +619,31 @@ bool LimiterClap::AudioPortsGet(uint32_t index, bool is_input,
 
   info->id = 0;
   std::snprintf(info->name, sizeof(info->name), is_input ? "Audio Input" : "Audio Output");
-  info->channel_count = 2;
-  info->flags = CLAP_AUDIO_PORT_IS_MAIN;
-  info->port_type = CLAP_PORT_STEREO;
+  info->channel_count =
+      stinky_dsp::kChannelLayouts[channel_layout_].channel_count;
+  info->flags = kMainPortFlags;
+  info->port_type = stinky_dsp::kChannelLayouts[channel_layout_].port_type;
   info->in_place_pair = is_input ? 0 : 0;
 
   return true;
 }
 
+uint32_t LimiterClap::AudioPortsConfigCount() const noexcept {
+  return stinky_dsp::kChannelLayoutCount;
+}
+
+bool LimiterClap::AudioPortsConfigGet(
+    uint32_t index, clap_audio_ports_config_t* config) const noexcept {
+  return stinky_dsp::GetChannelLayoutConfig(index, AudioPortsCount(true),
+                                            config);
+}
+
+bool LimiterClap::AudioPortsConfigSelect(clap_id config_id) noexcept {
+  if (config_id >= stinky_dsp::kChannelLayoutCount) return false;
+  channel_layout_ = config_id;
+  return true;
+}
+
 }  // namespace fast_limiter
 
 // CLAP plugin factory
@@ -503,7 +702,10 @@ static const void* ClapGetFactory(const char* factory_id) {
 
 CLAP_EXPORT const clap_plugin_entry_t clap_entry = {
     CLAP_VERSION,
-    [](const char* /*plugin_path*/) { return true; },
+    [](const char* /*plugin_path*/) {
+      stinky_dsp::simd::Initialize();
+      return true;
+    },
     []() {},
     ClapGetFactory,
 };
@@ -5,220 +5,281 @@
 
 #include <algorithm>
 #include <cmath>
-#include <cstring>
 
 #include "simd_utils.h"
 
 namespace fast_limiter {
 
+namespace simd = stinky_dsp::simd;
+
 namespace {
 
-constexpr float kMinDb = -96.0f;
-constexpr float kEpsilon = 1e-8f;
-constexpr size_t kMaxDelayBufferSize = 48000;  // 1 second at 48kHz
+// Parameter ramp length; long enough to remove zipper noise on sweeps
+constexpr double kSmoothingMs = 20.0;
 
-inline float DbToLinear(float db) {
-  return std::pow(10.0f, db / 20.0f);
-}
+// Brickwall limiter: the lookahead ramp is the attack, fast release (50ms)
+constexpr float kReleaseMs = 50.0f;
 
-inline float LinearToDb(float linear) {
-  return 20.0f * ::log10f(std::max(linear, kEpsilon));
-}
+// Chunks go to the true-peak detector whole
+static_assert(LimiterProcessor::kMaxBlockSize <=
+              stinky_dsp::TruePeakDetector::kMaxBlockSize);
 
 }  // namespace
 
 LimiterProcessor::LimiterProcessor()
     : sample_rate_(44100.0),
       envelope_gain_(1.0f),
+      gain_(1.0f),
       gain_reduction_db_(0.0f),
-      attack_coeff_(0.0f),
       release_coeff_(0.0f),
-      delay_buffer_left_(nullptr),
-      delay_buffer_right_(nullptr),
+      peak_hold_(1),
+      gain_ramp_(1),
+      max_lookahead_(0),
       delay_buffer_size_(0),
-      delay_write_pos_(0),
-      delay_read_pos_(0),
       avg_reduction_db_(0.0f),
       alpha_avg_(0.0f) {
-  // Allocate maximum delay buffer
-  delay_buffer_left_ = new float[kMaxDelayBufferSize];
-  delay_buffer_right_ = new float[kMaxDelayBufferSize];
-  std::memset(delay_buffer_left_, 0, kMaxDelayBufferSize * sizeof(float));
-  std::memset(delay_buffer_right_, 0, kMaxDelayBufferSize * sizeof(float));
+  Initialize(sample_rate_);
 }
 
-LimiterProcessor::~LimiterProcessor() {
-  delete[] delay_buffer_left_;
-  delete[] delay_buffer_right_;
-}
-
-void LimiterProcessor::Initialize(double sample_rate) {
+void LimiterProcessor::Initialize(double sample_rate, uint32_t num_channels) {
   sample_rate_ = sample_rate;
+
+  // Size everything on the lookahead path for the longest lookahead at this
+  // rate. Each line also holds the true-peak filter delay and the chunk
+  // being written while the delayed one is read.
+  max_lookahead_ = static_cast<size_t>(
+      std::ceil(kMaxLookaheadMs * 0.001 * sample_rate));
+  delay_lines_.resize(std::max(num_channels, 2u));
+  for (auto& line : delay_lines_) {
+    line.Allocate(max_lookahead_ + stinky_dsp::TruePeakDetector::kDelay +
+                  kMaxBlockSize);
+  }
+  peak_hold_ = stinky_dsp::SlidingMax(max_lookahead_ + 2);
+  gain_ramp_ = stinky_dsp::MovingAverage(max_lookahead_ + 1);
+
+  // Fresh windows are one sample long, as for no delay, so SetParams below
+  // resizes them for any other delay
+  delay_buffer_size_ = 0;
   Reset();
   
   // Calculate averaging filter coefficient for 2 second time constant
   alpha_avg_ = std::exp(-1.0f / (static_cast<float>(sample_rate) * 2.0f));
   
-  // Recalculate coefficients
+  // Recalculate coefficients, then start from the targets without a ramp
+  threshold_db_.Configure(stinky_dsp::SmoothingType::kOnePole, sample_rate,
+                          kSmoothingMs);
+  output_gain_.Configure(stinky_dsp::SmoothingType::kLinear, sample_rate,
+                         kSmoothingMs);
   SetParams(params_);
+  threshold_db_.Reset(threshold_db_.Target());
+  output_gain_.Reset(output_gain_.Target());
 }
 
 void LimiterProcessor::SetParams(const LimiterParams& params) {
+  const bool mode_changed = params.true_peak != params_.true_peak;
   params_ = params;
-  
-  // Brickwall limiter: instant attack (0.1ms) and fast release (50ms)
-  constexpr float kAttackMs = 0.1f;
-  constexpr float kReleaseMs = 50.0f;
-  
-  attack_coeff_ = std::exp(-1.0f / (kAttackMs * 0.001f * 
-                                     static_cast<float>(sample_rate_)));
+
+  // The gain needed to bring threshold to output level
+  threshold_db_.SetTarget(params_.threshold_db);
+  output_gain_.SetTarget(
+      simd::DbToLinear(params_.output_level_db - params_.threshold_db));
+
   release_coeff_ = std::exp(-1.0f / (kReleaseMs * 0.001f * 
                                       static_cast<float>(sample_rate_)));
   
-  // Fixed 5ms lookahead for brickwall limiting
-  constexpr float kLookaheadMs = 5.0f;
-  size_t new_delay_size = static_cast<size_t>(
-      kLookaheadMs * 0.001f * static_cast<float>(sample_rate_));
-  new_delay_size = std::min(new_delay_size, kMaxDelayBufferSize - 1);
+  // Lookahead for brickwall limiting. True-peak levels trail the input by
+  // the interpolation filter's delay, so the audio waits that much longer.
+  const size_t lookahead = std::min(
+      static_cast<size_t>(std::max(params_.lookahead_ms, 0.0f) * 0.001f *
+                          static_cast<float>(sample_rate_)),
+      max_lookahead_);
+  const size_t new_delay_size =
+      lookahead +
+      (params_.true_peak ? stinky_dsp::TruePeakDetector::kDelay : 0);
   
-  if (new_delay_size != delay_buffer_size_) {
+  if (new_delay_size != delay_buffer_size_ || mode_changed) {
     delay_buffer_size_ = new_delay_size;
-    // Reset positions when size changes
-    delay_write_pos_ = 0;
-    delay_read_pos_ = 0;
-    std::memset(delay_buffer_left_, 0, kMaxDelayBufferSize * sizeof(float));
-    std::memset(delay_buffer_right_, 0, kMaxDelayBufferSize * sizeof(float));
+    for (auto& line : delay_lines_) {
+      line.Clear(delay_buffer_size_);
+    }
+
+    // The window covers the lookahead plus the incoming sample. A true
+    // peak also counts for the frame before it, as it may lie between them.
+    peak_hold_.SetWindow(lookahead + (params_.true_peak ? 2 : 1));
+    gain_ramp_.SetWindow(lookahead + 1, envelope_gain_);
+    gain_ = envelope_gain_;
+    true_peak_.Reset();
   }
 }
 
 void LimiterProcessor::Reset() {
   envelope_gain_ = 1.0f;
+  gain_ = 1.0f;
   gain_reduction_db_ = 0.0f;
+  true_peak_.Reset();
+  peak_hold_.Reset();
+  gain_ramp_.Reset(1.0f);
   avg_reduction_db_ = 0.0f;
-  delay_write_pos_ = 0;
-  delay_read_pos_ = 0;
-  if (delay_buffer_left_ && delay_buffer_right_) {
-    std::memset(delay_buffer_left_, 0, kMaxDelayBufferSize * sizeof(float));
-    std::memset(delay_buffer_right_, 0, kMaxDelayBufferSize * sizeof(float));
-  }
-}
 
-float LimiterProcessor::CalculateGainReduction(float input_level_db) const {
-  // Limiter uses infinite ratio - anything above threshold is reduced to threshold
-  if (input_level_db > params_.threshold_db) {
-    // Gain reduction needed (this will be negative or zero)
-    return params_.threshold_db - input_level_db;
+  // Only the delay's worth of samples before the write position can still
+  // be read, so the rest of each line is left alone
+  for (auto& line : delay_lines_) {
+    line.Clear(delay_buffer_size_);
   }
-  return 0.0f;  // No reduction needed
 }
 
-float LimiterProcessor::ApplyEnvelope(float target_gain, float current_gain) {
-  // Use attack when gain needs to decrease (limiting action)
-  // Use release when gain recovers
-  const float coeff = (target_gain < current_gain) ? 
-                      attack_coeff_ : release_coeff_;
-  return coeff * current_gain + (1.0f - coeff) * target_gain;
+uint32_t LimiterProcessor::GetTailFrames() const {
+  // The peak is held across the line, then the ramp takes as long again
+  return static_cast<uint32_t>(
+      2 * delay_buffer_size_ + std::ceil(kReleaseMs * 0.001 * sample_rate_));
 }
 
-void LimiterProcessor::UpdateDelayBuffer(float left_sample, float right_sample) {
-  if (delay_buffer_size_ == 0) return;
-  
-  delay_buffer_left_[delay_write_pos_] = left_sample;
-  delay_buffer_right_[delay_write_pos_] = right_sample;
-  
-  delay_write_pos_ = (delay_write_pos_ + 1) % delay_buffer_size_;
-}
-
-void LimiterProcessor::GetDelayedSample(float& left_out, float& right_out) {
-  if (delay_buffer_size_ == 0) {
-    return;  // No delay, keep current values
+float LimiterProcessor::NextGain(float target_gain) {
+  // Drop at once to a lower target, release towards a higher one. The
+  // released gain never exceeds the target, so neither does the ramp's mean
+  // of it when the held peak reaches the output.
+  if (target_gain < envelope_gain_) {
+    envelope_gain_ = target_gain;
+  } else {
+    envelope_gain_ = release_coeff_ * envelope_gain_ +
+                     (1.0f - release_coeff_) * target_gain;
   }
-  
-  left_out = delay_buffer_left_[delay_read_pos_];
-  right_out = delay_buffer_right_[delay_read_pos_];
-  
-  delay_read_pos_ = (delay_read_pos_ + 1) % delay_buffer_size_;
+  gain_ = gain_ramp_.Push(envelope_gain_);
+  return gain_;
 }
 
 void LimiterProcessor::Process(float* buffer, size_t num_frames) {
-  // Calculate the gain needed to bring threshold to output level
-  const float output_gain = DbToLinear(params_.output_level_db - params_.threshold_db);
-  
   for (size_t i = 0; i < num_frames * 2; i += 2) {
     float left = buffer[i];
     float right = buffer[i + 1];
     
-    // Store in delay buffer for lookahead
-    UpdateDelayBuffer(left, right);
-    
-    // Get peak level from current (future) stereo pair
-    const float left_abs = std::abs(left);
-    const float right_abs = std::abs(right);
-    const float peak = std::max(left_abs, right_abs);
+    // Peak of the current (future) stereo pair, held over the lookahead
+    float pair_peak;
+    if (params_.true_peak) {
+      const float* channels[] = {&left, &right};
+      true_peak_.Process(&pair_peak, channels, 2, 1);
+    } else {
+      pair_peak = std::max(std::abs(left), std::abs(right));
+    }
+    const float peak = peak_hold_.Push(pair_peak);
     
     // Convert to dB
-    const float peak_db = LinearToDb(peak);
+    const float peak_db = simd::LinearToDb(peak);
     
     // Calculate target gain reduction in dB (brickwall: anything above threshold gets reduced)
-    const float gain_reduction_db = CalculateGainReduction(peak_db);
-    const float target_gain = DbToLinear(gain_reduction_db);
+    const float gain_reduction_db =
+        std::min(threshold_db_.Next() - peak_db, 0.0f);
+    const float target_gain = simd::DbToLinear(gain_reduction_db);
     
-    // Apply envelope (instant attack, fast release)
-    envelope_gain_ = ApplyEnvelope(target_gain, envelope_gain_);
+    // Apply envelope (instant attack, fast release) and lookahead ramp
+    const float limit_gain = NextGain(target_gain);
     
     // Store gain reduction for metering
-    gain_reduction_db_ = LinearToDb(envelope_gain_);
+    gain_reduction_db_ = simd::LinearToDb(limit_gain);
     
-    // Get delayed samples (past audio)
-    float delayed_left = left;
-    float delayed_right = right;
-    GetDelayedSample(delayed_left, delayed_right);
+    // Store the current pair, then get the one from one lookahead ago
+    delay_lines_[0].Push(left);
+    delay_lines_[1].Push(right);
+    const double delayed_left = delay_lines_[0].Delayed(delay_buffer_size_);
+    const double delayed_right = delay_lines_[1].Delayed(delay_buffer_size_);
     
     // Apply gain reduction and output scaling to delayed samples
-    buffer[i] = delayed_left * envelope_gain_ * output_gain;
-    buffer[i + 1] = delayed_right * envelope_gain_ * output_gain;
+    const float gain = limit_gain * output_gain_.Next();
+    buffer[i] = static_cast<float>(delayed_left) * gain;
+    buffer[i + 1] = static_cast<float>(delayed_right) * gain;
   }
 }
 
 void LimiterProcessor::ProcessStereo(float* left, float* right, 
                                      size_t num_frames) {
-  // Calculate the gain needed to bring threshold to output level
-  const float output_gain = DbToLinear(params_.output_level_db - params_.threshold_db);
+  ProcessStereo(left, right, left, right, num_frames);
+}
+
+template <typename T>
+void LimiterProcessor::ProcessStereo(const T* in_left, const T* in_right,
+                                     T* out_left, T* out_right,
+                                     size_t num_frames) {
+  const T* inputs[] = {in_left, in_right};
+  T* outputs[] = {out_left, out_right};
+  ProcessChannels(inputs, outputs, out_left == out_right ? 1 : 2,
+                  num_frames);
+}
+
+template <typename T>
+void LimiterProcessor::ProcessChannels(const T* const* inputs,
+                                       T* const* outputs,
+                                       uint32_t num_channels,
+                                       size_t num_frames) {
+  size_t offset = 0;
+  while (offset < num_frames) {
+    // Re-evaluate the threshold every kRampBlockSize frames while it ramps
+    const bool ramping = threshold_db_.IsSmoothing();
+    const size_t block_frames = std::min(
+        ramping ? kRampBlockSize : kMaxBlockSize, num_frames - offset);
+
+    ProcessBlock<T>(stinky_dsp::ChannelOffsets(inputs, num_channels, offset),
+                    stinky_dsp::ChannelOffsets(outputs, num_channels, offset),
+                    num_channels, block_frames, threshold_db_.Current());
+
+    if (ramping) {
+      threshold_db_.Advance(block_frames);
+    }
+    offset += block_frames;
+  }
   
+  // Store gain reduction for metering (will be negative or zero)
+  gain_reduction_db_ = simd::LinearToDb(gain_);
+}
+
+template <typename T>
+void LimiterProcessor::ProcessBlock(const T* const* inputs, T* const* outputs,
+                                    uint32_t num_channels, size_t num_frames,
+                                    float threshold_db) {
+  // Peak level of the current (future) frames, linked across channels and
+  // held over every frame still in the lookahead line, in dB. Only this
+  // detector path is oversampled in true-peak mode.
+  if (params_.true_peak) {
+    true_peak_.Process(detector_, inputs, num_channels, num_frames);
+  } else {
+    simd::MaxAbs(detector_, inputs, num_channels, num_frames);
+  }
   for (size_t i = 0; i < num_frames; ++i) {
-    float left_sample = left[i];
-    float right_sample = right[i];
-    
-    // Store in delay buffer for lookahead
-    UpdateDelayBuffer(left_sample, right_sample);
-    
-    // Get peak level from current (future) stereo pair
-    const float left_abs = std::abs(left_sample);
-    const float right_abs = std::abs(right_sample);
-    const float peak = std::max(left_abs, right_abs);
-    
-    // Convert to dB
-    const float peak_db = LinearToDb(peak);
-    
-    // Calculate target gain reduction in dB (brickwall: anything above threshold gets reduced)
-    const float gain_reduction_db = CalculateGainReduction(peak_db);
-    const float target_gain = DbToLinear(gain_reduction_db);
-    
-    // Apply envelope (instant attack, fast release)
-    envelope_gain_ = ApplyEnvelope(target_gain, envelope_gain_);
-    
-    // Store gain reduction for metering (will be negative or zero)
-    gain_reduction_db_ = LinearToDb(envelope_gain_);
-    
-    // Get delayed samples (past audio)
-    float delayed_left = left_sample;
-    float delayed_right = right_sample;
-    GetDelayedSample(delayed_left, delayed_right);
-    
-    // Apply gain reduction and output scaling to delayed samples
-    left[i] = delayed_left * envelope_gain_ * output_gain;
-    right[i] = delayed_right * envelope_gain_ * output_gain;
+    detector_[i] = peak_hold_.Push(detector_[i]);
+  }
+  simd::ConvertToDb(detector_, detector_, num_frames);
+  
+  // Target gain (brickwall: infinite ratio, anything above threshold gets reduced)
+  simd::ComputeGainReductionDb(detector_, detector_, threshold_db, -1.0f,
+                               0.0f, num_frames);
+  simd::DbToLinear(detector_, detector_, num_frames);
+  
+  // Envelope, lookahead ramp and output scaling per frame
+  for (size_t i = 0; i < num_frames; ++i) {
+    detector_[i] = NextGain(detector_[i]) * output_gain_.Next();
+  }
+
+  // Each channel leaves through its own lookahead line: store the chunk,
+  // copy out the frames from one lookahead ago, then apply the gain. The
+  // input is consumed before the output, which may be the same buffer.
+  for (uint32_t channel = 0; channel < num_channels; ++channel) {
+    T* out = outputs[channel];
+    delay_lines_[channel].Write(inputs[channel], num_frames);
+    delay_lines_[channel].Read(out, delay_buffer_size_, num_frames);
+    for (size_t i = 0; i < num_frames; ++i) {
+      out[i] *= detector_[i];
+    }
   }
 }
 
+template void LimiterProcessor::ProcessStereo(const float*, const float*,
+                                              float*, float*, size_t);
+template void LimiterProcessor::ProcessStereo(const double*, const double*,
+                                              double*, double*, size_t);
+template void LimiterProcessor::ProcessChannels(const float* const*,
+                                                float* const*, uint32_t,
+                                                size_t);
+template void LimiterProcessor::ProcessChannels(const double* const*,
+                                                double* const*, uint32_t,
+                                                size_t);
+
 }  // namespace fast_limiter
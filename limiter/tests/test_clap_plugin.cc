@@ -2,16 +2,24 @@
 // End-to-end tests for CLAP Limiter plugin
 
 #include "limiter_clap.h"
+#include "allocation_guard.h"
+#include "param_event_list.h"
+#include "process_stats_extension.h"
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <memory>
+#include <numbers>
 #include <vector>
 
 namespace fast_limiter {
 namespace {
 
+using stinky_dsp::ParamEventList;
+
 // Mock CLAP host
 class MockClapHost {
  public:
@@ -22,18 +30,31 @@ class MockClapHost {
     host_.vendor = "Test Vendor";
     host_.url = "https://test.com";
     host_.version = "1.0.0";
-    host_.get_extension = [](const clap_host_t*, const char*) -> const void* {
-      return nullptr;
+    host_.get_extension = [](const clap_host_t* host,
+                             const char* id) -> const void* {
+      auto* self = static_cast<MockClapHost*>(host->host_data);
+      return std::strcmp(id, CLAP_EXT_LATENCY) == 0 ? &self->latency_
+                                                     : nullptr;
+    };
+    host_.request_restart = [](const clap_host_t* host) {
+      ++static_cast<MockClapHost*>(host->host_data)->restart_requests_;
     };
-    host_.request_restart = [](const clap_host_t*) {};
     host_.request_process = [](const clap_host_t*) {};
     host_.request_callback = [](const clap_host_t*) {};
+    latency_.changed = [](const clap_host_t* host) {
+      ++static_cast<MockClapHost*>(host->host_data)->latency_changes_;
+    };
   }
 
   const clap_host_t* Host() { return &host_; }
+  int RestartRequests() const { return restart_requests_; }
+  int LatencyChanges() const { return latency_changes_; }
 
  private:
   clap_host_t host_;
+  clap_host_latency_t latency_;
+  int restart_requests_ = 0;
+  int latency_changes_ = 0;
 };
 
 class ClapPluginTest : public ::testing::Test {
@@ -151,11 +172,13 @@ TEST_F(ClapPluginTest, AudioPortsGetReturnsValidInfo) {
   
   EXPECT_TRUE(plugin_->AudioPortsGet(0, true, &info));
   EXPECT_EQ(info.channel_count, 2u);
-  EXPECT_EQ(info.flags, CLAP_AUDIO_PORT_IS_MAIN);
+  EXPECT_TRUE(info.flags & CLAP_AUDIO_PORT_IS_MAIN);
+  EXPECT_TRUE(info.flags & CLAP_AUDIO_PORT_SUPPORTS_64BITS);
   
   EXPECT_TRUE(plugin_->AudioPortsGet(0, false, &info));
   EXPECT_EQ(info.channel_count, 2u);
-  EXPECT_EQ(info.flags, CLAP_AUDIO_PORT_IS_MAIN);
+  EXPECT_TRUE(info.flags & CLAP_AUDIO_PORT_IS_MAIN);
+  EXPECT_TRUE(info.flags & CLAP_AUDIO_PORT_SUPPORTS_64BITS);
 }
 
 TEST_F(ClapPluginTest, AudioPortsGetOutOfRangeFails) {
@@ -167,12 +190,557 @@ TEST_F(ClapPluginTest, GetExtensionReturnsValidPointers) {
   EXPECT_NE(plugin_->GetExtension(CLAP_EXT_AUDIO_PORTS), nullptr);
   EXPECT_NE(plugin_->GetExtension(CLAP_EXT_PARAMS), nullptr);
   EXPECT_NE(plugin_->GetExtension(CLAP_EXT_STATE), nullptr);
+  EXPECT_NE(plugin_->GetExtension(CLAP_EXT_LATENCY), nullptr);
+  EXPECT_NE(plugin_->GetExtension(CLAP_EXT_TAIL), nullptr);
+  EXPECT_NE(plugin_->GetExtension(STINKY_EXT_PROCESS_STATS), nullptr);
 }
 
 TEST_F(ClapPluginTest, GetExtensionReturnsNullForUnknown) {
   EXPECT_EQ(plugin_->GetExtension("unknown.extension"), nullptr);
 }
 
+TEST_F(ClapPluginTest, LatencyFollowsSampleRate) {
+  auto* latency = static_cast<const clap_plugin_latency_t*>(
+      plugin_->GetExtension(CLAP_EXT_LATENCY));
+  ASSERT_NE(latency, nullptr);
+
+  // Default 5 ms lookahead
+  ASSERT_TRUE(plugin_->Activate(48000.0, 64, 512));
+  EXPECT_EQ(latency->get(plugin_->ClapPlugin()), 240u);
+  EXPECT_EQ(host_->LatencyChanges(), 1);
+  plugin_->Deactivate();
+
+  ASSERT_TRUE(plugin_->Activate(48000.0, 64, 512));
+  EXPECT_EQ(host_->LatencyChanges(), 1);
+  plugin_->Deactivate();
+
+  ASSERT_TRUE(plugin_->Activate(96000.0, 64, 512));
+  EXPECT_EQ(latency->get(plugin_->ClapPlugin()), 480u);
+  EXPECT_EQ(host_->LatencyChanges(), 2);
+  plugin_->Deactivate();
+}
+
+TEST_F(ClapPluginTest, LookaheadChangeWhileActiveRequestsRestart) {
+  ASSERT_TRUE(plugin_->Activate(48000.0, 64, 512));
+  EXPECT_EQ(plugin_->LatencyGet(), 240u);
+
+  // 1 ms: latency holds until the host restarts the plugin
+  ParamEventList events;
+  events.Add(0, kParamIdLookahead, 0.1);
+  plugin_->ParamsFlush(events.Events(), nullptr);
+  plugin_->ParamsFlush(events.Events(), nullptr);
+  EXPECT_EQ(host_->RestartRequests(), 1);
+  EXPECT_EQ(plugin_->LatencyGet(), 240u);
+
+  plugin_->Deactivate();
+  ASSERT_TRUE(plugin_->Activate(48000.0, 64, 512));
+  EXPECT_EQ(plugin_->LatencyGet(), 48u);
+  plugin_->Deactivate();
+
+  // No lookahead, no latency; inactive changes need no restart
+  ParamEventList off;
+  off.Add(0, kParamIdLookahead, 0.0);
+  plugin_->ParamsFlush(off.Events(), nullptr);
+  EXPECT_EQ(host_->RestartRequests(), 1);
+  ASSERT_TRUE(plugin_->Activate(48000.0, 64, 512));
+  EXPECT_EQ(plugin_->LatencyGet(), 0u);
+  plugin_->Deactivate();
+}
+
+TEST_F(ClapPluginTest, TruePeakModeAddsFilterDelayToLatency) {
+  ASSERT_TRUE(plugin_->Activate(48000.0, 64, 512));
+  EXPECT_EQ(plugin_->LatencyGet(), 240u);
+
+  ParamEventList events;
+  events.Add(0, kParamIdTruePeak, 1.0);
+  plugin_->ParamsFlush(events.Events(), nullptr);
+  EXPECT_EQ(host_->RestartRequests(), 1);
+  EXPECT_EQ(plugin_->LatencyGet(), 240u);
+
+  plugin_->Deactivate();
+  ASSERT_TRUE(plugin_->Activate(48000.0, 64, 512));
+  EXPECT_EQ(plugin_->LatencyGet(),
+            240u + stinky_dsp::TruePeakDetector::kDelay);
+  plugin_->Deactivate();
+}
+
+TEST_F(ClapPluginTest, LongestLookaheadIsSizedForTheSampleRate) {
+  // 10 ms in true-peak mode at 192 kHz, well past any fixed 48 kHz sizing
+  ParamEventList events;
+  events.Add(0, kParamIdLookahead, 1.0);
+  events.Add(0, kParamIdTruePeak, 1.0);
+  plugin_->ParamsFlush(events.Events(), nullptr);
+  ASSERT_TRUE(plugin_->Activate(192000.0, 64, 512));
+  ASSERT_TRUE(plugin_->StartProcessing());
+  const uint32_t latency = plugin_->LatencyGet();
+  EXPECT_EQ(latency, 1920u + stinky_dsp::TruePeakDetector::kDelay);
+
+  constexpr uint32_t frame_count = 512;
+  std::vector<float> left(frame_count);
+  std::vector<float> right(frame_count);
+  float* ptrs[] = {left.data(), right.data()};
+  clap_audio_buffer_t io = {ptrs, nullptr, 2, 0, 0};
+  clap_process_t process = {};
+  process.frames_count = frame_count;
+  process.audio_inputs = &io;
+  process.audio_inputs_count = 1;
+  process.audio_outputs = &io;
+  process.audio_outputs_count = 1;
+
+  // An impulse under the ceiling leaves exactly one latency later
+  constexpr uint32_t kImpulse = 10;
+  for (uint32_t block = 0; block < 5; ++block) {
+    for (uint32_t i = 0; i < frame_count; ++i) {
+      left[i] = block * frame_count + i == kImpulse ? 0.5f : 0.0f;
+      right[i] = -left[i];
+    }
+    ASSERT_EQ(plugin_->Process(&process), CLAP_PROCESS_CONTINUE);
+    for (uint32_t i = 0; i < frame_count; ++i) {
+      const uint32_t frame = block * frame_count + i;
+      const float expected = frame == kImpulse + latency ? 0.5f : 0.0f;
+      ASSERT_NEAR(left[i], expected, 1e-4f) << "frame " << frame;
+      ASSERT_NEAR(right[i], -expected, 1e-4f) << "frame " << frame;
+    }
+  }
+  plugin_->StopProcessing();
+  plugin_->Deactivate();
+}
+
+TEST_F(ClapPluginTest, SilentInputSleepsOnceTailHasPassed) {
+  ASSERT_TRUE(plugin_->Activate(48000.0, 64, 512));
+  ASSERT_TRUE(plugin_->StartProcessing());
+
+  auto* tail = static_cast<const clap_plugin_tail_t*>(
+      plugin_->GetExtension(CLAP_EXT_TAIL));
+  ASSERT_NE(tail, nullptr);
+  const uint32_t tail_frames = tail->get(plugin_->ClapPlugin());
+  // 5 ms peak hold and 5 ms ramp, then 50 ms release
+  EXPECT_EQ(tail_frames, 240u + 240u + 2400u);
+
+  constexpr uint32_t frame_count = 512;
+  std::vector<float> in_left(frame_count, 0.0f);
+  std::vector<float> in_right(frame_count, 0.0f);
+  std::vector<float> out_left(frame_count, 1.0f);
+  std::vector<float> out_right(frame_count, 1.0f);
+  float* in_ptrs[] = {in_left.data(), in_right.data()};
+  float* out_ptrs[] = {out_left.data(), out_right.data()};
+  clap_audio_buffer_t input = {in_ptrs, nullptr, 2, 0, 0};
+  clap_audio_buffer_t output = {out_ptrs, nullptr, 2, 0, 0};
+
+  clap_process_t process = {};
+  process.frames_count = frame_count;
+  process.audio_inputs = &input;
+  process.audio_inputs_count = 1;
+  process.audio_outputs = &output;
+  process.audio_outputs_count = 1;
+
+  // Silence keeps processing until the lookahead and release have run out
+  uint64_t processed = 0;
+  while (plugin_->Process(&process) == CLAP_PROCESS_CONTINUE) {
+    processed += frame_count;
+    ASSERT_LT(processed, tail_frames) << "never went to sleep";
+  }
+  EXPECT_GE(processed + frame_count, tail_frames);
+
+  // Past the tail the block is skipped and cleared
+  std::fill(out_left.begin(), out_left.end(), 1.0f);
+  std::fill(out_right.begin(), out_right.end(), 1.0f);
+  EXPECT_EQ(plugin_->Process(&process), CLAP_PROCESS_SLEEP);
+  for (uint32_t i = 0; i < frame_count; ++i) {
+    ASSERT_EQ(out_left[i], 0.0f);
+    ASSERT_EQ(out_right[i], 0.0f);
+  }
+  EXPECT_EQ(output.constant_mask, 0b11u);
+
+  // Input wakes it up
+  in_left[0] = 0.5f;
+  EXPECT_EQ(plugin_->Process(&process), CLAP_PROCESS_CONTINUE);
+  EXPECT_EQ(output.constant_mask, 0u);
+}
+
+TEST_F(ClapPluginTest, InPlaceMatchesSeparateBuffers) {
+  auto in_place = std::make_unique<LimiterClap>(host_->Host());
+  ASSERT_TRUE(in_place->Init());
+  for (auto* plugin : {plugin_.get(), in_place.get()}) {
+    ASSERT_TRUE(plugin->Activate(48000.0, 64, 512));
+    ASSERT_TRUE(plugin->StartProcessing());
+  }
+
+  constexpr uint32_t frame_count = 512;
+  std::vector<float> in_left(frame_count);
+  std::vector<float> in_right(frame_count);
+  std::vector<float> out_left(frame_count);
+  std::vector<float> out_right(frame_count);
+  std::vector<float> io_left(frame_count);
+  std::vector<float> io_right(frame_count);
+  float* in_ptrs[] = {in_left.data(), in_right.data()};
+  float* out_ptrs[] = {out_left.data(), out_right.data()};
+  float* io_ptrs[] = {io_left.data(), io_right.data()};
+  clap_audio_buffer_t input = {in_ptrs, nullptr, 2, 0, 0};
+  clap_audio_buffer_t output = {out_ptrs, nullptr, 2, 0, 0};
+  clap_audio_buffer_t io = {io_ptrs, nullptr, 2, 0, 0};
+
+  clap_process_t separate = {};
+  separate.frames_count = frame_count;
+  separate.audio_inputs = &input;
+  separate.audio_inputs_count = 1;
+  separate.audio_outputs = &output;
+  separate.audio_outputs_count = 1;
+
+  // The host hands the same buffer in and out
+  clap_process_t shared = separate;
+  shared.audio_inputs = &io;
+  shared.audio_outputs = &io;
+
+  for (uint32_t block = 0; block < 8; ++block) {
+    for (uint32_t i = 0; i < frame_count; ++i) {
+      const float t = static_cast<float>(block * frame_count + i);
+      in_left[i] = io_left[i] = 0.9f * std::sin(0.01f * t);
+      in_right[i] = io_right[i] = 0.6f * std::sin(0.023f * t);
+    }
+
+    ASSERT_EQ(plugin_->Process(&separate), CLAP_PROCESS_CONTINUE);
+    ASSERT_EQ(in_place->Process(&shared), CLAP_PROCESS_CONTINUE);
+    ASSERT_EQ(io_left, out_left) << "block " << block;
+    ASSERT_EQ(io_right, out_right) << "block " << block;
+  }
+}
+
+TEST_F(ClapPluginTest, DoubleBuffersMatchFloat) {
+  auto wide = std::make_unique<LimiterClap>(host_->Host());
+  ASSERT_TRUE(wide->Init());
+  for (auto* plugin : {plugin_.get(), wide.get()}) {
+    ASSERT_TRUE(plugin->Activate(48000.0, 64, 512));
+    ASSERT_TRUE(plugin->StartProcessing());
+  }
+
+  clap_audio_port_info_t info;
+  ASSERT_TRUE(wide->AudioPortsGet(0, true, &info));
+  EXPECT_TRUE(info.flags & CLAP_AUDIO_PORT_SUPPORTS_64BITS);
+  ASSERT_TRUE(wide->AudioPortsGet(0, false, &info));
+  EXPECT_TRUE(info.flags & CLAP_AUDIO_PORT_SUPPORTS_64BITS);
+
+  constexpr uint32_t frame_count = 512;
+  std::vector<float> left(frame_count);
+  std::vector<float> right(frame_count);
+  std::vector<double> wide_left(frame_count);
+  std::vector<double> wide_right(frame_count);
+  float* ptrs[] = {left.data(), right.data()};
+  double* wide_ptrs[] = {wide_left.data(), wide_right.data()};
+  clap_audio_buffer_t io = {ptrs, nullptr, 2, 0, 0};
+  clap_audio_buffer_t wide_io = {nullptr, wide_ptrs, 2, 0, 0};
+
+  clap_process_t process = {};
+  process.frames_count = frame_count;
+  process.audio_inputs = &io;
+  process.audio_inputs_count = 1;
+  process.audio_outputs = &io;
+  process.audio_outputs_count = 1;
+
+  clap_process_t wide_process = process;
+  wide_process.audio_inputs = &wide_io;
+  wide_process.audio_outputs = &wide_io;
+
+  for (uint32_t block = 0; block < 8; ++block) {
+    for (uint32_t i = 0; i < frame_count; ++i) {
+      const float t = static_cast<float>(block * frame_count + i);
+      left[i] = 0.9f * std::sin(0.01f * t);
+      right[i] = 0.6f * std::sin(0.023f * t);
+      wide_left[i] = left[i];
+      wide_right[i] = right[i];
+    }
+
+    ASSERT_EQ(plugin_->Process(&process), CLAP_PROCESS_CONTINUE);
+    ASSERT_EQ(wide->Process(&wide_process), CLAP_PROCESS_CONTINUE);
+    for (uint32_t i = 0; i < frame_count; ++i) {
+      ASSERT_NEAR(wide_left[i], left[i], 1e-4) << "block " << block;
+      ASSERT_NEAR(wide_right[i], right[i], 1e-4) << "block " << block;
+    }
+  }
+
+  // Input and output must share a sample size
+  process.audio_outputs = &wide_io;
+  EXPECT_EQ(plugin_->Process(&process), CLAP_PROCESS_ERROR);
+}
+
+TEST_F(ClapPluginTest, SurroundLayoutMatchesStereoPerChannel) {
+  auto* config = static_cast<const clap_plugin_audio_ports_config_t*>(
+      plugin_->GetExtension(CLAP_EXT_AUDIO_PORTS_CONFIG));
+  ASSERT_NE(config, nullptr);
+  const clap_plugin_t* clap_plugin = plugin_->ClapPlugin();
+  EXPECT_EQ(config->count(clap_plugin), stinky_dsp::kChannelLayoutCount);
+
+  clap_audio_ports_config_t layout;
+  EXPECT_FALSE(config->get(clap_plugin, stinky_dsp::kChannelLayoutCount,
+                           &layout));
+  ASSERT_TRUE(config->get(clap_plugin, 2, &layout));
+  EXPECT_EQ(layout.input_port_count, plugin_->AudioPortsCount(true));
+  EXPECT_EQ(layout.main_input_channel_count, 6u);
+  EXPECT_STREQ(layout.main_output_port_type, CLAP_PORT_SURROUND);
+  EXPECT_FALSE(config->select(clap_plugin, stinky_dsp::kChannelLayoutCount));
+  ASSERT_TRUE(config->select(clap_plugin, layout.id));
+
+  clap_audio_port_info_t port;
+  ASSERT_TRUE(plugin_->AudioPortsGet(0, false, &port));
+  EXPECT_EQ(port.channel_count, 6u);
+  EXPECT_STREQ(port.port_type, CLAP_PORT_SURROUND);
+
+  auto stereo = std::make_unique<LimiterClap>(host_->Host());
+  ASSERT_TRUE(stereo->Init());
+  for (auto* plugin : {plugin_.get(), stereo.get()}) {
+    ASSERT_TRUE(plugin->Activate(48000.0, 64, 512));
+    ASSERT_TRUE(plugin->StartProcessing());
+  }
+
+  constexpr uint32_t kChannels = 6;
+  constexpr uint32_t frame_count = 512;
+  std::vector<std::vector<float>> surround(kChannels,
+                                           std::vector<float>(frame_count));
+  std::vector<float> left(frame_count);
+  std::vector<float> right(frame_count);
+  float* surround_ptrs[kChannels];
+  for (uint32_t c = 0; c < kChannels; ++c) {
+    surround_ptrs[c] = surround[c].data();
+  }
+  float* stereo_ptrs[] = {left.data(), right.data()};
+  clap_audio_buffer_t surround_io = {surround_ptrs, nullptr, kChannels, 0, 0};
+  clap_audio_buffer_t stereo_io = {stereo_ptrs, nullptr, 2, 0, 0};
+
+  clap_process_t process = {};
+  process.frames_count = frame_count;
+  process.audio_inputs = &surround_io;
+  process.audio_inputs_count = 1;
+  process.audio_outputs = &surround_io;
+  process.audio_outputs_count = 1;
+
+  clap_process_t stereo_process = process;
+  stereo_process.audio_inputs = &stereo_io;
+  stereo_process.audio_outputs = &stereo_io;
+
+  // Channels 0 and 5 through a stereo instance give the same output.
+  // Channel 0 is the loudest, so linked detectors see the same peak.
+  for (uint32_t block = 0; block < 8; ++block) {
+    for (uint32_t i = 0; i < frame_count; ++i) {
+      const float t = static_cast<float>(block * frame_count + i);
+      const float signal = 0.9f * std::sin(0.01f * t);
+      for (uint32_t c = 0; c < kChannels; ++c) {
+        surround[c][i] = signal * (1.0f - 0.15f * static_cast<float>(c));
+      }
+      left[i] = surround[0][i];
+      right[i] = surround[5][i];
+    }
+
+    ASSERT_EQ(plugin_->Process(&process), CLAP_PROCESS_CONTINUE);
+    ASSERT_EQ(stereo->Process(&stereo_process), CLAP_PROCESS_CONTINUE);
+    ASSERT_EQ(surround[0], left) << "block " << block;
+    ASSERT_EQ(surround[5], right) << "block " << block;
+  }
+}
+
+TEST_F(ClapPluginTest, MonoLayoutMatchesStereoWithBothSidesEqual) {
+  auto* config = static_cast<const clap_plugin_audio_ports_config_t*>(
+      plugin_->GetExtension(CLAP_EXT_AUDIO_PORTS_CONFIG));
+  ASSERT_NE(config, nullptr);
+  ASSERT_TRUE(config->select(plugin_->ClapPlugin(), 0));
+
+  clap_audio_port_info_t port;
+  ASSERT_TRUE(plugin_->AudioPortsGet(0, true, &port));
+  EXPECT_EQ(port.channel_count, 1u);
+  EXPECT_STREQ(port.port_type, CLAP_PORT_MONO);
+
+  auto stereo = std::make_unique<LimiterClap>(host_->Host());
+  ASSERT_TRUE(stereo->Init());
+  for (auto* plugin : {plugin_.get(), stereo.get()}) {
+    ASSERT_TRUE(plugin->Activate(48000.0, 64, 512));
+    ASSERT_TRUE(plugin->StartProcessing());
+  }
+
+  constexpr uint32_t frame_count = 512;
+  std::vector<float> mono(frame_count);
+  std::vector<float> left(frame_count);
+  std::vector<float> right(frame_count);
+  float* mono_ptrs[] = {mono.data()};
+  float* stereo_ptrs[] = {left.data(), right.data()};
+  clap_audio_buffer_t mono_io = {mono_ptrs, nullptr, 1, 0, 0};
+  clap_audio_buffer_t stereo_io = {stereo_ptrs, nullptr, 2, 0, 0};
+
+  clap_process_t process = {};
+  process.frames_count = frame_count;
+  process.audio_inputs = &mono_io;
+  process.audio_inputs_count = 1;
+  process.audio_outputs = &mono_io;
+  process.audio_outputs_count = 1;
+
+  clap_process_t stereo_process = process;
+  stereo_process.audio_inputs = &stereo_io;
+  stereo_process.audio_outputs = &stereo_io;
+
+  // The one channel is processed once, like either side of a stereo pair
+  for (uint32_t block = 0; block < 8; ++block) {
+    for (uint32_t i = 0; i < frame_count; ++i) {
+      const float t = static_cast<float>(block * frame_count + i);
+      mono[i] = left[i] = right[i] = 0.9f * std::sin(0.01f * t);
+    }
+
+    ASSERT_EQ(plugin_->Process(&process), CLAP_PROCESS_CONTINUE);
+    ASSERT_EQ(stereo->Process(&stereo_process), CLAP_PROCESS_CONTINUE);
+    ASSERT_EQ(mono, left) << "block " << block;
+  }
+}
+
+TEST_F(ClapPluginTest, SettledConstantInputGivesConstantOutput) {
+  ASSERT_TRUE(plugin_->Activate(48000.0, 64, 512));
+  ASSERT_TRUE(plugin_->StartProcessing());
+
+  auto* tail = static_cast<const clap_plugin_tail_t*>(
+      plugin_->GetExtension(CLAP_EXT_TAIL));
+  ASSERT_NE(tail, nullptr);
+  const uint32_t tail_frames = tail->get(plugin_->ClapPlugin());
+
+  constexpr uint32_t frame_count = 512;
+  std::vector<float> in_left(frame_count, 0.5f);
+  std::vector<float> in_right(frame_count, 0.5f);
+  std::vector<float> out_left(frame_count, 0.0f);
+  std::vector<float> out_right(frame_count, 0.0f);
+  float* in_ptrs[] = {in_left.data(), in_right.data()};
+  float* out_ptrs[] = {out_left.data(), out_right.data()};
+  clap_audio_buffer_t input = {in_ptrs, nullptr, 2, 0, 0b11};
+  clap_audio_buffer_t output = {out_ptrs, nullptr, 2, 0, 0};
+
+  clap_process_t process = {};
+  process.frames_count = frame_count;
+  process.audio_inputs = &input;
+  process.audio_inputs_count = 1;
+  process.audio_outputs = &output;
+  process.audio_outputs_count = 1;
+
+  // Runs the DSP until the constant has outlasted the tail and the output
+  // stopped changing
+  uint64_t processed = 0;
+  while (true) {
+    EXPECT_EQ(plugin_->Process(&process), CLAP_PROCESS_CONTINUE);
+    if (output.constant_mask == 0b11u) break;
+    processed += frame_count;
+    ASSERT_LT(processed, tail_frames + 96000u) << "never settled";
+  }
+  EXPECT_GE(processed, tail_frames);
+
+  const float steady_value = out_left[0];
+  for (uint32_t i = 0; i < frame_count; ++i) {
+    ASSERT_EQ(out_left[i], steady_value);
+    ASSERT_EQ(out_right[i], steady_value);
+  }
+
+  // The full DSP agrees with the shortcut
+  input.constant_mask = 0;
+  EXPECT_EQ(plugin_->Process(&process), CLAP_PROCESS_CONTINUE);
+  EXPECT_EQ(output.constant_mask, 0u);
+  for (uint32_t i = 0; i < frame_count; ++i) {
+    ASSERT_NEAR(out_left[i], steady_value, 1e-6f);
+    ASSERT_NEAR(out_right[i], steady_value, 1e-6f);
+  }
+}
+
+TEST_F(ClapPluginTest, StateWithoutLookaheadLoads) {
+  struct Stream {
+    std::vector<double> values;
+    size_t pos = 0;
+  } data{{0.9, 0.25}};  // Threshold and output level only
+
+  clap_istream_t stream;
+  stream.ctx = &data;
+  stream.read = [](const clap_istream_t* s, void* buffer,
+                   uint64_t size) -> int64_t {
+    auto* d = static_cast<Stream*>(s->ctx);
+    const size_t bytes = std::min<size_t>(
+        size, (d->values.size() - d->pos) * sizeof(double));
+    std::memcpy(buffer, d->values.data() + d->pos, bytes);
+    d->pos += bytes / sizeof(double);
+    return static_cast<int64_t>(bytes);
+  };
+
+  ASSERT_TRUE(plugin_->StateLoad(&stream));
+  double value;
+  ASSERT_TRUE(plugin_->ParamsValue(kParamIdThreshold, &value));
+  EXPECT_NEAR(value, 0.9, 1e-9);
+  ASSERT_TRUE(plugin_->ParamsValue(kParamIdLookahead, &value));
+  EXPECT_NEAR(value, 0.5, 1e-9);
+  ASSERT_TRUE(plugin_->ParamsValue(kParamIdTruePeak, &value));
+  EXPECT_EQ(value, 0.0);
+}
+
+TEST_F(ClapPluginTest, ProcessDoesNotAllocate) {
+  // Everything allowed to allocate happens before the guard
+  ASSERT_TRUE(plugin_->Activate(48000.0, 64, 512));
+  ASSERT_TRUE(plugin_->StartProcessing());
+  const auto* stats = static_cast<const stinky_plugin_process_stats_t*>(
+      plugin_->GetExtension(STINKY_EXT_PROCESS_STATS));
+  ASSERT_NE(stats, nullptr);
+  stats->set_enabled(plugin_->ClapPlugin(), true);
+
+  constexpr uint32_t frame_count = 512;
+  std::vector<float> left(frame_count);
+  std::vector<float> right(frame_count);
+  std::vector<double> left64(frame_count);
+  std::vector<double> right64(frame_count);
+  float* ptrs[] = {left.data(), right.data()};
+  double* ptrs64[] = {left64.data(), right64.data()};
+  clap_audio_buffer_t io = {ptrs, nullptr, 2, 0, 0};
+  clap_audio_buffer_t io64 = {nullptr, ptrs64, 2, 0, 0};
+
+  // The lookahead and true-peak changes only request a restart
+  ParamEventList events;
+  events.Add(0, kParamIdThreshold, 0.9);
+  events.Add(100, kParamIdOutputLevel, 0.95);
+  events.Add(200, kParamIdLookahead, 0.3);
+  events.Add(300, kParamIdTruePeak, 1.0);
+  ParamEventList flush;
+  flush.Add(0, kParamIdThreshold, 0.98);
+
+  clap_process_t process = {};
+  process.frames_count = frame_count;
+  process.audio_inputs_count = 1;
+  process.audio_outputs_count = 1;
+  process.in_events = events.Events();
+
+  // Loud blocks at both sample sizes, then silence until the plugin
+  // sleeps, with a flush and a reset in between
+  constexpr uint32_t kBlocks = 16;
+  clap_process_status statuses[kBlocks];
+  uint64_t allocations;
+  uint64_t frees;
+  {
+    stinky_dsp::AllocationGuard guard;
+    for (uint32_t block = 0; block < kBlocks; ++block) {
+      const float level = block < 6 ? 1.5f : 0.0f;
+      for (uint32_t i = 0; i < frame_count; ++i) {
+        const float t = static_cast<float>(block * frame_count + i);
+        left[i] = level * std::sin(0.05f * t);
+        right[i] = -left[i];
+        left64[i] = left[i];
+        right64[i] = right[i];
+      }
+      clap_audio_buffer_t* buffers = block % 3 == 2 ? &io64 : &io;
+      process.audio_inputs = buffers;
+      process.audio_outputs = buffers;
+      statuses[block] = plugin_->Process(&process);
+
+      if (block == 3) plugin_->ParamsFlush(flush.Events(), nullptr);
+      if (block == 8) plugin_->Reset();
+    }
+    allocations = guard.Allocations();
+    frees = guard.Frees();
+  }
+
+  for (clap_process_status status : statuses) {
+    EXPECT_NE(status, CLAP_PROCESS_ERROR);
+  }
+  EXPECT_EQ(allocations, 0u);
+  EXPECT_EQ(frees, 0u);
+  plugin_->StopProcessing();
+  plugin_->Deactivate();
+}
+
 // Process tests
 class ProcessTest : public ::testing::Test {
  protected:
@@ -261,8 +829,14 @@ TEST_F(ProcessTest, ProcessLowLevelSignalPassesThrough) {
   
   EXPECT_EQ(plugin_->Process(&process_), CLAP_PROCESS_CONTINUE);
   
-  // Should pass through with minimal change
-  for (size_t i = 0; i < kBufferSize; ++i) {
+  // Should pass through with minimal change, delayed by the lookahead
+  const size_t latency = plugin_->LatencyGet();
+  ASSERT_EQ(latency, 220u);  // 5 ms at 44.1 kHz
+  for (size_t i = 0; i < latency; ++i) {
+    EXPECT_FLOAT_EQ(output_left_[i], 0.0f);
+    EXPECT_FLOAT_EQ(output_right_[i], 0.0f);
+  }
+  for (size_t i = latency; i < kBufferSize; ++i) {
     EXPECT_NEAR(output_left_[i], kSignalLevel, 0.01f);
     EXPECT_NEAR(output_right_[i], kSignalLevel, 0.01f);
   }
@@ -286,6 +860,118 @@ TEST_F(ProcessTest, ProcessHighLevelSignalIsLimited) {
   }
 }
 
+TEST_F(ProcessTest, LookaheadCatchesTransients) {
+  // A step from silence straight past the ceiling: the detector sees it a
+  // lookahead early, so not even its first delayed sample gets through
+  constexpr float kSignalLevel = 1.5f;
+  for (size_t i = 100; i < kBufferSize; ++i) {
+    input_left_[i] = kSignalLevel;
+    input_right_[i] = -kSignalLevel;
+  }
+
+  EXPECT_EQ(plugin_->Process(&process_), CLAP_PROCESS_CONTINUE);
+
+  const size_t step = 100 + plugin_->LatencyGet();
+  EXPECT_FLOAT_EQ(output_left_[step - 1], 0.0f);
+  for (size_t i = step; i < kBufferSize; ++i) {
+    EXPECT_LE(std::abs(output_left_[i]), 1.0f) << "frame " << i;
+    EXPECT_LE(std::abs(output_right_[i]), 1.0f) << "frame " << i;
+  }
+  EXPECT_GT(std::abs(output_left_[kBufferSize - 1]), 0.9f);
+}
+
+TEST_F(ProcessTest, IsolatedPeaksNeverExceedTheCeiling) {
+  // Sparse spikes over a quiet tone: each spike must be fully limited when
+  // it leaves the lookahead, however the gain released in between
+  const float ceiling = std::pow(10.0f, -0.1f / 20.0f);
+  std::vector<float> peaks;
+  for (uint32_t block = 0; block < 40; ++block) {
+    for (size_t i = 0; i < kBufferSize; ++i) {
+      const size_t t = block * kBufferSize + i;
+      float sample = 0.3f * std::sin(0.02f * static_cast<float>(t));
+      if (t % 997 == 0 || t % 1409 == 0) {
+        sample = (t % 2 ? -1.0f : 1.0f) * (1.2f + 0.1f * (t % 5));
+      }
+      input_left_[i] = sample;
+      input_right_[i] = (t % 1409 == 0) ? sample : 0.5f * sample;
+    }
+
+    ASSERT_EQ(plugin_->Process(&process_), CLAP_PROCESS_CONTINUE);
+    for (size_t i = 0; i < kBufferSize; ++i) {
+      ASSERT_LE(std::abs(output_left_[i]), ceiling * 1.0001f)
+          << "block " << block << ", frame " << i;
+      ASSERT_LE(std::abs(output_right_[i]), ceiling * 1.0001f)
+          << "block " << block << ", frame " << i;
+      peaks.push_back(std::abs(output_left_[i]));
+    }
+  }
+
+  // The spikes are limited to the ceiling, not crushed below it
+  EXPECT_GT(*std::max_element(peaks.begin(), peaks.end()), ceiling * 0.999f);
+}
+
+TEST_F(ProcessTest, TruePeakModeLimitsInterSamplePeaks) {
+  // A quarter-rate tone sampled 45 degrees off its crests: its 0.85 sample
+  // peaks pass the -0.1 dB ceiling, its 1.2 true peak does not
+  const float ceiling = std::pow(10.0f, -0.1f / 20.0f);
+  auto output_true_peak = [&] {
+    stinky_dsp::TruePeakDetector meter;
+    std::vector<float> level(stinky_dsp::TruePeakDetector::kMaxBlockSize);
+    float peak = 0.0f;
+    for (uint32_t block = 0; block < 8; ++block) {
+      for (size_t i = 0; i < kBufferSize; ++i) {
+        const float t = static_cast<float>(block * kBufferSize + i);
+        input_left_[i] = input_right_[i] =
+            1.2f * std::sin(std::numbers::pi_v<float> / 2.0f * t +
+                            std::numbers::pi_v<float> / 4.0f);
+      }
+      EXPECT_EQ(plugin_->Process(&process_), CLAP_PROCESS_CONTINUE);
+
+      for (size_t offset = 0; offset < kBufferSize; offset += level.size()) {
+        const float* channels[] = {output_left_.data() + offset,
+                                   output_right_.data() + offset};
+        meter.Process(level.data(), channels, 2, level.size());
+        if (block > 0) {
+          peak = std::max(peak, *std::max_element(level.begin(), level.end()));
+        }
+      }
+    }
+    return peak;
+  };
+
+  EXPECT_GT(output_true_peak(), 1.1f);
+
+  plugin_->StopProcessing();
+  plugin_->Deactivate();
+  ParamEventList events;
+  events.Add(0, kParamIdTruePeak, 1.0);
+  plugin_->ParamsFlush(events.Events(), nullptr);
+  ASSERT_TRUE(plugin_->Activate(44100.0, 64, 512));
+  ASSERT_TRUE(plugin_->StartProcessing());
+  EXPECT_EQ(plugin_->LatencyGet(),
+            220u + stinky_dsp::TruePeakDetector::kDelay);
+
+  const float limited = output_true_peak();
+  EXPECT_LE(limited, ceiling * 1.001f);
+  EXPECT_GT(limited, ceiling * 0.98f);
+}
+
+TEST_F(ProcessTest, ResetFlushesTheLookahead) {
+  std::fill(input_left_.begin(), input_left_.end(), 0.8f);
+  std::fill(input_right_.begin(), input_right_.end(), -0.8f);
+  EXPECT_EQ(plugin_->Process(&process_), CLAP_PROCESS_CONTINUE);
+
+  // Nothing still in the lookahead comes out after a reset
+  plugin_->Reset();
+  std::fill(input_left_.begin(), input_left_.end(), 0.0f);
+  std::fill(input_right_.begin(), input_right_.end(), 0.0f);
+  EXPECT_EQ(plugin_->Process(&process_), CLAP_PROCESS_CONTINUE);
+  for (size_t i = 0; i < kBufferSize; ++i) {
+    ASSERT_EQ(output_left_[i], 0.0f) << "frame " << i;
+    ASSERT_EQ(output_right_[i], 0.0f) << "frame " << i;
+  }
+}
+
 TEST_F(ProcessTest, GainReductionIsApplied) {
   // Generate signal that requires limiting
   constexpr float kSignalLevel = 2.0f;  // ~6 dB
@@ -0,0 +1,41 @@
+// Copyright 2025
+// Stinky Render - WAV and raw float audio files
+
+#ifndef AUDIO_FILE_H_
+#define AUDIO_FILE_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace stinky_render {
+
+// Planar float audio
+struct AudioBuffer {
+  double sample_rate = 48000.0;
+  std::vector<std::vector<float>> channels;
+
+  size_t Frames() const { return channels.empty() ? 0 : channels[0].size(); }
+};
+
+// Reads a RIFF/WAVE file: 16/24/32-bit PCM or 32-bit float, including
+// WAVE_FORMAT_EXTENSIBLE. Returns false and sets `error` on failure.
+bool ReadWav(const std::string& path, AudioBuffer* audio, std::string* error);
+
+// Writes 32-bit float WAV
+bool WriteWav(const std::string& path, const AudioBuffer& audio,
+              std::string* error);
+
+// Raw interleaved little-endian 32-bit float. The file carries no header, so
+// the caller supplies the sample rate and channel count.
+bool ReadRaw(const std::string& path, double sample_rate, size_t num_channels,
+             AudioBuffer* audio, std::string* error);
+bool WriteRaw(const std::string& path, const AudioBuffer& audio,
+              std::string* error);
+
+// True for paths ending in .raw or .f32
+bool IsRawPath(const std::string& path);
+
+}  // namespace stinky_render
+
+#endif  // AUDIO_FILE_H_
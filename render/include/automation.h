@@ -0,0 +1,54 @@
+// Copyright 2025
+// Stinky Render - parameter automation files
+
+#ifndef AUTOMATION_H_
+#define AUTOMATION_H_
+
+#include <clap/clap.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace stinky_render {
+
+// One parameter change as written in the automation file. The parameter is
+// addressed by name or id; the position by seconds or by frame.
+struct AutomationEvent {
+  std::string param_name;             // Empty when addressed by id
+  clap_id param_id = CLAP_INVALID_ID;
+  double time_seconds = 0.0;
+  int64_t frame = -1;                 // Takes precedence over time_seconds
+  double value = 0.0;                 // Plain value, as clap.params reports
+};
+
+// A change resolved against a plugin, in render order
+struct ParamEvent {
+  uint64_t frame = 0;
+  clap_id param_id = CLAP_INVALID_ID;
+  double value = 0.0;
+};
+
+// Parses an automation document:
+//
+//   {"events": [{"param": "Threshold", "time": 1.5, "value": 0.25},
+//               {"param": 3, "frame": 48000, "value": 0.8}]}
+//
+// Returns false and sets `error` on malformed input.
+bool ParseAutomation(const std::string& json,
+                     std::vector<AutomationEvent>* events, std::string* error);
+
+bool LoadAutomation(const std::string& path,
+                    std::vector<AutomationEvent>* events, std::string* error);
+
+// Maps names to ids, seconds to frames and sorts by frame (stable, so events
+// at the same frame keep file order). Values are clamped to the parameter
+// range. Fails on unknown parameters.
+bool ResolveAutomation(const std::vector<AutomationEvent>& events,
+                       const std::vector<clap_param_info_t>& params,
+                       double sample_rate, std::vector<ParamEvent>* resolved,
+                       std::string* error);
+
+}  // namespace stinky_render
+
+#endif  // AUTOMATION_H_
@@ -0,0 +1,72 @@
+// Copyright 2025
+// Stinky Render - minimal CLAP host for one plugin instance
+
+#ifndef PLUGIN_HOST_H_
+#define PLUGIN_HOST_H_
+
+#include <clap/clap.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace stinky_render {
+
+// Loads a .clap module through its clap_entry and instantiates one plugin.
+// All calls happen on one thread, which acts as both the main and the audio
+// thread. Not copyable; the module is unloaded on destruction.
+class PluginHost {
+ public:
+  PluginHost();
+  ~PluginHost();
+
+  PluginHost(const PluginHost&) = delete;
+  PluginHost& operator=(const PluginHost&) = delete;
+
+  // Opens `path` and creates the plugin with `plugin_id`, or the module's
+  // first plugin when `plugin_id` is empty. Returns false and sets `error` on
+  // failure.
+  bool Load(const std::string& path, const std::string& plugin_id,
+            std::string* error);
+
+  const clap_plugin_descriptor_t* Descriptor() const;
+
+  // Parameters from clap.params; empty if the plugin has none
+  std::vector<clap_param_info_t> Params() const;
+
+  // Formats `value` with clap.params value_to_text
+  std::string ParamValueText(clap_id param_id, double value) const;
+
+  // Channel count of the main input port (2 if the plugin does not say)
+  uint32_t MainInputChannels() const;
+
+  // activate() + start_processing()
+  bool Start(double sample_rate, uint32_t max_frames);
+
+  // stop_processing() + deactivate(); safe to call when not started
+  void Stop();
+
+  // True once the plugin has called request_restart() since the last Start
+  bool RestartRequested() const { return restart_requested_; }
+
+  // Samples the plugin delays its output by, from clap.latency (0 if the
+  // plugin does not say). Only meaningful after Start.
+  uint32_t Latency() const;
+
+  clap_process_status Process(const clap_process_t* process);
+
+ private:
+  void Unload();
+
+  clap_host_t host_;
+  void* library_;
+  const clap_plugin_entry_t* entry_;
+  const clap_plugin_t* plugin_;
+  bool active_;
+  bool processing_;
+  bool restart_requested_;
+};
+
+}  // namespace stinky_render
+
+#endif  // PLUGIN_HOST_H_
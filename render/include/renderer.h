@@ -0,0 +1,55 @@
+// Copyright 2025
+// Stinky Render - offline block renderer with timing
+
+#ifndef RENDERER_H_
+#define RENDERER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "audio_file.h"
+#include "automation.h"
+#include "plugin_host.h"
+
+namespace stinky_render {
+
+struct RenderOptions {
+  uint32_t block_size = 512;   // Frames per process() call (last may be less)
+  double tail_seconds = 0.0;   // Silence rendered after the input
+};
+
+// Wall-clock cost of each process() call
+struct RenderStats {
+  double sample_rate = 0.0;
+  uint64_t frames = 0;        // Processed, including the latency flush
+  uint32_t block_size = 0;
+  uint32_t latency = 0;       // Plugin latency at the end, in frames
+  uint32_t restarts = 0;      // Reactivations the plugin asked for
+  std::vector<double> block_ns;
+
+  double AudioSeconds() const;
+  double ProcessSeconds() const;
+
+  // Seconds of audio rendered per second of processing
+  double RealtimeFactor() const;
+
+  // Nearest-rank percentile of block_ns, `percent` in [0, 100]
+  double BlockPercentileNs(double percent) const;
+};
+
+// Streams `input` through the plugin in blocks of options.block_size,
+// delivering `automation` events at their frames, and writes the main output
+// to `output`. Activates the plugin for the render and deactivates it after,
+// and reactivates it between blocks when it requests a restart. The output
+// is compensated for the plugin's latency (clap.latency): it lines up with
+// the input sample for sample and has the same length.
+bool Render(PluginHost* host, const AudioBuffer& input,
+            const std::vector<ParamEvent>& automation,
+            const RenderOptions& options, AudioBuffer* output,
+            RenderStats* stats, std::string* error);
+
+}  // namespace stinky_render
+
+#endif  // RENDERER_H_
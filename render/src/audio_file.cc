@@ -0,0 +1,246 @@
+// Copyright 2025
+// Stinky Render - WAV and raw float audio files
+
+#include "audio_file.h"
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace stinky_render {
+
+namespace {
+
+constexpr uint16_t kFormatPcm = 1;
+constexpr uint16_t kFormatFloat = 3;
+constexpr uint16_t kFormatExtensible = 0xFFFE;
+
+static_assert(std::endian::native == std::endian::little,
+              "WAV and raw files are read and written as little-endian");
+
+uint16_t ReadU16(const uint8_t* data) {
+  return static_cast<uint16_t>(data[0] | (data[1] << 8));
+}
+
+uint32_t ReadU32(const uint8_t* data) {
+  return static_cast<uint32_t>(data[0]) |
+         (static_cast<uint32_t>(data[1]) << 8) |
+         (static_cast<uint32_t>(data[2]) << 16) |
+         (static_cast<uint32_t>(data[3]) << 24);
+}
+
+void AppendU16(std::vector<uint8_t>& out, uint16_t value) {
+  out.push_back(static_cast<uint8_t>(value));
+  out.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+void AppendU32(std::vector<uint8_t>& out, uint32_t value) {
+  for (int shift = 0; shift < 32; shift += 8) {
+    out.push_back(static_cast<uint8_t>(value >> shift));
+  }
+}
+
+void AppendTag(std::vector<uint8_t>& out, const char* tag) {
+  out.insert(out.end(), tag, tag + 4);
+}
+
+bool ReadFile(const std::string& path, std::vector<uint8_t>* data,
+              std::string* error) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    *error = "cannot open " + path;
+    return false;
+  }
+  data->assign(std::istreambuf_iterator<char>(file),
+               std::istreambuf_iterator<char>());
+  return true;
+}
+
+bool WriteFile(const std::string& path, const std::vector<uint8_t>& data,
+               std::string* error) {
+  std::ofstream file(path, std::ios::binary);
+  file.write(reinterpret_cast<const char*>(data.data()),
+             static_cast<std::streamsize>(data.size()));
+  if (!file) {
+    *error = "cannot write " + path;
+    return false;
+  }
+  return true;
+}
+
+// Decodes one sample of `bits` width starting at `data`
+float DecodeSample(const uint8_t* data, uint16_t format, uint16_t bits) {
+  if (format == kFormatFloat) {
+    float value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+  }
+  switch (bits) {
+    case 16:
+      return static_cast<int16_t>(ReadU16(data)) / 32768.0f;
+    case 24: {
+      // Sign-extend through the top byte of a 32-bit word
+      const int32_t value = static_cast<int32_t>(
+          (static_cast<uint32_t>(data[0]) << 8) |
+          (static_cast<uint32_t>(data[1]) << 16) |
+          (static_cast<uint32_t>(data[2]) << 24));
+      return static_cast<float>(value >> 8) / 8388608.0f;
+    }
+    default:
+      return static_cast<float>(static_cast<int32_t>(ReadU32(data)) /
+                                2147483648.0);
+  }
+}
+
+}  // namespace
+
+bool ReadWav(const std::string& path, AudioBuffer* audio, std::string* error) {
+  std::vector<uint8_t> data;
+  if (!ReadFile(path, &data, error)) return false;
+
+  if (data.size() < 12 || std::memcmp(data.data(), "RIFF", 4) != 0 ||
+      std::memcmp(data.data() + 8, "WAVE", 4) != 0) {
+    *error = path + " is not a RIFF/WAVE file";
+    return false;
+  }
+
+  uint16_t format = 0;
+  uint16_t num_channels = 0;
+  uint32_t sample_rate = 0;
+  uint16_t bits = 0;
+  const uint8_t* samples = nullptr;
+  size_t samples_size = 0;
+
+  // Walk the chunks; chunk bodies are padded to an even size
+  size_t pos = 12;
+  while (pos + 8 <= data.size()) {
+    const uint8_t* chunk = data.data() + pos;
+    const size_t size = std::min<size_t>(ReadU32(chunk + 4),
+                                         data.size() - pos - 8);
+    if (std::memcmp(chunk, "fmt ", 4) == 0 && size >= 16) {
+      format = ReadU16(chunk + 8);
+      num_channels = ReadU16(chunk + 10);
+      sample_rate = ReadU32(chunk + 12);
+      bits = ReadU16(chunk + 22);
+      // The sub-format GUID starts with the real format tag
+      if (format == kFormatExtensible && size >= 40) {
+        format = ReadU16(chunk + 32);
+      }
+    } else if (std::memcmp(chunk, "data", 4) == 0) {
+      samples = chunk + 8;
+      samples_size = size;
+    }
+    pos += 8 + size + (size & 1);
+  }
+
+  if (num_channels == 0 || sample_rate == 0 || samples == nullptr) {
+    *error = path + " has no fmt or data chunk";
+    return false;
+  }
+  const bool supported =
+      (format == kFormatPcm && (bits == 16 || bits == 24 || bits == 32)) ||
+      (format == kFormatFloat && bits == 32);
+  if (!supported) {
+    *error = path + ": unsupported sample format (16/24/32-bit PCM or " +
+             "32-bit float only)";
+    return false;
+  }
+
+  const size_t bytes_per_sample = bits / 8;
+  const size_t bytes_per_frame = bytes_per_sample * num_channels;
+  const size_t frames = samples_size / bytes_per_frame;
+
+  audio->sample_rate = sample_rate;
+  audio->channels.assign(num_channels, std::vector<float>(frames));
+  for (size_t frame = 0; frame < frames; ++frame) {
+    const uint8_t* frame_data = samples + frame * bytes_per_frame;
+    for (size_t ch = 0; ch < num_channels; ++ch) {
+      audio->channels[ch][frame] =
+          DecodeSample(frame_data + ch * bytes_per_sample, format, bits);
+    }
+  }
+  return true;
+}
+
+bool WriteWav(const std::string& path, const AudioBuffer& audio,
+              std::string* error) {
+  const uint16_t num_channels = static_cast<uint16_t>(audio.channels.size());
+  const uint32_t sample_rate = static_cast<uint32_t>(audio.sample_rate);
+  const uint32_t data_size = static_cast<uint32_t>(
+      audio.Frames() * num_channels * sizeof(float));
+
+  std::vector<uint8_t> out;
+  out.reserve(44 + data_size);
+  AppendTag(out, "RIFF");
+  AppendU32(out, 36 + data_size);
+  AppendTag(out, "WAVE");
+
+  AppendTag(out, "fmt ");
+  AppendU32(out, 16);
+  AppendU16(out, kFormatFloat);
+  AppendU16(out, num_channels);
+  AppendU32(out, sample_rate);
+  AppendU32(out, sample_rate * num_channels * sizeof(float));
+  AppendU16(out, static_cast<uint16_t>(num_channels * sizeof(float)));
+  AppendU16(out, 32);
+
+  AppendTag(out, "data");
+  AppendU32(out, data_size);
+  for (size_t frame = 0; frame < audio.Frames(); ++frame) {
+    for (const std::vector<float>& channel : audio.channels) {
+      AppendU32(out, std::bit_cast<uint32_t>(channel[frame]));
+    }
+  }
+  return WriteFile(path, out, error);
+}
+
+bool ReadRaw(const std::string& path, double sample_rate, size_t num_channels,
+             AudioBuffer* audio, std::string* error) {
+  if (num_channels == 0) {
+    *error = "raw input needs at least one channel";
+    return false;
+  }
+
+  std::vector<uint8_t> data;
+  if (!ReadFile(path, &data, error)) return false;
+
+  const size_t frames = data.size() / (num_channels * sizeof(float));
+  audio->sample_rate = sample_rate;
+  audio->channels.assign(num_channels, std::vector<float>(frames));
+  for (size_t frame = 0; frame < frames; ++frame) {
+    for (size_t ch = 0; ch < num_channels; ++ch) {
+      std::memcpy(&audio->channels[ch][frame],
+                  data.data() + (frame * num_channels + ch) * sizeof(float),
+                  sizeof(float));
+    }
+  }
+  return true;
+}
+
+bool WriteRaw(const std::string& path, const AudioBuffer& audio,
+              std::string* error) {
+  std::vector<uint8_t> out;
+  out.reserve(audio.Frames() * audio.channels.size() * sizeof(float));
+  for (size_t frame = 0; frame < audio.Frames(); ++frame) {
+    for (const std::vector<float>& channel : audio.channels) {
+      AppendU32(out, std::bit_cast<uint32_t>(channel[frame]));
+    }
+  }
+  return WriteFile(path, out, error);
+}
+
+bool IsRawPath(const std::string& path) {
+  const size_t dot = path.find_last_of('.');
+  if (dot == std::string::npos) return false;
+
+  std::string extension = path.substr(dot + 1);
+  std::transform(extension.begin(), extension.end(), extension.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return extension == "raw" || extension == "f32";
+}
+
+}  // namespace stinky_render
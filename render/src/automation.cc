@@ -0,0 +1,332 @@
+// Copyright 2025
+// Stinky Render - parameter automation files
+
+#include "automation.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace stinky_render {
+
+namespace {
+
+// Just enough JSON for automation files: objects, arrays, strings (no
+// \u escapes), numbers, true/false/null
+struct JsonValue {
+  enum class Type { kNull, kBool, kNumber, kString, kArray, kObject };
+
+  Type type = Type::kNull;
+  bool boolean = false;
+  double number = 0.0;
+  std::string string;
+  std::vector<JsonValue> items;  // Array elements or object members
+  std::vector<std::string> keys;  // Object member names, parallel to items
+
+  const JsonValue* Find(const std::string& key) const {
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (keys[i] == key) return &items[i];
+    }
+    return nullptr;
+  }
+};
+
+class JsonParser {
+ public:
+  explicit JsonParser(const std::string& text) : text_(text), pos_(0) {}
+
+  bool Parse(JsonValue* value, std::string* error) {
+    if (!ParseValue(value, 0)) {
+      *error = error_;
+      return false;
+    }
+    SkipWhitespace();
+    if (pos_ != text_.size()) {
+      *error = Fail("trailing characters");
+      return false;
+    }
+    return true;
+  }
+
+ private:
+  static constexpr int kMaxDepth = 64;
+
+  std::string Fail(const std::string& what) {
+    error_ = "JSON error at offset " + std::to_string(pos_) + ": " + what;
+    return error_;
+  }
+
+  void SkipWhitespace() {
+    while (pos_ < text_.size() &&
+           std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+      ++pos_;
+    }
+  }
+
+  bool Consume(char c) {
+    SkipWhitespace();
+    if (pos_ < text_.size() && text_[pos_] == c) {
+      ++pos_;
+      return true;
+    }
+    return false;
+  }
+
+  bool ConsumeWord(const char* word) {
+    const size_t length = std::char_traits<char>::length(word);
+    if (text_.compare(pos_, length, word) != 0) return false;
+    pos_ += length;
+    return true;
+  }
+
+  bool ParseValue(JsonValue* value, int depth) {
+    if (depth > kMaxDepth) {
+      Fail("nesting too deep");
+      return false;
+    }
+    SkipWhitespace();
+    if (pos_ >= text_.size()) {
+      Fail("unexpected end of input");
+      return false;
+    }
+
+    const char c = text_[pos_];
+    if (c == '{') return ParseObject(value, depth);
+    if (c == '[') return ParseArray(value, depth);
+    if (c == '"') {
+      value->type = JsonValue::Type::kString;
+      return ParseString(&value->string);
+    }
+    if (ConsumeWord("true")) {
+      value->type = JsonValue::Type::kBool;
+      value->boolean = true;
+      return true;
+    }
+    if (ConsumeWord("false")) {
+      value->type = JsonValue::Type::kBool;
+      return true;
+    }
+    if (ConsumeWord("null")) {
+      value->type = JsonValue::Type::kNull;
+      return true;
+    }
+    return ParseNumber(value);
+  }
+
+  bool ParseObject(JsonValue* value, int depth) {
+    value->type = JsonValue::Type::kObject;
+    ++pos_;  // '{'
+    if (Consume('}')) return true;
+
+    do {
+      SkipWhitespace();
+      std::string key;
+      if (pos_ >= text_.size() || text_[pos_] != '"' || !ParseString(&key)) {
+        if (error_.empty()) Fail("expected member name");
+        return false;
+      }
+      if (!Consume(':')) {
+        Fail("expected ':'");
+        return false;
+      }
+      JsonValue member;
+      if (!ParseValue(&member, depth + 1)) return false;
+      value->keys.push_back(std::move(key));
+      value->items.push_back(std::move(member));
+    } while (Consume(','));
+
+    if (!Consume('}')) {
+      Fail("expected ',' or '}'");
+      return false;
+    }
+    return true;
+  }
+
+  bool ParseArray(JsonValue* value, int depth) {
+    value->type = JsonValue::Type::kArray;
+    ++pos_;  // '['
+    if (Consume(']')) return true;
+
+    do {
+      JsonValue item;
+      if (!ParseValue(&item, depth + 1)) return false;
+      value->items.push_back(std::move(item));
+    } while (Consume(','));
+
+    if (!Consume(']')) {
+      Fail("expected ',' or ']'");
+      return false;
+    }
+    return true;
+  }
+
+  bool ParseString(std::string* out) {
+    ++pos_;  // Opening quote
+    while (pos_ < text_.size()) {
+      const char c = text_[pos_++];
+      if (c == '"') return true;
+      if (c != '\\') {
+        out->push_back(c);
+        continue;
+      }
+      if (pos_ >= text_.size()) break;
+      switch (text_[pos_++]) {
+        case '"': out->push_back('"'); break;
+        case '\\': out->push_back('\\'); break;
+        case '/': out->push_back('/'); break;
+        case 'b': out->push_back('\b'); break;
+        case 'f': out->push_back('\f'); break;
+        case 'n': out->push_back('\n'); break;
+        case 'r': out->push_back('\r'); break;
+        case 't': out->push_back('\t'); break;
+        default:
+          Fail("unsupported escape sequence");
+          return false;
+      }
+    }
+    Fail("unterminated string");
+    return false;
+  }
+
+  bool ParseNumber(JsonValue* value) {
+    const char* begin = text_.c_str() + pos_;
+    char* end = nullptr;
+    const double number = std::strtod(begin, &end);
+    if (end == begin) {
+      Fail("unexpected character");
+      return false;
+    }
+    pos_ += static_cast<size_t>(end - begin);
+    value->type = JsonValue::Type::kNumber;
+    value->number = number;
+    return true;
+  }
+
+  const std::string& text_;
+  size_t pos_;
+  std::string error_;
+};
+
+bool FailEvent(size_t index, const std::string& what, std::string* error) {
+  *error = "automation event " + std::to_string(index) + ": " + what;
+  return false;
+}
+
+}  // namespace
+
+bool ParseAutomation(const std::string& json,
+                     std::vector<AutomationEvent>* events,
+                     std::string* error) {
+  JsonValue root;
+  JsonParser parser(json);
+  if (!parser.Parse(&root, error)) return false;
+
+  const JsonValue* list = root.Find("events");
+  if (root.type != JsonValue::Type::kObject || list == nullptr ||
+      list->type != JsonValue::Type::kArray) {
+    *error = "automation must be an object with an \"events\" array";
+    return false;
+  }
+
+  events->clear();
+  for (size_t i = 0; i < list->items.size(); ++i) {
+    const JsonValue& item = list->items[i];
+    if (item.type != JsonValue::Type::kObject) {
+      return FailEvent(i, "not an object", error);
+    }
+
+    AutomationEvent event;
+    const JsonValue* param = item.Find("param");
+    if (param != nullptr && param->type == JsonValue::Type::kString) {
+      event.param_name = param->string;
+    } else if (param != nullptr && param->type == JsonValue::Type::kNumber &&
+               param->number >= 0.0) {
+      event.param_id = static_cast<clap_id>(param->number);
+    } else {
+      return FailEvent(i, "\"param\" must be a name or an id", error);
+    }
+
+    const JsonValue* frame = item.Find("frame");
+    const JsonValue* time = item.Find("time");
+    if (frame != nullptr && frame->type == JsonValue::Type::kNumber &&
+        frame->number >= 0.0) {
+      event.frame = static_cast<int64_t>(frame->number);
+    } else if (time != nullptr && time->type == JsonValue::Type::kNumber &&
+               time->number >= 0.0) {
+      event.time_seconds = time->number;
+    } else {
+      return FailEvent(i, "needs a non-negative \"frame\" or \"time\"", error);
+    }
+
+    const JsonValue* value = item.Find("value");
+    if (value == nullptr || value->type != JsonValue::Type::kNumber) {
+      return FailEvent(i, "\"value\" must be a number", error);
+    }
+    event.value = value->number;
+
+    events->push_back(std::move(event));
+  }
+  return true;
+}
+
+bool LoadAutomation(const std::string& path,
+                    std::vector<AutomationEvent>* events, std::string* error) {
+  std::ifstream file(path);
+  if (!file) {
+    *error = "cannot open " + path;
+    return false;
+  }
+  std::stringstream contents;
+  contents << file.rdbuf();
+  if (!ParseAutomation(contents.str(), events, error)) {
+    *error = path + ": " + *error;
+    return false;
+  }
+  return true;
+}
+
+bool ResolveAutomation(const std::vector<AutomationEvent>& events,
+                       const std::vector<clap_param_info_t>& params,
+                       double sample_rate, std::vector<ParamEvent>* resolved,
+                       std::string* error) {
+  resolved->clear();
+  for (size_t i = 0; i < events.size(); ++i) {
+    const AutomationEvent& event = events[i];
+
+    const auto match = std::find_if(
+        params.begin(), params.end(), [&](const clap_param_info_t& info) {
+          return event.param_name.empty() ? info.id == event.param_id
+                                          : event.param_name == info.name;
+        });
+    if (match == params.end()) {
+      return FailEvent(i, "unknown parameter " +
+                              (event.param_name.empty()
+                                   ? std::to_string(event.param_id)
+                                   : "\"" + event.param_name + "\""),
+                       error);
+    }
+
+    ParamEvent param_event;
+    param_event.frame =
+        event.frame >= 0
+            ? static_cast<uint64_t>(event.frame)
+            : static_cast<uint64_t>(std::llround(event.time_seconds *
+                                                 sample_rate));
+    param_event.param_id = match->id;
+    param_event.value =
+        std::clamp(event.value, match->min_value, match->max_value);
+    resolved->push_back(param_event);
+  }
+
+  std::stable_sort(resolved->begin(), resolved->end(),
+                   [](const ParamEvent& a, const ParamEvent& b) {
+                     return a.frame < b.frame;
+                   });
+  return true;
+}
+
+}  // namespace stinky_render
@@ -0,0 +1,217 @@
+// Copyright 2025
+// stinky-render: streams an audio file through a CLAP plugin offline and
+// reports how fast the plugin ran
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "audio_file.h"
+#include "automation.h"
+#include "plugin_host.h"
+#include "renderer.h"
+
+namespace stinky_render {
+namespace {
+
+constexpr const char* kUsage =
+    "usage: stinky-render <plugin.clap> <input.wav|.raw> [output.wav|.raw]\n"
+    "                     [options]\n"
+    "\n"
+    "  --plugin-id <id>      plugin to create (default: first in the module)\n"
+    "  --block-size <n>      frames per process() call (default: 512)\n"
+    "  --automation <file>   JSON parameter automation\n"
+    "  --tail <seconds>      silence rendered after the input (default: 0)\n"
+    "  --sample-rate <hz>    sample rate of raw input (default: 48000)\n"
+    "  --channels <n>        channel count of raw input (default: 2)\n"
+    "  --list-params         print the plugin's parameters and exit\n"
+    "  --json                print the timing report as JSON\n"
+    "\n"
+    "Without an output path the render is timed and discarded.\n";
+
+struct Options {
+  std::string plugin_path;
+  std::string input_path;
+  std::string output_path;
+  std::string plugin_id;
+  std::string automation_path;
+  RenderOptions render;
+  double raw_sample_rate = 48000.0;
+  size_t raw_channels = 2;
+  bool list_params = false;
+  bool json = false;
+};
+
+bool ParseArgs(int argc, char** argv, Options* options, std::string* error) {
+  std::vector<std::string> positional;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const auto next = [&]() -> const char* {
+      return i + 1 < argc ? argv[++i] : nullptr;
+    };
+
+    if (arg == "--list-params") {
+      options->list_params = true;
+    } else if (arg == "--json") {
+      options->json = true;
+    } else if (arg.rfind("--", 0) == 0) {
+      const char* value = next();
+      if (value == nullptr) {
+        *error = arg + " needs a value";
+        return false;
+      }
+      if (arg == "--plugin-id") {
+        options->plugin_id = value;
+      } else if (arg == "--block-size") {
+        options->render.block_size =
+            static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+      } else if (arg == "--automation") {
+        options->automation_path = value;
+      } else if (arg == "--tail") {
+        options->render.tail_seconds = std::strtod(value, nullptr);
+      } else if (arg == "--sample-rate") {
+        options->raw_sample_rate = std::strtod(value, nullptr);
+      } else if (arg == "--channels") {
+        options->raw_channels = std::strtoul(value, nullptr, 10);
+      } else {
+        *error = "unknown option " + arg;
+        return false;
+      }
+    } else {
+      positional.push_back(arg);
+    }
+  }
+
+  const size_t required = options->list_params ? 1 : 2;
+  if (positional.size() < required || positional.size() > 3) {
+    *error = "expected a plugin path and an input path";
+    return false;
+  }
+  options->plugin_path = positional[0];
+  if (positional.size() > 1) options->input_path = positional[1];
+  if (positional.size() > 2) options->output_path = positional[2];
+  return true;
+}
+
+void PrintParams(const PluginHost& host) {
+  for (const clap_param_info_t& info : host.Params()) {
+    std::printf("%4u  %-24s  [%g, %g]  default %g (%s)\n", info.id, info.name,
+                info.min_value, info.max_value, info.default_value,
+                host.ParamValueText(info.id, info.default_value).c_str());
+  }
+}
+
+void PrintReport(const PluginHost& host, const RenderStats& stats) {
+  const double block_budget_us =
+      stats.block_size / stats.sample_rate * 1e6;
+  std::printf("plugin:          %s\n", host.Descriptor()->id);
+  std::printf("rendered:        %.3f s (%llu frames at %.0f Hz)\n",
+              stats.AudioSeconds(),
+              static_cast<unsigned long long>(stats.frames),
+              stats.sample_rate);
+  std::printf("blocks:          %zu x %u frames (%.1f us budget)\n",
+              stats.block_ns.size(), stats.block_size, block_budget_us);
+  std::printf("latency:         %u frames (compensated), %u restarts\n",
+              stats.latency, stats.restarts);
+  std::printf("process time:    %.3f ms\n", stats.ProcessSeconds() * 1e3);
+  std::printf("realtime factor: %.1fx\n", stats.RealtimeFactor());
+  std::printf("block time (us): p50 %.2f  p90 %.2f  p99 %.2f  p99.9 %.2f  "
+              "max %.2f\n",
+              stats.BlockPercentileNs(50.0) * 1e-3,
+              stats.BlockPercentileNs(90.0) * 1e-3,
+              stats.BlockPercentileNs(99.0) * 1e-3,
+              stats.BlockPercentileNs(99.9) * 1e-3,
+              stats.BlockPercentileNs(100.0) * 1e-3);
+}
+
+void PrintJsonReport(const PluginHost& host, const RenderStats& stats) {
+  std::printf("{\n");
+  std::printf("  \"plugin\": \"%s\",\n", host.Descriptor()->id);
+  std::printf("  \"sample_rate\": %.0f,\n", stats.sample_rate);
+  std::printf("  \"frames\": %llu,\n",
+              static_cast<unsigned long long>(stats.frames));
+  std::printf("  \"block_size\": %u,\n", stats.block_size);
+  std::printf("  \"blocks\": %zu,\n", stats.block_ns.size());
+  std::printf("  \"latency\": %u,\n", stats.latency);
+  std::printf("  \"restarts\": %u,\n", stats.restarts);
+  std::printf("  \"audio_seconds\": %.6f,\n", stats.AudioSeconds());
+  std::printf("  \"process_seconds\": %.6f,\n", stats.ProcessSeconds());
+  std::printf("  \"realtime_factor\": %.3f,\n", stats.RealtimeFactor());
+  std::printf("  \"block_ns\": {\"p50\": %.0f, \"p90\": %.0f, \"p99\": %.0f, "
+              "\"p99_9\": %.0f, \"max\": %.0f}\n",
+              stats.BlockPercentileNs(50.0), stats.BlockPercentileNs(90.0),
+              stats.BlockPercentileNs(99.0), stats.BlockPercentileNs(99.9),
+              stats.BlockPercentileNs(100.0));
+  std::printf("}\n");
+}
+
+int Run(int argc, char** argv) {
+  Options options;
+  std::string error;
+  if (!ParseArgs(argc, argv, &options, &error)) {
+    std::fprintf(stderr, "stinky-render: %s\n\n%s", error.c_str(), kUsage);
+    return 2;
+  }
+
+  PluginHost host;
+  if (!host.Load(options.plugin_path, options.plugin_id, &error)) {
+    std::fprintf(stderr, "stinky-render: %s\n", error.c_str());
+    return 1;
+  }
+  if (options.list_params) {
+    PrintParams(host);
+    return 0;
+  }
+
+  AudioBuffer input;
+  const bool read = IsRawPath(options.input_path)
+                        ? ReadRaw(options.input_path, options.raw_sample_rate,
+                                  options.raw_channels, &input, &error)
+                        : ReadWav(options.input_path, &input, &error);
+  if (!read) {
+    std::fprintf(stderr, "stinky-render: %s\n", error.c_str());
+    return 1;
+  }
+
+  std::vector<ParamEvent> automation;
+  if (!options.automation_path.empty()) {
+    std::vector<AutomationEvent> events;
+    if (!LoadAutomation(options.automation_path, &events, &error) ||
+        !ResolveAutomation(events, host.Params(), input.sample_rate,
+                           &automation, &error)) {
+      std::fprintf(stderr, "stinky-render: %s\n", error.c_str());
+      return 1;
+    }
+  }
+
+  AudioBuffer output;
+  RenderStats stats;
+  if (!Render(&host, input, automation, options.render, &output, &stats,
+              &error)) {
+    std::fprintf(stderr, "stinky-render: %s\n", error.c_str());
+    return 1;
+  }
+
+  if (!options.output_path.empty()) {
+    const bool written = IsRawPath(options.output_path)
+                             ? WriteRaw(options.output_path, output, &error)
+                             : WriteWav(options.output_path, output, &error);
+    if (!written) {
+      std::fprintf(stderr, "stinky-render: %s\n", error.c_str());
+      return 1;
+    }
+  }
+
+  if (options.json) {
+    PrintJsonReport(host, stats);
+  } else {
+    PrintReport(host, stats);
+  }
+  return 0;
+}
+
+}  // namespace
+}  // namespace stinky_render
+
+int main(int argc, char** argv) { return stinky_render::Run(argc, argv); }
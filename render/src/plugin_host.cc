@@ -0,0 +1,223 @@
+// Copyright 2025
+// Stinky Render - minimal CLAP host for one plugin instance
+
+#include "plugin_host.h"
+
+#include <cstring>
+#include <filesystem>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+namespace stinky_render {
+
+namespace {
+
+void* OpenLibrary(const std::string& path, std::string* error) {
+#if defined(_WIN32)
+  HMODULE library = LoadLibraryA(path.c_str());
+  if (library == nullptr) *error = "cannot load " + path;
+  return reinterpret_cast<void*>(library);
+#else
+  void* library = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+  if (library == nullptr) *error = dlerror();
+  return library;
+#endif
+}
+
+void* FindSymbol(void* library, const char* name) {
+#if defined(_WIN32)
+  return reinterpret_cast<void*>(
+      GetProcAddress(reinterpret_cast<HMODULE>(library), name));
+#else
+  return dlsym(library, name);
+#endif
+}
+
+void CloseLibrary(void* library) {
+#if defined(_WIN32)
+  FreeLibrary(reinterpret_cast<HMODULE>(library));
+#else
+  dlclose(library);
+#endif
+}
+
+// macOS modules are bundles; the binary sits in Contents/MacOS
+std::string ModuleBinaryPath(const std::string& path) {
+  const std::filesystem::path module(path);
+  if (!std::filesystem::is_directory(module)) return path;
+  return (module / "Contents" / "MacOS" / module.stem()).string();
+}
+
+}  // namespace
+
+PluginHost::PluginHost()
+    : library_(nullptr),
+      entry_(nullptr),
+      plugin_(nullptr),
+      active_(false),
+      processing_(false),
+      restart_requested_(false) {
+  host_.clap_version = CLAP_VERSION;
+  host_.host_data = this;
+  host_.name = "stinky-render";
+  host_.vendor = "Stinky";
+  host_.url = "";
+  host_.version = "1.0.0";
+  host_.get_extension = [](const clap_host_t*, const char*) -> const void* {
+    return nullptr;
+  };
+  // The renderer reactivates the plugin between blocks
+  host_.request_restart = [](const clap_host_t* host) {
+    static_cast<PluginHost*>(host->host_data)->restart_requested_ = true;
+  };
+  // Offline rendering processes continuously; nothing to schedule
+  host_.request_process = [](const clap_host_t*) {};
+  host_.request_callback = [](const clap_host_t*) {};
+}
+
+PluginHost::~PluginHost() { Unload(); }
+
+bool PluginHost::Load(const std::string& path, const std::string& plugin_id,
+                      std::string* error) {
+  Unload();
+
+  const std::string binary = ModuleBinaryPath(path);
+  library_ = OpenLibrary(binary, error);
+  if (library_ == nullptr) return false;
+
+  entry_ = static_cast<const clap_plugin_entry_t*>(
+      FindSymbol(library_, "clap_entry"));
+  if (entry_ == nullptr) {
+    *error = path + " does not export clap_entry";
+    Unload();
+    return false;
+  }
+  if (!entry_->init(path.c_str())) {
+    *error = "clap_entry.init failed for " + path;
+    entry_ = nullptr;
+    Unload();
+    return false;
+  }
+
+  const auto* factory = static_cast<const clap_plugin_factory_t*>(
+      entry_->get_factory(CLAP_PLUGIN_FACTORY_ID));
+  if (factory == nullptr || factory->get_plugin_count(factory) == 0) {
+    *error = path + " has no plugins";
+    Unload();
+    return false;
+  }
+
+  std::string id = plugin_id;
+  if (id.empty()) {
+    id = factory->get_plugin_descriptor(factory, 0)->id;
+  }
+  plugin_ = factory->create_plugin(factory, &host_, id.c_str());
+  if (plugin_ == nullptr) {
+    *error = path + " has no plugin \"" + id + "\"";
+    Unload();
+    return false;
+  }
+  if (!plugin_->init(plugin_)) {
+    *error = "init failed for " + id;
+    Unload();
+    return false;
+  }
+  return true;
+}
+
+const clap_plugin_descriptor_t* PluginHost::Descriptor() const {
+  return plugin_ != nullptr ? plugin_->desc : nullptr;
+}
+
+std::vector<clap_param_info_t> PluginHost::Params() const {
+  std::vector<clap_param_info_t> params;
+  const auto* extension = static_cast<const clap_plugin_params_t*>(
+      plugin_->get_extension(plugin_, CLAP_EXT_PARAMS));
+  if (extension == nullptr) return params;
+
+  const uint32_t count = extension->count(plugin_);
+  for (uint32_t i = 0; i < count; ++i) {
+    clap_param_info_t info;
+    std::memset(&info, 0, sizeof(info));
+    if (extension->get_info(plugin_, i, &info)) {
+      params.push_back(info);
+    }
+  }
+  return params;
+}
+
+std::string PluginHost::ParamValueText(clap_id param_id, double value) const {
+  const auto* extension = static_cast<const clap_plugin_params_t*>(
+      plugin_->get_extension(plugin_, CLAP_EXT_PARAMS));
+  char text[CLAP_NAME_SIZE] = {};
+  if (extension == nullptr ||
+      !extension->value_to_text(plugin_, param_id, value, text,
+                                sizeof(text))) {
+    return std::to_string(value);
+  }
+  return text;
+}
+
+uint32_t PluginHost::MainInputChannels() const {
+  const auto* extension = static_cast<const clap_plugin_audio_ports_t*>(
+      plugin_->get_extension(plugin_, CLAP_EXT_AUDIO_PORTS));
+  clap_audio_port_info_t info;
+  if (extension == nullptr || extension->count(plugin_, true) == 0 ||
+      !extension->get(plugin_, 0, true, &info)) {
+    return 2;
+  }
+  return info.channel_count;
+}
+
+uint32_t PluginHost::Latency() const {
+  const auto* extension = static_cast<const clap_plugin_latency_t*>(
+      plugin_->get_extension(plugin_, CLAP_EXT_LATENCY));
+  return extension != nullptr ? extension->get(plugin_) : 0;
+}
+
+bool PluginHost::Start(double sample_rate, uint32_t max_frames) {
+  restart_requested_ = false;
+  if (!plugin_->activate(plugin_, sample_rate, 1, max_frames)) return false;
+  active_ = true;
+
+  if (!plugin_->start_processing(plugin_)) return false;
+  processing_ = true;
+  return true;
+}
+
+void PluginHost::Stop() {
+  if (processing_) {
+    plugin_->stop_processing(plugin_);
+    processing_ = false;
+  }
+  if (active_) {
+    plugin_->deactivate(plugin_);
+    active_ = false;
+  }
+}
+
+clap_process_status PluginHost::Process(const clap_process_t* process) {
+  return plugin_->process(plugin_, process);
+}
+
+void PluginHost::Unload() {
+  if (plugin_ != nullptr) {
+    Stop();
+    plugin_->destroy(plugin_);
+    plugin_ = nullptr;
+  }
+  if (entry_ != nullptr) {
+    entry_->deinit();
+    entry_ = nullptr;
+  }
+  if (library_ != nullptr) {
+    CloseLibrary(library_);
+    library_ = nullptr;
+  }
+}
+
+}  // namespace stinky_render
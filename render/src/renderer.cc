@@ -0,0 +1,230 @@
+// Copyright 2025
+// Stinky Render - offline block renderer with timing
+
+#include "renderer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+
+namespace stinky_render {
+
+namespace {
+
+// Parameter events of one block, exposed as clap_input_events_t
+class BlockEvents {
+ public:
+  BlockEvents() {
+    input_.ctx = this;
+    input_.size = [](const clap_input_events_t* list) -> uint32_t {
+      auto* self = static_cast<const BlockEvents*>(list->ctx);
+      return static_cast<uint32_t>(self->events_.size());
+    };
+    input_.get = [](const clap_input_events_t* list,
+                    uint32_t index) -> const clap_event_header_t* {
+      auto* self = static_cast<const BlockEvents*>(list->ctx);
+      return &self->events_[index].header;
+    };
+  }
+
+  void Clear() { events_.clear(); }
+
+  void Add(uint32_t time, clap_id param_id, double value) {
+    clap_event_param_value_t event = {};
+    event.header.size = sizeof(event);
+    event.header.time = time;
+    event.header.space_id = CLAP_CORE_EVENT_SPACE_ID;
+    event.header.type = CLAP_EVENT_PARAM_VALUE;
+    event.param_id = param_id;
+    event.note_id = -1;
+    event.port_index = -1;
+    event.channel = -1;
+    event.key = -1;
+    event.value = value;
+    events_.push_back(event);
+  }
+
+  const clap_input_events_t* Input() const { return &input_; }
+
+ private:
+  std::vector<clap_event_param_value_t> events_;
+  clap_input_events_t input_;
+};
+
+// Output events are not used offline
+const clap_output_events_t kDiscardEvents = {
+    nullptr,
+    [](const clap_output_events_t*, const clap_event_header_t*) {
+      return true;
+    },
+};
+
+}  // namespace
+
+double RenderStats::AudioSeconds() const {
+  return sample_rate > 0.0 ? static_cast<double>(frames) / sample_rate : 0.0;
+}
+
+double RenderStats::ProcessSeconds() const {
+  return std::accumulate(block_ns.begin(), block_ns.end(), 0.0) * 1e-9;
+}
+
+double RenderStats::RealtimeFactor() const {
+  const double seconds = ProcessSeconds();
+  return seconds > 0.0 ? AudioSeconds() / seconds : 0.0;
+}
+
+double RenderStats::BlockPercentileNs(double percent) const {
+  if (block_ns.empty()) return 0.0;
+
+  std::vector<double> sorted = block_ns;
+  std::sort(sorted.begin(), sorted.end());
+  const double rank = std::ceil(percent / 100.0 * sorted.size());
+  const size_t index = static_cast<size_t>(
+      std::clamp(rank, 1.0, static_cast<double>(sorted.size()))) - 1;
+  return sorted[index];
+}
+
+bool Render(PluginHost* host, const AudioBuffer& input,
+            const std::vector<ParamEvent>& automation,
+            const RenderOptions& options, AudioBuffer* output,
+            RenderStats* stats, std::string* error) {
+  const size_t num_channels = input.channels.size();
+  const uint32_t port_channels = host->MainInputChannels();
+  if (num_channels == 0 || num_channels > port_channels) {
+    *error = "input has " + std::to_string(num_channels) +
+             " channels, the plugin's main port takes 1 to " +
+             std::to_string(port_channels);
+    return false;
+  }
+  if (options.block_size == 0) {
+    *error = "block size must be at least 1";
+    return false;
+  }
+
+  // Input followed by the requested tail of silence
+  const uint64_t tail_frames = static_cast<uint64_t>(
+      std::llround(options.tail_seconds * input.sample_rate));
+  const uint64_t total_frames = input.Frames() + tail_frames;
+  AudioBuffer source = input;
+  for (std::vector<float>& channel : source.channels) {
+    channel.resize(total_frames, 0.0f);
+  }
+  output->sample_rate = input.sample_rate;
+  output->channels.assign(num_channels, std::vector<float>(total_frames));
+
+  if (!host->Start(input.sample_rate, options.block_size)) {
+    host->Stop();
+    *error = "plugin failed to activate";
+    return false;
+  }
+  // The output is shifted back by the plugin's latency, and that many frames
+  // of silence are fed after the source so nothing is cut off
+  uint32_t latency = host->Latency();
+
+  stats->sample_rate = input.sample_rate;
+  stats->frames = 0;
+  stats->block_size = options.block_size;
+  stats->restarts = 0;
+  stats->block_ns.clear();
+  stats->block_ns.reserve((total_frames + latency) / options.block_size + 1);
+
+  // The plugin writes each block here; it is copied into `output` at its
+  // latency-compensated position
+  std::vector<std::vector<float>> block_out(
+      num_channels, std::vector<float>(options.block_size));
+  std::vector<float> silence(options.block_size, 0.0f);
+  std::vector<float*> in_ptrs(num_channels);
+  std::vector<float*> out_ptrs(num_channels);
+  for (size_t ch = 0; ch < num_channels; ++ch) {
+    out_ptrs[ch] = block_out[ch].data();
+  }
+  clap_audio_buffer_t audio_in = {in_ptrs.data(), nullptr,
+                                  static_cast<uint32_t>(num_channels), 0, 0};
+  clap_audio_buffer_t audio_out = {out_ptrs.data(), nullptr,
+                                   static_cast<uint32_t>(num_channels), 0, 0};
+  BlockEvents events;
+
+  clap_process_t process = {};
+  process.transport = nullptr;
+  process.audio_inputs = &audio_in;
+  process.audio_inputs_count = 1;
+  process.audio_outputs = &audio_out;
+  process.audio_outputs_count = 1;
+  process.in_events = events.Input();
+  process.out_events = &kDiscardEvents;
+
+  size_t next_event = 0;
+  uint64_t written = 0;  // Output frames filled so far
+  for (uint64_t pos = 0; pos < total_frames + latency;) {
+    const uint64_t end = pos < total_frames ? total_frames
+                                            : total_frames + latency;
+    const uint32_t frames = static_cast<uint32_t>(
+        std::min<uint64_t>(options.block_size, end - pos));
+
+    for (size_t ch = 0; ch < num_channels; ++ch) {
+      in_ptrs[ch] = pos < total_frames ? source.channels[ch].data() + pos
+                                       : silence.data();
+    }
+
+    events.Clear();
+    while (next_event < automation.size() &&
+           automation[next_event].frame < pos + frames) {
+      const ParamEvent& event = automation[next_event++];
+      // Events before the start land on the first frame
+      const uint32_t time = event.frame > pos
+                                ? static_cast<uint32_t>(event.frame - pos)
+                                : 0;
+      events.Add(time, event.param_id, event.value);
+    }
+
+    process.steady_time = static_cast<int64_t>(pos);
+    process.frames_count = frames;
+
+    const auto start = std::chrono::steady_clock::now();
+    const clap_process_status status = host->Process(&process);
+    const auto stop = std::chrono::steady_clock::now();
+    stats->block_ns.push_back(
+        std::chrono::duration<double, std::nano>(stop - start).count());
+    stats->frames += frames;
+
+    if (status == CLAP_PROCESS_ERROR) {
+      host->Stop();
+      *error = "process() failed at frame " + std::to_string(pos);
+      return false;
+    }
+
+    // Frame i of the block is output frame pos + i - latency. Frames a
+    // restart with a longer latency plays again are not written twice.
+    for (uint32_t i = 0; i < frames; ++i) {
+      if (pos + i < latency + written) continue;
+      const uint64_t frame = pos + i - latency;
+      if (frame >= total_frames) break;
+      for (size_t ch = 0; ch < num_channels; ++ch) {
+        output->channels[ch][frame] = block_out[ch][i];
+      }
+      written = frame + 1;
+    }
+    pos += frames;
+
+    // Latched parameters (e.g. the limiter's lookahead) apply once the
+    // plugin is reactivated, which may change its latency
+    if (host->RestartRequested()) {
+      host->Stop();
+      if (!host->Start(input.sample_rate, options.block_size)) {
+        host->Stop();
+        *error = "plugin failed to reactivate at frame " + std::to_string(pos);
+        return false;
+      }
+      latency = host->Latency();
+      ++stats->restarts;
+    }
+  }
+  stats->latency = latency;
+
+  host->Stop();
+  return true;
+}
+
+}  // namespace stinky_render
@@ -0,0 +1,111 @@
+// Copyright 2025
+// Unit tests for WAV and raw float audio files
+
+#include "audio_file.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace stinky_render {
+namespace {
+
+class AudioFileTest : public ::testing::Test {
+ protected:
+  std::string TempPath(const std::string& name) {
+    const std::string path =
+        (std::filesystem::temp_directory_path() /
+         ("stinky_render_" + std::to_string(::testing::UnitTest::GetInstance()
+                                                ->random_seed()) +
+          "_" + name))
+            .string();
+    paths_.push_back(path);
+    return path;
+  }
+
+  void TearDown() override {
+    for (const std::string& path : paths_) std::remove(path.c_str());
+  }
+
+  static AudioBuffer TestAudio() {
+    AudioBuffer audio;
+    audio.sample_rate = 44100.0;
+    audio.channels = {{0.0f, 0.5f, -0.25f, 1.0f}, {-1.0f, 0.125f, 0.75f, 0.0f}};
+    return audio;
+  }
+
+ private:
+  std::vector<std::string> paths_;
+};
+
+TEST_F(AudioFileTest, FloatWavRoundTrip) {
+  const std::string path = TempPath("float.wav");
+  const AudioBuffer audio = TestAudio();
+  std::string error;
+  ASSERT_TRUE(WriteWav(path, audio, &error)) << error;
+
+  AudioBuffer loaded;
+  ASSERT_TRUE(ReadWav(path, &loaded, &error)) << error;
+  EXPECT_EQ(loaded.sample_rate, 44100.0);
+  EXPECT_EQ(loaded.channels, audio.channels);
+}
+
+TEST_F(AudioFileTest, RawRoundTrip) {
+  const std::string path = TempPath("audio.raw");
+  const AudioBuffer audio = TestAudio();
+  std::string error;
+  ASSERT_TRUE(WriteRaw(path, audio, &error)) << error;
+
+  AudioBuffer loaded;
+  ASSERT_TRUE(ReadRaw(path, 44100.0, 2, &loaded, &error)) << error;
+  EXPECT_EQ(loaded.channels, audio.channels);
+}
+
+TEST_F(AudioFileTest, ReadsPcm16WithExtraChunks) {
+  // Mono 16-bit PCM with a LIST chunk of odd size before the data
+  const std::vector<uint8_t> wav = {
+      'R', 'I', 'F', 'F', 50, 0, 0, 0, 'W', 'A', 'V', 'E',
+      'f', 'm', 't', ' ', 16, 0, 0, 0,
+      1, 0, 1, 0, 0x80, 0xBB, 0, 0, 0, 0x77, 1, 0, 2, 0, 16, 0,
+      'L', 'I', 'S', 'T', 1, 0, 0, 0, 'x', 0,
+      'd', 'a', 't', 'a', 4, 0, 0, 0,
+      0x00, 0x40,  // 16384 -> 0.5
+      0x00, 0x80,  // -32768 -> -1.0
+  };
+  const std::string path = TempPath("pcm16.wav");
+  std::ofstream(path, std::ios::binary)
+      .write(reinterpret_cast<const char*>(wav.data()),
+             static_cast<std::streamsize>(wav.size()));
+
+  AudioBuffer loaded;
+  std::string error;
+  ASSERT_TRUE(ReadWav(path, &loaded, &error)) << error;
+  EXPECT_EQ(loaded.sample_rate, 48000.0);
+  ASSERT_EQ(loaded.channels.size(), 1u);
+  EXPECT_EQ(loaded.channels[0], (std::vector<float>{0.5f, -1.0f}));
+}
+
+TEST_F(AudioFileTest, RejectsNonWav) {
+  const std::string path = TempPath("not.wav");
+  std::ofstream(path) << "definitely not a wav file";
+
+  AudioBuffer loaded;
+  std::string error;
+  EXPECT_FALSE(ReadWav(path, &loaded, &error));
+  EXPECT_FALSE(error.empty());
+}
+
+TEST_F(AudioFileTest, RawPathsAreRecognizedByExtension) {
+  EXPECT_TRUE(IsRawPath("render.raw"));
+  EXPECT_TRUE(IsRawPath("dir.v2/render.F32"));
+  EXPECT_FALSE(IsRawPath("render.wav"));
+  EXPECT_FALSE(IsRawPath("raw"));
+}
+
+}  // namespace
+}  // namespace stinky_render
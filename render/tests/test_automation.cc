@@ -0,0 +1,111 @@
+// Copyright 2025
+// Unit tests for automation parsing and resolution
+
+#include "automation.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace stinky_render {
+namespace {
+
+clap_param_info_t Param(clap_id id, const char* name) {
+  clap_param_info_t info;
+  std::memset(&info, 0, sizeof(info));
+  info.id = id;
+  std::strncpy(info.name, name, sizeof(info.name) - 1);
+  info.min_value = 0.0;
+  info.max_value = 1.0;
+  return info;
+}
+
+TEST(AutomationTest, ParsesNamesIdsTimesAndFrames) {
+  const std::string json = R"({
+    "events": [
+      {"param": "Threshold", "time": 1.5, "value": 0.25},
+      {"param": 3, "frame": 48000, "value": 0.8}
+    ]
+  })";
+
+  std::vector<AutomationEvent> events;
+  std::string error;
+  ASSERT_TRUE(ParseAutomation(json, &events, &error)) << error;
+  ASSERT_EQ(events.size(), 2u);
+
+  EXPECT_EQ(events[0].param_name, "Threshold");
+  EXPECT_DOUBLE_EQ(events[0].time_seconds, 1.5);
+  EXPECT_EQ(events[0].frame, -1);
+  EXPECT_DOUBLE_EQ(events[0].value, 0.25);
+
+  EXPECT_TRUE(events[1].param_name.empty());
+  EXPECT_EQ(events[1].param_id, 3u);
+  EXPECT_EQ(events[1].frame, 48000);
+  EXPECT_DOUBLE_EQ(events[1].value, 0.8);
+}
+
+TEST(AutomationTest, RejectsMalformedDocuments) {
+  const char* const documents[] = {
+      "",
+      "[]",
+      R"({"events": {}})",
+      R"({"events": [{"param": "A", "value": 1}]})",           // No position
+      R"({"events": [{"param": "A", "time": 0}]})",            // No value
+      R"({"events": [{"time": 0, "value": 1}]})",              // No param
+      R"({"events": [{"param": "A", "time": -1, "value": 1}]})",
+      R"({"events": [{"param": "A", "time": 0, "value": 1},]})",
+      R"({"events": []} trailing)",
+  };
+  for (const char* document : documents) {
+    std::vector<AutomationEvent> events;
+    std::string error;
+    EXPECT_FALSE(ParseAutomation(document, &events, &error)) << document;
+    EXPECT_FALSE(error.empty()) << document;
+  }
+}
+
+TEST(AutomationTest, ResolvesSortsAndClamps) {
+  const std::vector<clap_param_info_t> params = {Param(0, "Threshold"),
+                                                 Param(7, "Mix")};
+  std::vector<AutomationEvent> events(3);
+  events[0].param_name = "Mix";
+  events[0].time_seconds = 0.5;
+  events[0].value = 2.0;
+  events[1].param_id = 0;
+  events[1].frame = 100;
+  events[1].value = 0.3;
+  events[2].param_name = "Threshold";
+  events[2].frame = 100;
+  events[2].value = 0.4;
+
+  std::vector<ParamEvent> resolved;
+  std::string error;
+  ASSERT_TRUE(ResolveAutomation(events, params, 48000.0, &resolved, &error))
+      << error;
+  ASSERT_EQ(resolved.size(), 3u);
+
+  // Sorted by frame; equal frames keep file order
+  EXPECT_EQ(resolved[0].frame, 100u);
+  EXPECT_DOUBLE_EQ(resolved[0].value, 0.3);
+  EXPECT_EQ(resolved[1].frame, 100u);
+  EXPECT_DOUBLE_EQ(resolved[1].value, 0.4);
+  EXPECT_EQ(resolved[2].frame, 24000u);
+  EXPECT_EQ(resolved[2].param_id, 7u);
+  EXPECT_DOUBLE_EQ(resolved[2].value, 1.0);
+}
+
+TEST(AutomationTest, UnknownParameterFails) {
+  const std::vector<clap_param_info_t> params = {Param(0, "Threshold")};
+  std::vector<AutomationEvent> events(1);
+  events[0].param_name = "Ratio";
+
+  std::vector<ParamEvent> resolved;
+  std::string error;
+  EXPECT_FALSE(ResolveAutomation(events, params, 48000.0, &resolved, &error));
+  EXPECT_NE(error.find("Ratio"), std::string::npos);
+}
+
+}  // namespace
+}  // namespace stinky_render
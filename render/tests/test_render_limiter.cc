@@ -0,0 +1,115 @@
+// Copyright 2025
+// End-to-end tests: latency compensation and restarts with the limiter
+
+#include "renderer.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <numbers>
+#include <string>
+#include <vector>
+
+namespace stinky_render {
+namespace {
+
+constexpr double kSampleRate = 48000.0;
+
+// -12 dBFS, below the default threshold, so the limiter only delays it
+AudioBuffer Sine(size_t frames) {
+  AudioBuffer audio;
+  audio.sample_rate = kSampleRate;
+  audio.channels.assign(2, std::vector<float>(frames));
+  for (size_t i = 0; i < frames; ++i) {
+    const float value =
+        0.25f * std::sin(2.0f * std::numbers::pi_v<float> * 440.0f *
+                         static_cast<float>(i) / kSampleRate);
+    audio.channels[0][i] = value;
+    audio.channels[1][i] = -value;
+  }
+  return audio;
+}
+
+// Largest difference between output and input over [begin, end)
+float MaxError(const AudioBuffer& output, const AudioBuffer& input,
+               size_t begin, size_t end) {
+  float error = 0.0f;
+  for (size_t ch = 0; ch < input.channels.size(); ++ch) {
+    for (size_t i = begin; i < end; ++i) {
+      error = std::max(error, std::abs(output.channels[ch][i] -
+                                       input.channels[ch][i]));
+    }
+  }
+  return error;
+}
+
+class RenderLimiterTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    std::string error;
+    ASSERT_TRUE(host_.Load(STINKY_TEST_LIMITER_PATH, "", &error)) << error;
+  }
+
+  PluginHost host_;
+};
+
+TEST_F(RenderLimiterTest, OutputLinesUpWithTheInput) {
+  const AudioBuffer input = Sine(9600);
+  RenderOptions options;
+  options.block_size = 256;
+
+  AudioBuffer output;
+  RenderStats stats;
+  std::string error;
+  ASSERT_TRUE(Render(&host_, input, {}, options, &output, &stats, &error))
+      << error;
+
+  // 5 ms lookahead, fed as silence after the input
+  EXPECT_EQ(stats.latency, 240u);
+  EXPECT_EQ(stats.frames, 9600u + 240u);
+  EXPECT_EQ(stats.restarts, 0u);
+  ASSERT_EQ(output.Frames(), input.Frames());
+
+  // The output level sits 0.1 dB under full scale, so the gain is not
+  // exactly 1; a one-sample shift of a 440 Hz sine at this level is ~0.014
+  EXPECT_LT(MaxError(output, input, 0, input.Frames()), 0.005f);
+}
+
+TEST_F(RenderLimiterTest, LatchedParametersRestartAndStayAligned) {
+  const AudioBuffer input = Sine(19200);
+  RenderOptions options;
+  options.block_size = 512;
+
+  // Longest lookahead and the true-peak detector from frame 4800
+  std::vector<AutomationEvent> events(2);
+  events[0].param_name = "Lookahead";
+  events[0].frame = 4800;
+  events[0].value = 1.0;
+  events[1].param_name = "True Peak";
+  events[1].frame = 4800;
+  events[1].value = 1.0;
+  std::vector<ParamEvent> automation;
+  std::string error;
+  ASSERT_TRUE(ResolveAutomation(events, host_.Params(), kSampleRate,
+                                &automation, &error))
+      << error;
+
+  AudioBuffer output;
+  RenderStats stats;
+  ASSERT_TRUE(Render(&host_, input, automation, options, &output, &stats,
+                     &error))
+      << error;
+
+  // 10 ms lookahead plus the true-peak filter's 6 frames
+  EXPECT_EQ(stats.restarts, 1u);
+  EXPECT_EQ(stats.latency, 486u);
+  ASSERT_EQ(output.Frames(), input.Frames());
+
+  // Aligned before the restart (which lands at the end of the block holding
+  // the events) and again once the new lookahead has filled
+  EXPECT_LT(MaxError(output, input, 0, 4000), 0.005f);
+  EXPECT_LT(MaxError(output, input, 6144, input.Frames()), 0.005f);
+}
+
+}  // namespace
+}  // namespace stinky_render
@@ -0,0 +1,128 @@
+// Copyright 2025
+// End-to-end tests: render through the built compressor module
+
+#include "renderer.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <numbers>
+#include <string>
+#include <vector>
+
+namespace stinky_render {
+namespace {
+
+constexpr double kSampleRate = 48000.0;
+
+AudioBuffer Sine(size_t num_channels, size_t frames, float amplitude) {
+  AudioBuffer audio;
+  audio.sample_rate = kSampleRate;
+  audio.channels.assign(num_channels, std::vector<float>(frames));
+  for (size_t i = 0; i < frames; ++i) {
+    const float value =
+        amplitude * std::sin(2.0f * std::numbers::pi_v<float> * 440.0f *
+                             static_cast<float>(i) / kSampleRate);
+    for (std::vector<float>& channel : audio.channels) channel[i] = value;
+  }
+  return audio;
+}
+
+class RendererTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    std::string error;
+    ASSERT_TRUE(host_.Load(STINKY_TEST_PLUGIN_PATH, "", &error)) << error;
+  }
+
+  PluginHost host_;
+};
+
+TEST_F(RendererTest, LoadsModuleThroughClapEntry) {
+  ASSERT_NE(host_.Descriptor(), nullptr);
+  EXPECT_STREQ(host_.Descriptor()->id, "com.stinky.compressor");
+  EXPECT_EQ(host_.MainInputChannels(), 2u);
+
+  const std::vector<clap_param_info_t> params = host_.Params();
+  ASSERT_FALSE(params.empty());
+  EXPECT_STREQ(params[0].name, "Threshold");
+}
+
+TEST_F(RendererTest, UnknownPluginIdFails) {
+  PluginHost host;
+  std::string error;
+  EXPECT_FALSE(host.Load(STINKY_TEST_PLUGIN_PATH, "com.stinky.nothing",
+                         &error));
+  EXPECT_FALSE(error.empty());
+}
+
+TEST_F(RendererTest, RendersEveryBlockAndTimesIt) {
+  const AudioBuffer input = Sine(2, 10000, 0.5f);
+  RenderOptions options;
+  options.block_size = 256;
+  options.tail_seconds = 0.01;  // 480 frames
+
+  AudioBuffer output;
+  RenderStats stats;
+  std::string error;
+  ASSERT_TRUE(Render(&host_, input, {}, options, &output, &stats, &error))
+      << error;
+
+  ASSERT_EQ(output.channels.size(), 2u);
+  EXPECT_EQ(output.Frames(), 10480u);
+  EXPECT_EQ(stats.frames, 10480u);
+  EXPECT_EQ(stats.block_ns.size(), 41u);  // ceil(10480 / 256)
+  EXPECT_GT(stats.RealtimeFactor(), 0.0);
+  EXPECT_LE(stats.BlockPercentileNs(50.0), stats.BlockPercentileNs(100.0));
+
+  // -6 dBFS against the default -20 dB threshold: compressed once attacked
+  float peak = 0.0f;
+  for (size_t i = 5000; i < 10000; ++i) {
+    peak = std::max(peak, std::abs(output.channels[0][i]));
+  }
+  EXPECT_LT(peak, 0.4f);
+  EXPECT_GT(peak, 0.0f);
+}
+
+TEST_F(RendererTest, AutomationAppliesAtItsFrame) {
+  const AudioBuffer input = Sine(1, 8192, 0.5f);
+  RenderOptions options;
+  options.block_size = 512;
+
+  AudioBuffer plain;
+  RenderStats stats;
+  std::string error;
+  ASSERT_TRUE(Render(&host_, input, {}, options, &plain, &stats, &error))
+      << error;
+
+  // Threshold to the top of its range (0 dB) from frame 4000
+  std::vector<AutomationEvent> events(1);
+  events[0].param_name = "Threshold";
+  events[0].frame = 4000;
+  events[0].value = 1.0;
+  std::vector<ParamEvent> automation;
+  ASSERT_TRUE(ResolveAutomation(events, host_.Params(), kSampleRate,
+                                &automation, &error))
+      << error;
+
+  AudioBuffer automated;
+  ASSERT_TRUE(Render(&host_, input, automation, options, &automated, &stats,
+                     &error))
+      << error;
+
+  ASSERT_EQ(automated.channels.size(), 1u);
+  for (size_t i = 0; i < 4000; ++i) {
+    ASSERT_EQ(automated.channels[0][i], plain.channels[0][i]) << "frame " << i;
+  }
+  float plain_peak = 0.0f;
+  float automated_peak = 0.0f;
+  for (size_t i = 7000; i < 8192; ++i) {
+    plain_peak = std::max(plain_peak, std::abs(plain.channels[0][i]));
+    automated_peak =
+        std::max(automated_peak, std::abs(automated.channels[0][i]));
+  }
+  EXPECT_GT(automated_peak, plain_peak);
+}
+
+}  // namespace
+}  // namespace stinky_render
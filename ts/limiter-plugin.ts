@@ -12,6 +12,10 @@ function normalizedToOutputLevel(norm: number): number {
   return -60 + norm * (0 - -60);
 }
 
+function normalizedToLookahead(norm: number): number {
+  return 0 + norm * (10 - 0);
+}
+
 // Display text functions with units
 function thresholdToText(norm: number): string {
   return `${normalizedToThreshold(norm).toFixed(1)} dB`;
@@ -21,6 +25,10 @@ function outputLevelToText(norm: number): string {
   return `${normalizedToOutputLevel(norm).toFixed(1)} dB`;
 }
 
+function lookaheadToText(norm: number): string {
+  return `${normalizedToLookahead(norm).toFixed(1)} ms`;
+}
+
 export const LimiterPlugin: IAudioPlugin = {
   id: 'com.stinky.limiter',
   filename: 'StinkyLimiter.clap',
@@ -55,6 +63,28 @@ export const LimiterPlugin: IAudioPlugin = {
       getDisplayValue: normalizedToOutputLevel,
       getDisplayText: outputLevelToText,
       type: 'float'
+    },
+    {
+      name: 'lookahead',
+      id: 2,
+      description: 'Lookahead',
+      label: 'Lookahead',
+      min: 0.0,
+      max: 1.0,
+      defaultValue: 0.500000,
+      getDisplayValue: normalizedToLookahead,
+      getDisplayText: lookaheadToText,
+      type: 'float'
+    },
+    {
+      name: 'truePeak',
+      id: 3,
+      description: 'True Peak',
+      label: 'True Peak',
+      min: 0.0,
+      max: 1.0,
+      defaultValue: 0,
+      type: 'bool'
     }
   ]
 };